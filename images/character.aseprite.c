@@ -0,0 +1,89 @@
+#include <stdint.h>
+
+__attribute__((aligned(4))) const uint32_t characterTileData[1056] = {
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x71774400, 0x71777000, 0x77771000, 0x00000000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447717, 0x00077717, 0x00017777, 0x77710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x19100000, 0x18810000, 0x00001777, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000191, 0x00001881, 
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x77774400, 0x77777000, 0x77771000, 0x00000000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447777, 0x00077777, 0x00017777, 0x77710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x19100000, 0x18810000, 0x00001777, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000191, 0x00001881, 
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x71774400, 0x71777000, 0x77771000, 0x00000000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447717, 0x00077717, 0x00017777, 0x77710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x19100000, 0x18100000, 0x00001777, 0x00000111, 0x00001222, 0x00012222, 0x00012122, 0x00017191, 0x00001181, 0x00000001, 
+    0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x71774400, 0x71777000, 0x77771000, 0x77710000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447717, 0x00077717, 0x00017777, 0x00001777, 0x11100000, 0x22210000, 0x22271000, 0x22111000, 0x19100000, 0x19100000, 0x19100000, 0x18100000, 0x00000111, 0x00001222, 0x00012222, 0x00012122, 0x00001791, 0x00000181, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x71774400, 0x71777000, 0x00000000, 0x00000000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447717, 0x00077717, 0x77771000, 0x77710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x18100000, 0x00017777, 0x00001777, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000181, 
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x71774400, 0x71777000, 0x77771000, 0x00000000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447717, 0x00077717, 0x00017777, 0x77710000, 0x11100000, 0x22210000, 0x22221000, 0x22121000, 0x19171000, 0x18110000, 0x10000000, 0x00001777, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000191, 0x00000181, 
+    0x44440000, 0x44444000, 0x44444400, 0x74474400, 0x71774400, 0x71777000, 0x77771000, 0x77710000, 0x00004444, 0x00044444, 0x00444774, 0x00447777, 0x00447717, 0x00077717, 0x00017777, 0x00001777, 0x11100000, 0x22210000, 0x22221000, 0x22121000, 0x19710000, 0x18100000, 0x00000000, 0x00000000, 0x00000111, 0x00001222, 0x00017222, 0x00011122, 0x00000191, 0x00000191, 0x00000191, 0x00000181, 
+    0x00000000, 0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x00000000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x77100000, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x91000000, 0x91000000, 0x81000000, 0x00000777, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000017, 0x00000001, 0x00000018, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x91000000, 0x19100000, 0x19100000, 0x88000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000171, 0x00000819, 0x00000081, 0x00000001, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x91000000, 0x19100000, 0x01800000, 0x18000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000171, 0x00000819, 0x00000081, 0x00000000, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x91100000, 0x19980000, 0x00180000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000171, 0x00000019, 0x00000191, 0x00000810, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x91000000, 0x19100000, 0x01800000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000171, 0x00000019, 0x00000191, 0x00000880, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x71000000, 0x19100000, 0x19100000, 0x88000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000011, 0x00000819, 0x00000081, 0x00000001, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x71000000, 0x19100000, 0x01800000, 0x18000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000011, 0x00000119, 0x00000881, 0x00000000, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x71100000, 0x19980000, 0x00180000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000011, 0x00000019, 0x00000191, 0x00000810, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x71000000, 0x19100000, 0x01800000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000011, 0x00000019, 0x00000191, 0x00000880, 
+    0x44000000, 0x44400000, 0x44440000, 0x44440000, 0x44440000, 0x74440000, 0x77710000, 0x77100000, 0x00004444, 0x00044444, 0x00044444, 0x00007444, 0x00007177, 0x00077177, 0x00007777, 0x00000777, 0x11000000, 0x22100000, 0x22100000, 0x22100000, 0x71000000, 0x19100000, 0x88100000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000127, 0x00000011, 0x00000019, 0x00000019, 0x00000088, 
+    0x00000000, 0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x00000000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x77700000, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x71000000, 0x10000000, 0x81000000, 0x00000177, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000019, 0x00000019, 0x00000018, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x17100000, 0x91800000, 0x18000000, 0x10000000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000019, 0x00000191, 0x00000191, 0x00000088, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x17100000, 0x91800000, 0x18000000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000019, 0x00000191, 0x00000810, 0x00000081, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x17100000, 0x91000000, 0x19100000, 0x01800000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000119, 0x00008991, 0x00008100, 0x00000000, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x17100000, 0x91000000, 0x19100000, 0x08800000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000019, 0x00000191, 0x00000810, 0x00000000, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x11000000, 0x91800000, 0x18000000, 0x10000000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000017, 0x00000191, 0x00000191, 0x00000088, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x11000000, 0x91100000, 0x18800000, 0x00000000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000017, 0x00000191, 0x00000810, 0x00000081, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x11000000, 0x91000000, 0x19100000, 0x01800000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000117, 0x00008991, 0x00008100, 0x00000000, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x11000000, 0x91000000, 0x19100000, 0x08800000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000017, 0x00000191, 0x00000810, 0x00000000, 
+    0x44440000, 0x44444000, 0x44474000, 0x44770000, 0x77170000, 0x77177000, 0x77770000, 0x77700000, 0x00000044, 0x00000444, 0x00004444, 0x00004444, 0x00004444, 0x00004447, 0x00001777, 0x00000177, 0x11000000, 0x22100000, 0x22100000, 0x72100000, 0x11000000, 0x91000000, 0x91000000, 0x88000000, 0x00000011, 0x00000122, 0x00000122, 0x00000122, 0x00000017, 0x00000191, 0x00000188, 0x00000000, 
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x44444400, 0x44444400, 0x44444000, 0x44471000, 0x00000000, 0x00004444, 0x00044444, 0x00444444, 0x00444444, 0x00444444, 0x00044444, 0x00017444, 0x44710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x19100000, 0x18810000, 0x00001744, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000191, 0x00001881, 
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x44444400, 0x44444400, 0x44444000, 0x44471000, 0x00000000, 0x00004444, 0x00044444, 0x00444444, 0x00444444, 0x00444444, 0x00044444, 0x00017444, 0x44710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x19100000, 0x18100000, 0x00001744, 0x00000111, 0x00001222, 0x00012222, 0x00012122, 0x00017191, 0x00001181, 0x00000001, 
+    0x44440000, 0x44444000, 0x44444400, 0x44444400, 0x44444400, 0x44444000, 0x44471000, 0x44710000, 0x00004444, 0x00044444, 0x00444444, 0x00444444, 0x00444444, 0x00044444, 0x00017444, 0x00001744, 0x11100000, 0x22210000, 0x22271000, 0x22111000, 0x19100000, 0x19100000, 0x19100000, 0x18100000, 0x00000111, 0x00001222, 0x00012222, 0x00012122, 0x00001791, 0x00000181, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x44444400, 0x44444400, 0x44444000, 0x00000000, 0x00000000, 0x00004444, 0x00044444, 0x00444444, 0x00444444, 0x00444444, 0x00044444, 0x44471000, 0x44710000, 0x11100000, 0x22210000, 0x22221000, 0x22171000, 0x19111000, 0x18100000, 0x00017444, 0x00001744, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000181, 
+    0x00000000, 0x44440000, 0x44444000, 0x44444400, 0x44444400, 0x44444400, 0x44444000, 0x44471000, 0x00000000, 0x00004444, 0x00044444, 0x00444444, 0x00444444, 0x00444444, 0x00044444, 0x00017444, 0x44710000, 0x11100000, 0x22210000, 0x22221000, 0x22121000, 0x19171000, 0x18110000, 0x10000000, 0x00001744, 0x00000111, 0x00001222, 0x00012222, 0x00017122, 0x00011191, 0x00000191, 0x00000181, 
+    0x44440000, 0x44444000, 0x44444400, 0x44444400, 0x44444400, 0x44444000, 0x44471000, 0x44710000, 0x00004444, 0x00044444, 0x00444444, 0x00444444, 0x00444444, 0x00044444, 0x00017444, 0x00001744, 0x11100000, 0x22210000, 0x22221000, 0x22121000, 0x19710000, 0x18100000, 0x00000000, 0x00000000, 0x00000111, 0x00001222, 0x00017222, 0x00011122, 0x00000191, 0x00000191, 0x00000191, 0x00000181, 
+};
+
+const int characterTileDataLength = 4224;
+
+__attribute__((aligned(4))) const uint8_t characterTilePaletteNumber[33] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 
+};
+
+const int characterFrameCount = 41;
+
+const int characterFrameLength = 128;
+
+__attribute__((aligned(4))) const uint16_t characterFrameTile[41] = {
+    0x0000, 0x0004, 0x0008, 0x000c, 0x0008, 0x0010, 0x0014, 0x0018, 0x0014, 0x0010, 0x001c, 0x0020, 0x0024, 0x0028, 0x002c, 0x001c, 
+    0x0030, 0x0034, 0x0038, 0x003c, 0x0040, 0x0044, 0x0048, 0x004c, 0x0050, 0x0054, 0x0044, 0x0058, 0x005c, 0x0060, 0x0064, 0x0068, 
+    0x006c, 0x0070, 0x0074, 0x0070, 0x0078, 0x007c, 0x0080, 0x007c, 0x0078, 
+};
+
+__attribute__((aligned(4))) const uint16_t characterFrameDuration[41] = {
+    0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 
+    0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 
+    0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 
+};
+
+const int characterIdleDownStart = 0;
+
+const int characterIdleDownEnd = 2;
+
+const int characterWalkDownStart = 2;
+
+const int characterWalkDownEnd = 10;
+
+const int characterWalkRightStart = 10;
+
+const int characterWalkRightEnd = 21;
+
+const int characterWalkLeftStart = 21;
+
+const int characterWalkLeftEnd = 32;
+
+const int characterIdleUpStart = 32;
+
+const int characterIdleUpEnd = 33;
+
+const int characterWalkUpStart = 33;
+
+const int characterWalkUpEnd = 41;
+
+const int characterPaletteBankOffset = 0;
+
+const int characterPaletteBankCount = 1;
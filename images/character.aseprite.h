@@ -0,0 +1,35 @@
+/* PREFIX=character */
+/* TRANSPARENT=ff00ff */
+/* TILESIZE=16 */
+#pragma once
+
+#include <stdint.h>
+
+// The palette is sharedPaletteData, see shared.palette.h
+extern const int characterPaletteBankOffset;
+extern const int characterPaletteBankCount;
+
+extern const uint32_t characterTileData[];
+extern const int characterTileDataLength;
+
+extern const uint8_t characterTilePaletteNumber[];
+
+// One entry per frame of the animation, see Converter_AddAnimation in pngtogba
+extern const int characterFrameCount;
+extern const int characterFrameLength;
+extern const uint16_t characterFrameTile[];
+extern const uint16_t characterFrameDuration[];
+
+// The frames of each aseprite tag, end exclusive
+extern const int characterIdleDownStart;
+extern const int characterIdleDownEnd;
+extern const int characterWalkDownStart;
+extern const int characterWalkDownEnd;
+extern const int characterWalkRightStart;
+extern const int characterWalkRightEnd;
+extern const int characterWalkLeftStart;
+extern const int characterWalkLeftEnd;
+extern const int characterIdleUpStart;
+extern const int characterIdleUpEnd;
+extern const int characterWalkUpStart;
+extern const int characterWalkUpEnd;
@@ -1,13 +0,0 @@
-/* PREFIX=character */
-/* TRANSPARENT=ff00ff */
-/* TILESIZE=16 */
-#pragma once
-
-#include <stdint.h>
-
-extern uint16_t characterPaletteData[256];
-
-extern uint32_t characterTileData[];
-extern int characterTileDataLength;
-
-extern int characterTilePaletteNumber[];
\ No newline at end of file
@@ -0,0 +1,10 @@
+/* PREFIX=shared */
+/* TRANSPARENT=38D15F */
+/* IMAGES=tileset.png.h character.aseprite.h */
+#pragma once
+
+#include <stdint.h>
+
+// The palette banks of every image in IMAGES, copied to both the background and sprite palettes
+extern const uint16_t sharedPaletteData[256];
+extern const int sharedPaletteBankCount;
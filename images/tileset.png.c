@@ -0,0 +1,66 @@
+#include <stdint.h>
+
+__attribute__((aligned(4))) const uint32_t tilesetTileData[138] = {
+    0x00032010, 0xf0000038, 0x1001f001, 0x00099001, 0x9aa99900, 0x9aa9aa90, 0xa9a91d00, 0xf0032009, 
+    0x00273024, 0x00302300, 0xf0030090, 0x90990001, 0x4360ee09, 0x2e002d10, 0xf00e20a9, 0x20013056, 
+    0x20002200, 0x52007762, 0x10660077, 0x10666675, 0x66006777, 0x66777551, 0x00775751, 0x67755176, 
+    0x00022277, 0x26770000, 0x77670002, 0x66000025, 0x66015776, 0x01007776, 0x15757776, 0x04577767, 
+    0x77777715, 0x30422015, 0x30010033, 0xb101cbc3, 0x1c00bbcb, 0x1bccbc41, 0x05bb4430, 0x44430034, 
+    0xa0648003, 0xea590300, 0x00ee0600, 0xa0033006, 0x2a0300ce, 0x1c10cecc, 0xae03000a, 0xb0ee0300, 
+    0x00ee0800, 0xec031008, 0x4e000aec, 0x110300ee, 0x9001f011, 0x09ffe001, 0x19019942, 0x9a9009aa, 
+    0x9f991ed1, 0x09aa0c01, 0x2f9136e1, 0x01f01cf1, 0x00354640, 0xc00800a9, 0x7b00902f, 0x007bc0a9, 
+    0x77575751, 0x57757551, 0x75555100, 0x77551857, 0x55180055, 0x22885552, 0x80002552, 0x00222288, 
+    0x49888880, 0x774b0157, 0x554b1157, 0x001e0015, 0x52555281, 0x22255281, 0x22220800, 0x88880888, 
+    0x32018088, 0xc100ceec, 0x0010ccec, 0x10ceeecc, 0x10cecccc, 0xccccdd00, 0xddcdcd10, 0xcddd00d1, 
+    0xddddd1dc, 0xce20eedc, 0x1c2b010a, 0xccccee00, 0x20cc0122, 0xdd01cd03, 0x14cd0300, 0x101ddddc, 
+    0x66000003, 0x55006520, 0x76775102, 0x10675115, 0x01711776, 0x257571b7, 0x22280b12, 0x7e008222, 
+    0x00430008, 0xdddd004b, 0xfddddff1, 0xff00dff1, 0xfffdf1dd, 0x00fdf1fd, 0xaf10dffd, 0xa100dfdd, 
+    0x00ffda28, 0x03001d1a, 0x00dfdd1f, 0xffdf1fdd, 0xfddf1ffd, 0xff030080, 0xfdff1fdd, 0xdf0001ff, 
+    0x00001faf, 0x08faaa10, 0xaaa10000, 0x00330800, 0x33bb00b0, 0x53bbbbb0, 0x6b10bbbb, 0x0300b065, 
+    0xbbbbbb00, 0x01aafa00, 0x001aaa00, 0x01330100, 0xbb660000, 0x0103000b, 0xb6650bbb, 0x0055bbbb, 
+    0x1e00800c, 0x00000000, 
+};
+
+const int tilesetTileDataLength = 800;
+
+__attribute__((aligned(4))) const uint8_t tilesetTilePaletteNumber[256] = {
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+};
+
+__attribute__((aligned(4))) const uint16_t tilesetTileRemap[256] = {
+    0x0000, 0x1001, 0x1002, 0x1003, 0x1004, 0x1005, 0x1006, 0x1007, 0x0008, 0x0009, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x100b, 0x100c, 0x100d, 0x100e, 0x100f, 0x1010, 0x1011, 0x0000, 0x0012, 0x0013, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x1014, 0x0000, 0x000a, 0x0015, 0x0016, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x0017, 0x0018, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+    0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a, 
+};
+
+const int tilesetPaletteBankOffset = 0;
+
+const int tilesetPaletteBankCount = 2;
@@ -1,13 +1,18 @@
 /* PREFIX=tileset */
 /* TRANSPARENT=38D15F */
 /* TILESIZE=8 */
+/* DEDUPE=1 */
+/* COMPRESS=LZ77 */
 #pragma once
 
 #include <stdint.h>
 
-extern uint16_t tilesetPaletteData[256];
+// The palette is sharedPaletteData, see shared.palette.h
+extern const int tilesetPaletteBankOffset;
+extern const int tilesetPaletteBankCount;
 
-extern uint32_t tilesetTileData[];
-extern int tilesetTileDataLength;
+extern const uint32_t tilesetTileData[];
+extern const int tilesetTileDataLength;
 
-extern int tilesetTilePaletteNumber[];
\ No newline at end of file
+extern const uint8_t tilesetTilePaletteNumber[];
+extern const uint16_t tilesetTileRemap[];
\ No newline at end of file
@@ -0,0 +1,161 @@
+/**
+ * @file AffineBackground.h
+ * @brief Rotate and scale backgrounds 2 and 3 in modes 1 and 2, including Mode 7 style perspective
+ *
+ * Affine backgrounds use a different map format to regular ones: each entry is a single byte with the tile number,
+ * the map is stored row by row with no screenblocks, and the tiles are always 8bpp. The hardware works out which
+ * map position to draw at each pixel from a matrix and a reference point, which are the map position of the top
+ * left of the screen and how far it moves for each pixel across and each line down.
+ *
+ * The size, wraparound and colour mode go through the same shadow registers as Background.h, so they take effect
+ * at the next Graphics_CommitRegisters().
+ *
+ * @defgroup AFFINE_BACKGROUNDS Affine backgrounds
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "LostGbaUtil.h"
+#include "Background.h"
+#include "Fixed.h"
+#include "Graphics.h"
+
+/** Affine background sizes. The map has one byte per tile, so 128x128 takes 8 screenblocks */
+enum AffineBackgroundSize
+{
+    AffineBackgroundSize_16x16,  /**< 16 x 16 tiles (or 128 x 128 pixels) */
+    AffineBackgroundSize_32x32,  /**< 32 x 32 tiles (or 256 x 256 pixels) */
+    AffineBackgroundSize_64x64,  /**< 64 x 64 tiles (or 512 x 512 pixels) */
+    AffineBackgroundSize_128x128 /**< 128 x 128 tiles (or 1024 x 1024 pixels) */
+};
+
+/** The affine registers for one background, in the same layout as the hardware */
+struct AffineBackgroundParameters
+{
+    s16 pa; /**< 8.8 map x moved per pixel across the screen */
+    s16 pb; /**< 8.8 map x moved per line down the screen */
+    s16 pc; /**< 8.8 map y moved per pixel across the screen */
+    s16 pd; /**< 8.8 map y moved per line down the screen */
+    s32 x;  /**< 20.8 map x at the top left of the screen */
+    s32 y;  /**< 20.8 map y at the top left of the screen */
+} LOSTGBA_ALIGN(4);
+
+/** Set the map size of an affine background */
+#define AffineBackground_SetSize(backgroundNumber, affineBackgroundSize)                                                              \
+    do                                                                                                                                \
+    {                                                                                                                                 \
+        _Static_assert(backgroundNumber == BackgroundNumber_2 || backgroundNumber == BackgroundNumber_3, "Only BG2 and BG3 are affine"); \
+        LOSTGBA_UNSAFE(AffineBackground_SetSize)                                                                                      \
+        (backgroundNumber, affineBackgroundSize);                                                                                     \
+    } while (0)
+/** Unsafe version of AffineBackground_SetSize */
+void LOSTGBA_UNSAFE(AffineBackground_SetSize)(enum BackgroundNumber backgroundNumber, enum AffineBackgroundSize affineBackgroundSize);
+
+/**
+ * @brief Set whether the map repeats forever or stops at its edges
+ *
+ * Without wraparound, anywhere off the map is transparent, which is how Mode 7 leaves room for a sky.
+ */
+#define AffineBackground_SetWraparound(backgroundNumber, wraparound)                                                                  \
+    do                                                                                                                                \
+    {                                                                                                                                 \
+        _Static_assert(backgroundNumber == BackgroundNumber_2 || backgroundNumber == BackgroundNumber_3, "Only BG2 and BG3 are affine"); \
+        LOSTGBA_UNSAFE(AffineBackground_SetWraparound)                                                                                \
+        (backgroundNumber, wraparound);                                                                                               \
+    } while (0)
+/** Unsafe version of AffineBackground_SetWraparound */
+void LOSTGBA_UNSAFE(AffineBackground_SetWraparound)(enum BackgroundNumber backgroundNumber, bool wraparound);
+
+/**
+ * @brief Write the matrix and reference point of an affine background straight to the hardware
+ *
+ * To change them in time with the rest of the frame, use Frame_QueueCopy() into AffineBackground_Registers() instead.
+ */
+#define AffineBackground_SetParameters(backgroundNumber, parameters)                                                                  \
+    do                                                                                                                                \
+    {                                                                                                                                 \
+        _Static_assert(backgroundNumber == BackgroundNumber_2 || backgroundNumber == BackgroundNumber_3, "Only BG2 and BG3 are affine"); \
+        LOSTGBA_UNSAFE(AffineBackground_SetParameters)                                                                                \
+        (backgroundNumber, parameters);                                                                                               \
+    } while (0)
+/** Unsafe version of AffineBackground_SetParameters */
+void LOSTGBA_UNSAFE(AffineBackground_SetParameters)(enum BackgroundNumber backgroundNumber, const struct AffineBackgroundParameters *parameters);
+/** The hardware registers AffineBackground_SetParameters() writes to, for BG2 or BG3 */
+volatile struct AffineBackgroundParameters *AffineBackground_Registers(enum BackgroundNumber backgroundNumber);
+
+/**
+ * @brief Set one tile of an affine map
+ *
+ * @param baseBlock The base block that the background has been set to
+ * @param affineBackgroundSize The size of the background
+ * @param x The x location in the map
+ * @param y The y location in the map
+ * @param tileId The 8bpp tile, between 0 and 255
+ *
+ * VRAM can't be written a byte at a time, so this reads the neighbouring entry and writes both.
+ */
+#define AffineBackground_SetTile(baseBlock, affineBackgroundSize, x, y, tileId)                             \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(AffineBackground_SetTile)                                                            \
+        (baseBlock, affineBackgroundSize, x, y, tileId);                                                    \
+    } while (0)
+/** Unsafe version of AffineBackground_SetTile */
+void LOSTGBA_UNSAFE(AffineBackground_SetTile)(int screenBaseBlock, enum AffineBackgroundSize affineBackgroundSize, int x, int y, u8 tileId);
+
+/**
+ * @brief Copy a whole affine map in with one DMA copy
+ *
+ * @param baseBlock The base block that the background has been set to
+ * @param affineBackgroundSize The size of the background, which decides how much is copied
+ * @param map One byte per tile, row by row. Must be word aligned
+ */
+#define AffineBackground_CopyMap(baseBlock, affineBackgroundSize, map)                                      \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(AffineBackground_CopyMap)                                                            \
+        (baseBlock, affineBackgroundSize, map);                                                             \
+    } while (0)
+/** Unsafe version of AffineBackground_CopyMap */
+void LOSTGBA_UNSAFE(AffineBackground_CopyMap)(int screenBaseBlock, enum AffineBackgroundSize affineBackgroundSize, const u8 *map);
+
+/**
+ * @brief Work out the parameters to rotate and scale a background around a point
+ *
+ * @param parameters Where to put the result
+ * @param scale How much bigger the background should look, so Fixed_One is unscaled. Must not be 0
+ * @param angle How far to turn the background clockwise
+ * @param mapX The map position, in pixels, which should show at screenX, screenY
+ * @param mapY The map position, in pixels, which should show at screenX, screenY
+ * @param screenX The screen position the background turns around
+ * @param screenY The screen position the background turns around
+ */
+void AffineBackground_RotateScale(struct AffineBackgroundParameters *parameters, Fixed scale, u16 angle, Fixed mapX, Fixed mapY, int screenX, int screenY);
+
+/** Where a Mode 7 camera is and which way it's looking */
+struct AffineBackgroundCamera
+{
+    Fixed x;         /**< Map x of the camera */
+    Fixed y;         /**< Map y of the camera */
+    int height;      /**< How far above the map the camera is, in pixels */
+    u16 angle;       /**< Which way the camera faces. 0 is towards the top of the map, and it turns clockwise */
+    int horizon;     /**< The screen line of the horizon. Lines above it show nothing */
+    int focalLength; /**< The distance from the camera to the screen in pixels. Smaller values give a wider view */
+};
+
+/**
+ * @brief Work out the parameters for every line of a Mode 7 style perspective view of the map
+ *
+ * @param lines Graphics_ScreenHeight entries, one per line, like the back table of ScanlineEffect_StartAffine()
+ * @param camera The camera
+ *
+ * Each line below the horizon shows the map further away the closer it is to the horizon. Lines at or above the
+ * horizon are moved off the map, so turn wraparound off to show a sky behind them.
+ */
+void AffineBackground_Mode7Lines(struct AffineBackgroundParameters *lines, const struct AffineBackgroundCamera *camera);
+
+/** @} */
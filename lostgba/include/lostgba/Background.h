@@ -14,7 +14,11 @@
  * 1    | reg | reg | aff | -
  * 2    | -   | -   | aff | aff
  * 
- * They must also be explicitly enabled as part of the current graphics mode.
+ * They must also be explicitly enabled as part of the current graphics mode. The functions here which write the map
+ * are for regular backgrounds, since affine ones have a different map format. See AffineBackground.h for those.
+ *
+ * The background control settings and Background_SetEnabled() don't change anything on screen until the next
+ * Graphics_CommitRegisters().
  */
 
 #pragma once
@@ -31,6 +35,13 @@ enum BackgroundNumber
     BackgroundNumber_3  /**< Background number 3 */
 };
 
+/**
+ * @brief Turn a background on or off without changing the rest of the graphics mode
+ *
+ * Turning off a background with nothing on screen saves the hardware from drawing it. Graphics_SetMode() sets all of
+ * them at once.
+ */
+void Background_SetEnabled(enum BackgroundNumber backgroundNumber, bool enabled);
 /** Set the priority of a given background (0 - 4) */
 void Background_SetPriority(enum BackgroundNumber backgroundNumber, int priority);
 /** Set the background number (character base block). TileMap_CopyToBackgroundTiles sets the tiles themselves */
@@ -124,6 +135,146 @@ void Background_SetSize(enum BackgroundNumber backgroundNumber, enum BackgroundS
 /** Unsafe version of Background_SetTile */
 void LOSTGBA_UNSAFE(Background_SetTile)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int tileId, bool hflip, bool vflip, int paletteBank);
 
+/**
+ * @brief Set the tile at the given location to an already built screen entry
+ * 
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background (needed to turn x, y into coordinate ids)
+ * @param x The x location in the tilemap
+ * @param y The y location in the tilemap
+ * @param screenEntry The tile id in bits 0-9, hflip in bit 10, vflip in bit 11 and the palette bank in bits 12-15
+ * 
+ * This is the format of the `<prefix>TileRemap` table pngtogba generates for deduplicated images, so entries from
+ * that table can be passed straight in.
+ */
+#define Background_SetTileEntry(baseBlock, backgroundSize, x, y, screenEntry)                               \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_SetTileEntry)                                                             \
+        (baseBlock, backgroundSize, x, y, screenEntry);                                                     \
+    } while (0)
+/** Unsafe version of Background_SetTileEntry */
+void LOSTGBA_UNSAFE(Background_SetTileEntry)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, u16 screenEntry);
+
+/**
+ * @brief Copy a whole map of screen entries into the background's screenblocks
+ *
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background, which decides how many screenblocks are copied
+ * @param screenEntries 1024 screen entries per screenblock, for each screenblock in turn. Must be word aligned
+ *
+ * The entries are in VRAM order rather than row by row, so the whole map goes in as one DMA copy. This is the
+ * format of the `<prefix><Layer>ScreenEntries` arrays tmxtogba generates for maps which fit in a background. Bigger
+ * maps can be streamed in with MapStream.
+ */
+#define Background_CopyScreenEntries(baseBlock, backgroundSize, screenEntries)                              \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_CopyScreenEntries)                                                        \
+        (baseBlock, backgroundSize, screenEntries);                                                         \
+    } while (0)
+/** Unsafe version of Background_CopyScreenEntries */
+void LOSTGBA_UNSAFE(Background_CopyScreenEntries)(int screenBaseBlock, enum BackgroundSize backgroundSize, const u16 *screenEntries);
+
+/**
+ * @brief Set every screen entry in the background's screenblocks to screenEntry
+ *
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background, which decides how many screenblocks are filled
+ * @param screenEntry The screen entry to write everywhere, usually 0 for an empty background
+ */
+#define Background_FillScreenEntries(baseBlock, backgroundSize, screenEntry)                                \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_FillScreenEntries)                                                        \
+        (baseBlock, backgroundSize, screenEntry);                                                           \
+    } while (0)
+/** Unsafe version of Background_FillScreenEntries */
+void LOSTGBA_UNSAFE(Background_FillScreenEntries)(int screenBaseBlock, enum BackgroundSize backgroundSize, u16 screenEntry);
+
+/**
+ * @brief Write a row of screen entries starting at x, y and going right
+ *
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background
+ * @param x The x location in the tilemap of the first entry
+ * @param y The y location in the tilemap
+ * @param screenEntries The entries to write, in the same format as Background_SetTileEntry
+ * @param length The number of entries to write
+ *
+ * The row wraps around the edge of the background like the scroll offsets do, so it can start anywhere. It is split
+ * where it crosses into another screenblock, and each part is written with 32-bit copies.
+ */
+#define Background_SetTileRow(baseBlock, backgroundSize, x, y, screenEntries, length)                       \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_SetTileRow)                                                               \
+        (baseBlock, backgroundSize, x, y, screenEntries, length);                                           \
+    } while (0)
+/** Unsafe version of Background_SetTileRow */
+void LOSTGBA_UNSAFE(Background_SetTileRow)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *screenEntries, int length);
+
+/**
+ * @brief Write a column of screen entries starting at x, y and going down
+ *
+ * The same as Background_SetTileRow, but vertical. Entries in a column aren't next to each other in VRAM, so these
+ * are written one at a time.
+ */
+#define Background_SetTileColumn(baseBlock, backgroundSize, x, y, screenEntries, length)                    \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_SetTileColumn)                                                            \
+        (baseBlock, backgroundSize, x, y, screenEntries, length);                                           \
+    } while (0)
+/** Unsafe version of Background_SetTileColumn */
+void LOSTGBA_UNSAFE(Background_SetTileColumn)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *screenEntries, int length);
+
+/**
+ * @brief Write a rectangle of screen entries with its top left corner at x, y
+ *
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background
+ * @param x The x location in the tilemap of the top left corner
+ * @param y The y location in the tilemap of the top left corner
+ * @param width The width of the rectangle in tiles
+ * @param height The height of the rectangle in tiles
+ * @param screenEntries width * height entries, row by row
+ *
+ * Each row is written with Background_SetTileRow, so the rectangle wraps around the edges of the background too.
+ */
+#define Background_SetTileRect(baseBlock, backgroundSize, x, y, width, height, screenEntries)               \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_SetTileRect)                                                              \
+        (baseBlock, backgroundSize, x, y, width, height, screenEntries);                                    \
+    } while (0)
+/** Unsafe version of Background_SetTileRect */
+void LOSTGBA_UNSAFE(Background_SetTileRect)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int width, int height, const u16 *screenEntries);
+
+/**
+ * @brief Copy 32x32 screen entries into one screenblock with a single DMA copy
+ *
+ * @param screenBlock The screenblock to write to
+ * @param screenEntries 1024 screen entries row by row. Must be word aligned
+ *
+ * This is the fastest way to fill a screenblock, like one chunk of tmxtogba's `<prefix><Layer>ScreenEntries`.
+ */
+#define Background_CopyScreenBlock(screenBlock, screenEntries)                                                   \
+    do                                                                                                           \
+    {                                                                                                            \
+        _Static_assert(0 <= screenBlock && screenBlock <= 31, "Screenblock must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_CopyScreenBlock)                                                               \
+        (screenBlock, screenEntries);                                                                            \
+    } while (0)
+/** Unsafe version of Background_CopyScreenBlock */
+void LOSTGBA_UNSAFE(Background_CopyScreenBlock)(int screenBlock, const u16 *screenEntries);
+
 /** Sets the horizontal offset for a given background */
 void Background_SetHorizontalOffset(enum BackgroundNumber backgroundNumber, int hOffset);
 /** Sets the vertical offset for a given background */
@@ -0,0 +1,48 @@
+/**
+ * @file Collision.h
+ * @brief Tile attributes and collision bitmaps for maps converted with tmxtogba
+ *
+ * Tiles get their attributes from boolean custom properties set on them in the Tiled tileset. tmxtogba turns these
+ * into a `<prefix>TileAttributes` table with a byte per tileset tile, and a `<prefix>Collision` bitmap with a bit
+ * per map cell which is set if any layer has a solid tile there.
+ *
+ * The bitmap stores each row as width / 32 words with the leftmost cell in the lowest bit, so checking a run of
+ * cells along a row is a couple of word loads and a mask.
+ *
+ * @defgroup COLLISION Collision
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** The bits of `<prefix>TileAttributes`, each set by the Tiled property in brackets */
+enum TileAttribute
+{
+    TileAttribute_Solid = 1 << 0,  /**< (solid) Can't be walked through. These make up `<prefix>Collision` */
+    TileAttribute_Water = 1 << 1  /**< (water) */
+};
+
+/** A `<prefix>Collision` bitmap and the size of its map */
+struct CollisionMap
+{
+    const u32 *bitmap; /**< `<prefix>Collision` */
+    int width;         /**< In tiles. Must be a multiple of 32, which it always is for a regular background */
+    int height;        /**< In tiles */
+};
+
+/** Whether the cell at x, y is solid. Both must be inside the map */
+bool CollisionMap_IsSolid(const struct CollisionMap *map, int x, int y);
+/**
+ * @brief Whether any of count cells going right from x, y are solid
+ * @param map The map to check
+ * @param x The first cell to check. Must be inside the map
+ * @param y The row to check. Must be inside the map
+ * @param count How many cells to check, between 1 and 32 inclusive. Wraps around to the start of the row
+ *
+ * Use this to check everything a sprite is touching with one call per row of tiles.
+ */
+bool CollisionMap_IsAnySolid(const struct CollisionMap *map, int x, int y, int count);
+
+/** @} */
@@ -0,0 +1,52 @@
+/**
+ * @file Dma.h
+ * @brief Copies using the GBA's direct memory access channels
+ *
+ * DMA copies are much faster than copying with the CPU, which is halted until they finish. Channel 3 is used for
+ * immediate copies since it is the only one which can read from the cartridge. Channels 0 - 2 are used for copies
+ * which repeat every HBlank, see ScanlineEffect.h.
+ *
+ * @defgroup DMA Direct memory access
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/**
+ * @brief Copies words from source to target straight away using DMA channel 3
+ * @param target Must be word aligned
+ * @param source Must be word aligned
+ * @param words The number of 32 bit words to copy. Must be between 1 and 0x4000 inclusive
+ *
+ * Returns once the copy has finished. Use this for copying into VRAM during VBlank. Interrupts are held off while
+ * the channel is set up, so it can be used both inside and outside of interrupts.
+ */
+void Dma_Copy32(volatile void *target, const void *source, int words);
+/**
+ * @brief Writes value to words of target straight away using DMA channel 3
+ * @param target Must be word aligned
+ * @param value The word written to every position
+ * @param words The number of 32 bit words to write. Must be between 1 and 0x4000 inclusive
+ *
+ * Like Dma_Copy32(), but for clearing VRAM.
+ */
+void Dma_Fill32(volatile void *target, u32 value, int words);
+
+/**
+ * @brief Starts copying one entry of source to target at the end of every scanline
+ * @param channel The DMA channel, between 0 and 2 inclusive
+ * @param target The register to write. It is written to every time rather than moving along
+ * @param source The entry for the second scanline. Each copy reads the next entry. Must be in RAM
+ * @param halfwords The size of each entry. 1 copies 16 bits, and an even number copies that many 16-bit registers
+ * 32 bits at a time
+ *
+ * The copies carry on until Dma_Stop(), but the source isn't moved back to the start. Start it again in every
+ * VBlank to repeat it for the next frame.
+ */
+void Dma_StartHBlankCopies(int channel, volatile void *target, const void *source, int halfwords);
+/** Stops the copies started by Dma_StartHBlankCopies() on channel */
+void Dma_Stop(int channel);
+
+/** @} */
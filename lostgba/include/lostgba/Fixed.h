@@ -0,0 +1,38 @@
+/**
+ * @file Fixed.h
+ * @brief Fixed point numbers with 8 fractional bits and a sine table
+ *
+ * The GBA has no floating point hardware, so the affine registers use fixed point instead: the matrix is 8.8 and
+ * the reference point is 20.8. Both have 8 fractional bits, so a Fixed can go into either as long as it fits.
+ *
+ * Angles are u16s where 0x10000 would be a full turn, so they wrap around by themselves.
+ *
+ * @defgroup FIXED Fixed point
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** A number with 8 fractional bits, so 256 is 1.0 */
+typedef s32 Fixed;
+
+/** 1.0 */
+#define Fixed_One 256
+/** Turns an int into a Fixed */
+#define Fixed_FromInt(i) ((Fixed)(i) * Fixed_One)
+/** Turns a Fixed into an int, rounding towards negative infinity */
+#define Fixed_ToInt(f) ((f) >> 8)
+/** Multiplies two Fixeds. The product before shifting has to fit in 32 bits */
+#define Fixed_Multiply(a, b) ((Fixed)(((a) * (b)) >> 8))
+
+/** A quarter turn for angles */
+#define Fixed_QuarterTurn 0x4000
+
+/** The sine of angle, from a 512 entry table */
+Fixed Fixed_Sin(u16 angle);
+/** The cosine of angle, from a 512 entry table */
+Fixed Fixed_Cos(u16 angle);
+
+/** @} */
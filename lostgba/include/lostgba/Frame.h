@@ -0,0 +1,81 @@
+/**
+ * @file Frame.h
+ * @brief Collect everything which changes the screen during a frame and apply it all at the start of VBlank
+ *
+ * Scroll offsets, object attributes and VRAM copies can only be changed safely while the screen isn't being drawn.
+ * Rather than writing them at the end of the game loop, which is too late if the loop runs long, they are added to
+ * the frame being built and handed over with Frame_Submit(). The VBlank interrupt then applies the submitted frame,
+ * along with the Graphics and Background register settings as they were when it was submitted, as soon as VBlank
+ * starts.
+ *
+ * There are two frames, so the next one can be built while the last one is waiting for VBlank. If the game loop
+ * hasn't submitted a frame by the time VBlank comes around, nothing changes on screen, so a slow frame shows the
+ * previous frame again rather than half of each.
+ *
+ * A typical game loop is:
+ *
+ *     while (true)
+ *     {
+ *         SystemCall_WaitForVBlank(); // the last frame has been applied by the time this returns
+ *         // game logic, then Frame_SetScroll() etc.
+ *         Frame_Submit();
+ *     }
+ *
+ * Interrupt_Init() and Interrupt_EnableType(InterruptType_VBlank) must have been called.
+ *
+ * @defgroup FRAME Frame commit list
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Background.h"
+
+/** The most Frame_QueueCopy() calls per frame */
+#define Frame_CopyQueueLength 32
+/** The most Frame_QueueCall() calls per frame */
+#define Frame_CallQueueLength 8
+
+/** Sets the scroll offset of a background for the frame being built */
+void Frame_SetScroll(enum BackgroundNumber backgroundNumber, int hOffset, int vOffset);
+
+/**
+ * @brief Copies objectAttributeBuffer into the frame being built, to go into object attribute memory
+ *
+ * This takes a copy, so objectAttributeBuffer can be changed straight away for the next frame.
+ */
+void Frame_QueueObjectAttributes(void);
+
+/**
+ * @brief Queues a DMA copy for the frame being built, for palettes and tiles
+ * @param target Where to copy to. Must be word aligned
+ * @param source Must be word aligned and stay unchanged until the frame has been applied
+ * @param words The number of 32 bit words to copy
+ * @return false if the frame's copy queue is full, in which case nothing is queued
+ *
+ * The copies happen in the VBlank interrupt, so use this rather than Dma_Copy32() while the game loop is running.
+ */
+bool Frame_QueueCopy(volatile void *target, const void *source, int words);
+
+/**
+ * @brief Queues a function to be called during VBlank when the frame being built is applied
+ * @param function Called from the VBlank interrupt with argument, after the copies. Must be quick
+ * @param argument Passed to function
+ * @return false if the frame's call queue is full, in which case nothing is queued
+ *
+ * This is for modules with their own queues, like MapStream_CommitQueued(), whose VRAM writes have to happen in the
+ * same VBlank as the scroll offsets they go with. MapStream and SpriteTiles keep a queue for each frame, so they can
+ * be filled in for the next frame while this one is waiting.
+ */
+bool Frame_QueueCall(void (*function)(void *argument), void *argument);
+
+/**
+ * @brief Hands the frame being built over to the VBlank interrupt and starts building the next one
+ *
+ * The next frame starts off empty. If the previous frame still hasn't been applied, this waits for VBlank first so
+ * that no frame is ever skipped. That never happens in the usual loop where SystemCall_WaitForVBlank() comes first.
+ */
+void Frame_Submit(void);
+
+/** @} */
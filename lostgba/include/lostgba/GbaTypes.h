@@ -29,9 +29,13 @@ typedef int8_t s8;
 typedef int16_t s16;
 /** Signed 32 bit value */
 typedef int32_t s32;
+/** Signed 64 bit value. Slow, so only for intermediate results which don't fit in 32 bits */
+typedef int64_t s64;
 
 /** Volatile unsigned 16 bit value */
 typedef volatile u16 vu16;
+/** Volatile unsigned 32 bit value */
+typedef volatile u32 vu32;
 
 /** 
  * @brief Tells the compiler that this must always be n-byte aligned
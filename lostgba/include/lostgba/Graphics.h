@@ -46,11 +46,13 @@ struct GraphicsSettings
     bool enableSprites;
 } LOSTGBA_PACKED_ALIGN(4);
 
-/** Sets the graphics mode */
+/** Sets the graphics mode. This takes effect at the next Graphics_CommitRegisters() */
 void Graphics_SetMode(struct GraphicsSettings graphicsSettings);
 
 /** Controls whether we should trigger vblank interrupts */
 void Graphics_SetVBlankInterrupt(bool enabled);
+/** Controls whether we should trigger hblank interrupts, which happen at the end of every scanline */
+void Graphics_SetHBlankInterrupt(bool enabled);
 
 /** The possible blending modes for the graphics */
 enum GraphicsBlendingMode
@@ -59,9 +61,18 @@ enum GraphicsBlendingMode
     GraphicsBlendingMode_Alpha,    /**<Alpha blending */
 };
 
-/** Controls the blending mode */
+/** Controls the blending mode. This takes effect at the next Graphics_CommitRegisters() */
 void Graphics_SetBlendingMode(enum GraphicsBlendingMode blendMode);
 
+/**
+ * @brief Writes the graphics mode, blending mode and background control settings which have changed to the hardware
+ *
+ * The setters only keep a copy of the registers in RAM, so that nothing changes halfway through drawing a frame.
+ * Frame_Submit() takes a copy of them for the frame, which the next VBlank writes, so only call this directly once
+ * after setting everything up before the first frame.
+ */
+void Graphics_CommitRegisters(void);
+
 #define Graphics_ScreenWidth 240
 #define Graphics_ScreenHeight 160
 
@@ -23,7 +23,7 @@ void Interrupt_Init(void);
 enum InterruptType
 {
     InterruptType_VBlank, /**< Triggers on vblank. This will automatically call Graphics_SetVBlankInterrupt(true) for you */
-    InterruptType_HBlank,
+    InterruptType_HBlank, /**< Triggers at the end of every scanline. This will automatically call Graphics_SetHBlankInterrupt(true) for you */
     InterruptType_VCount,
     InterruptType_Timer0,
     InterruptType_Timer1,
@@ -44,6 +44,8 @@ enum InterruptType
  * until you call Interrupt_Enable()
  */
 void Interrupt_EnableType(enum InterruptType interruptType);
+/** Stops a specific type of interrupt from firing */
+void Interrupt_DisableType(enum InterruptType interruptType);
 
 /**
  * @brief Actually enables interrupts.
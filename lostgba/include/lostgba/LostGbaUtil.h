@@ -1,3 +1,12 @@
 #pragma once
 
-#define LOSTGBA_UNSAFE(x) LOSTGBA_UNSAFE__##x
\ No newline at end of file
+#define LOSTGBA_UNSAFE(x) LOSTGBA_UNSAFE__##x
+
+/**
+ * @brief Stops the game when it has been used wrongly in a way that can't be caught at compile time
+ *
+ * Prints message and where it happened to the mgba console when printing is enabled, then waits forever.
+ */
+#define LostGBA_Panic(message) LostGBA_PanicAt(__FILE__, __LINE__, message)
+/** Used by LostGBA_Panic */
+__attribute__((noreturn)) void LostGBA_PanicAt(const char *fileName, int lineNumber, const char *message);
@@ -0,0 +1,154 @@
+/**
+ * @file MapStream.h
+ * @brief Scroll around maps which are bigger than a background by streaming them in as the camera moves
+ *
+ * A regular background is at most 64x64 tiles, which MapStream uses as a ring buffer: the map tile at x, y always
+ * goes at x % 64, y % 64 in the background, and the background's scroll offset is just the camera position since
+ * the hardware wraps it around at 512 pixels the same way. Only the window of tiles the screen can see is kept up
+ * to date. When the camera crosses into a new tile, the rows and columns which have just come into view are read
+ * from ROM straight away and written to VRAM by MapStream_CommitQueued() during the next VBlank. There is a queue for
+ * each of the two frames in Frame.h, so the camera can move for the next frame while the last one is still waiting
+ * for VBlank.
+ *
+ * The map is read from the `<prefix><Layer>ScreenEntries` arrays tmxtogba generates, which store the map as 32x32
+ * tile chunks one after the other, or expanded from a MetatileMap or SparseLayer. The map repeats in every direction,
+ * so the camera can go anywhere.
+ *
+ * @defgroup MAPSTREAM Map streaming
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "LostGbaUtil.h"
+#include "Metatiles.h"
+#include "SparseLayer.h"
+
+/** The columns kept up to date, enough for the 240 pixel wide screen at any scroll offset */
+#define MapStream_WindowWidth 32
+/** The rows kept up to date, enough for the 160 pixel high screen at any scroll offset */
+#define MapStream_WindowHeight 21
+/** The most rows and columns which can be waiting for MapStream_CommitQueued(). Moving further redraws everything */
+#define MapStream_QueueLength MapStream_WindowHeight
+
+/** A row or column waiting to be written to VRAM. Only used inside MapStream */
+struct MapStreamLine
+{
+    u16 screenEntries[MapStream_WindowWidth];
+    s16 x;
+    s16 y;
+    bool isRow;
+};
+
+/** Rows and columns waiting to be written to VRAM for one frame. Only used inside MapStream */
+struct MapStreamQueue
+{
+    // a sparse layer's whole window is drawn by clearing the background and writing the cells of the chunks in view
+    // at redrawX, redrawY before any of the lines
+    bool redraw;
+    int redrawX;
+    int redrawY;
+    int length;
+    struct MapStreamLine lines[MapStream_QueueLength];
+};
+
+/** Streams one map into one background. The fields are only read and written by the MapStream functions */
+struct MapStream
+{
+    // only one of these is set
+    const u16 *screenEntries;
+    const struct MetatileMap *metatileMap;
+    const struct SparseLayer *sparseLayer;
+    int width;
+    int height;
+    int screenBaseBlock;
+
+    // top left tile of the window, which can be outside the map
+    int tileX;
+    int tileY;
+    bool loaded;
+
+    // one per Frame, see LostGBA_FrameQueueIndex()
+    struct MapStreamQueue queues[2];
+};
+
+/**
+ * @brief Starts streaming a map into the background using baseBlock
+ *
+ * @param stream The stream to set up
+ * @param baseBlock The background's base block. It must be set to BackgroundSize_64x64, so this uses 4 screenblocks
+ * @param screenEntries The map in 32x32 chunks, like tmxtogba's `<prefix><Layer>ScreenEntries`
+ * @param width The width of the map in tiles. Must be a multiple of 32
+ * @param height The height of the map in tiles. Must be a multiple of 32
+ *
+ * Nothing is drawn until the first MapStream_SetCamera() and MapStream_CommitQueued().
+ */
+#define MapStream_Init(stream, baseBlock, screenEntries, width, height)                                               \
+    do                                                                                                                \
+    {                                                                                                                 \
+        _Static_assert(0 <= baseBlock && baseBlock <= 28, "Base block must be between 0 and 28 to fit 4 screenblocks"); \
+        LOSTGBA_UNSAFE(MapStream_Init)                                                                                \
+        (stream, baseBlock, screenEntries, width, height);                                                            \
+    } while (0)
+/** Unsafe version of MapStream_Init */
+void LOSTGBA_UNSAFE(MapStream_Init)(struct MapStream *stream, int screenBaseBlock, const u16 *screenEntries, int width, int height);
+
+/**
+ * @brief Starts streaming a metatile map into the background using baseBlock
+ *
+ * @param stream The stream to set up
+ * @param baseBlock The background's base block. It must be set to BackgroundSize_64x64, so this uses 4 screenblocks
+ * @param metatileMap The map, which must stay valid while streaming. Its width and height must be multiples of 32
+ *
+ * Like MapStream_Init, but the screen entries are expanded from the metatiles as they come into view.
+ */
+#define MapStream_InitMetatiles(stream, baseBlock, metatileMap)                                                       \
+    do                                                                                                                \
+    {                                                                                                                 \
+        _Static_assert(0 <= baseBlock && baseBlock <= 28, "Base block must be between 0 and 28 to fit 4 screenblocks"); \
+        LOSTGBA_UNSAFE(MapStream_InitMetatiles)                                                                       \
+        (stream, baseBlock, metatileMap);                                                                             \
+    } while (0)
+/** Unsafe version of MapStream_InitMetatiles */
+void LOSTGBA_UNSAFE(MapStream_InitMetatiles)(struct MapStream *stream, int screenBaseBlock, const struct MetatileMap *metatileMap);
+
+/**
+ * @brief Starts streaming a sparse layer into the background using baseBlock
+ *
+ * @param stream The stream to set up
+ * @param baseBlock The background's base block. It must be set to BackgroundSize_64x64, so this uses 4 screenblocks
+ * @param sparseLayer The layer, which must stay valid while streaming
+ *
+ * Like MapStream_Init, but empty cells are written as screen entry 0 so tile 0 of the background's tiles should be
+ * transparent. Drawing the whole window clears the background and then only writes the cells which aren't empty.
+ */
+#define MapStream_InitSparse(stream, baseBlock, sparseLayer)                                                          \
+    do                                                                                                                \
+    {                                                                                                                 \
+        _Static_assert(0 <= baseBlock && baseBlock <= 28, "Base block must be between 0 and 28 to fit 4 screenblocks"); \
+        LOSTGBA_UNSAFE(MapStream_InitSparse)                                                                          \
+        (stream, baseBlock, sparseLayer);                                                                             \
+    } while (0)
+/** Unsafe version of MapStream_InitSparse */
+void LOSTGBA_UNSAFE(MapStream_InitSparse)(struct MapStream *stream, int screenBaseBlock, const struct SparseLayer *sparseLayer);
+
+/**
+ * @brief Queues whatever has come into view since the last call
+ * @param stream The stream
+ * @param x The map position in pixels at the left of the screen, which is also the horizontal offset for the background
+ * @param y The map position in pixels at the top of the screen, which is also the vertical offset for the background
+ *
+ * Call this once per frame after moving the camera. Usually this queues at most one row and one column. The lines go
+ * in the queue for the frame being built.
+ */
+void MapStream_SetCamera(struct MapStream *stream, int x, int y);
+/**
+ * @brief Writes the queued rows and columns to VRAM. Call this during VBlank
+ *
+ * Called through Frame_QueueCall(), this writes the queue for the frame being applied. Otherwise it writes the queue
+ * for the frame being built, for drawing the first window before the game loop starts.
+ */
+void MapStream_CommitQueued(struct MapStream *stream);
+
+/** @} */
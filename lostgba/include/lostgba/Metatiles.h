@@ -0,0 +1,44 @@
+/**
+ * @file Metatiles.h
+ * @brief Maps stored as 2x2 tile blocks
+ *
+ * Most maps are built out of the same few 2x2 tile blocks, like the trees and bushes. With METATILES=1 in its
+ * config, tmxtogba stores each layer as a map of indices into a table of these metatiles rather than as screen
+ * entries, which is about 4 times smaller. The screen entries are expanded from it as the map is drawn, usually by
+ * MapStream.
+ *
+ * Each metatile also has the TileAttribute bytes of its 4 tiles packed into one word, so checking a whole 16x16
+ * block for an attribute is a halfword load, a word load and a mask.
+ *
+ * @defgroup METATILES Metatiles
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Collision.h"
+
+/** A layer generated by tmxtogba with METATILES=1 */
+struct MetatileMap
+{
+    const u16 *map;          /**< `<prefix><Layer>MetatileMap`, a metatile index per 2x2 tiles row by row */
+    const u16 *metatiles;    /**< `<prefix><Layer>Metatiles`, 4 screen entries per metatile: top left, top right, bottom left, bottom right */
+    const u32 *attributes;   /**< `<prefix><Layer>MetatileAttributes`, the TileAttribute bytes of those tiles from the lowest byte up */
+    int width;               /**< In tiles, so twice the width of map */
+    int height;              /**< In tiles, so twice the height of map */
+};
+
+/** The screen entry for the tile at x, y, which must be inside the map */
+u16 MetatileMap_ScreenEntry(const struct MetatileMap *map, int x, int y);
+/** The TileAttribute bits of the tile at x, y, which must be inside the map */
+u8 MetatileMap_TileAttributes(const struct MetatileMap *map, int x, int y);
+/**
+ * @brief Whether any of the 4 tiles of the metatile at metatileX, metatileY have the attribute
+ *
+ * The position is in metatiles, so x / 2 and y / 2 in tiles, and must be inside the map. Use TileAttribute_Solid to
+ * check for collision 16x16 pixels at a time.
+ */
+bool MetatileMap_HasAttribute(const struct MetatileMap *map, int metatileX, int metatileY, enum TileAttribute attribute);
+
+/** @} */
@@ -0,0 +1,113 @@
+/**
+ * @file ScanlineEffect.h
+ * @brief Change a register between every scanline from a table, for parallax, heat shimmer and gradient skies
+ *
+ * Each effect has a table with one entry per scanline for one register, or for all of an affine background's
+ * registers with ScanlineEffect_StartAffine(). An HBlank DMA copy writes the next entry
+ * at the end of every line, so the effect costs no CPU time while the screen is drawn. The VBlank interrupt writes
+ * the first line's entry and starts the copy again for the next frame.
+ *
+ * There are only 3 DMA channels for this, so further effects, or any effect started with ScanlineEffectMode_Cpu,
+ * are written by the HBlank interrupt instead. That takes some CPU time on every line but works with anything.
+ *
+ * The tables are double buffered, and the storage for both is passed in when the effect starts. Fill in the back
+ * table and call ScanlineEffect_Swap(), and it will be shown from the next frame onwards, so an effect never changes
+ * halfway down the screen.
+ *
+ * Interrupt_Init() and Interrupt_EnableType(InterruptType_VBlank) must have been called.
+ *
+ * @defgroup SCANLINE_EFFECT Scanline effects
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Graphics.h"
+#include "Background.h"
+#include "AffineBackground.h"
+
+/** The most effects which can run at once */
+#define ScanlineEffect_MaxEffects 4
+
+/** The registers an effect can change */
+enum ScanlineEffectTarget
+{
+    ScanlineEffectTarget_BackgroundScroll0, /**< BG0HOFS and BG0VOFS. Entries are hOffset | vOffset << 16 */
+    ScanlineEffectTarget_BackgroundScroll1, /**< BG1HOFS and BG1VOFS. Entries are hOffset | vOffset << 16 */
+    ScanlineEffectTarget_BackgroundScroll2, /**< BG2HOFS and BG2VOFS. Entries are hOffset | vOffset << 16 */
+    ScanlineEffectTarget_BackgroundScroll3, /**< BG3HOFS and BG3VOFS. Entries are hOffset | vOffset << 16 */
+    ScanlineEffectTarget_BlendAlpha,        /**< BLDALPHA. Entries are the first target's weight | the second's << 8 */
+    ScanlineEffectTarget_BlendBrightness,   /**< BLDY, the brightness for fade in and fade out blending */
+    ScanlineEffectTarget_Window0Horizontal, /**< WIN0H. Entries are the right edge | the left edge << 8 */
+    ScanlineEffectTarget_Window1Horizontal, /**< WIN1H. Entries are the right edge | the left edge << 8 */
+    ScanlineEffectTarget_BackdropColour,    /**< Background palette colour 0, which shows wherever nothing else is */
+};
+
+/** How an effect's entries are written */
+enum ScanlineEffectMode
+{
+    /** Uses a DMA channel if there is one free, otherwise the HBlank interrupt */
+    ScanlineEffectMode_Dma,
+    /** Always uses the HBlank interrupt, which leaves the DMA channels free for sound */
+    ScanlineEffectMode_Cpu
+};
+
+/**
+ * @brief The number of entries in each table
+ *
+ * This is one more than there are lines, since the copy after the last line reads one past it.
+ */
+#define ScanlineEffect_TableLength (Graphics_ScreenHeight + 1)
+
+/** One effect. The fields are only read and written by the ScanlineEffect functions */
+struct ScanlineEffect
+{
+    void *tables[2];
+    volatile void *target;
+    int entrySize; // in bytes, 2, 4 or the size of struct AffineBackgroundParameters
+    int channel;   // -1 when using the HBlank interrupt
+    int front;
+    bool shown;
+    volatile bool swapQueued;
+};
+
+/**
+ * @brief Sets up an effect on target
+ * @param effect The effect, which must stay valid until ScanlineEffect_Stop()
+ * @param target The register to change
+ * @param mode Whether to use DMA where possible
+ * @param tables Storage for the front and back tables, which must stay valid until ScanlineEffect_Stop(). The
+ * 16-bit targets only use the first half of each
+ * @return false if ScanlineEffect_MaxEffects are already running, in which case nothing starts
+ *
+ * Nothing is written to the register until the back table has been filled in and ScanlineEffect_Swap() called.
+ */
+bool ScanlineEffect_Start(struct ScanlineEffect *effect, enum ScanlineEffectTarget target, enum ScanlineEffectMode mode, u32 tables[2][ScanlineEffect_TableLength]);
+
+/**
+ * @brief Sets up an effect which sets the whole matrix and reference point of BG2 or BG3 on every line
+ *
+ * Like ScanlineEffect_Start(), but each entry is four words, which AffineBackground_Mode7Lines() can fill in.
+ */
+bool ScanlineEffect_StartAffine(struct ScanlineEffect *effect, enum BackgroundNumber backgroundNumber, enum ScanlineEffectMode mode,
+                                struct AffineBackgroundParameters tables[2][ScanlineEffect_TableLength]);
+/** Stops the effect. The register is left with the value for the last line which was drawn */
+void ScanlineEffect_Stop(struct ScanlineEffect *effect);
+
+/** The back table for 16-bit targets, which has Graphics_ScreenHeight entries to fill in */
+u16 *ScanlineEffect_BackTable16(struct ScanlineEffect *effect);
+/** The back table for the background scroll targets, which has Graphics_ScreenHeight entries to fill in */
+u32 *ScanlineEffect_BackTable32(struct ScanlineEffect *effect);
+/** The back table for effects from ScanlineEffect_StartAffine(), which has Graphics_ScreenHeight entries to fill in */
+struct AffineBackgroundParameters *ScanlineEffect_BackTableAffine(struct ScanlineEffect *effect);
+
+/**
+ * @brief Shows the back table from the next frame onwards
+ *
+ * The table which was being shown becomes the back table at the next VBlank, so don't fill it in until then. In the
+ * usual game loop where SystemCall_WaitForVBlank() comes first, that is already the case.
+ */
+void ScanlineEffect_Swap(struct ScanlineEffect *effect);
+
+/** @} */
@@ -0,0 +1,39 @@
+/**
+ * @file SparseLayer.h
+ * @brief Map layers which are mostly empty, like the tops of trees drawn in front of sprites
+ *
+ * Setting the boolean property `sparse` on a layer in Tiled makes tmxtogba store only the cells of that layer which
+ * aren't empty, grouped by 32x32 tile chunk. Each cell is one word with its position in the chunk in the top halfword
+ * and its screen entry in the bottom one, sorted by position.
+ *
+ * Since a whole chunk with nothing in it is just two equal chunk starts, it is cheap to find out that nothing on
+ * screen is in the layer and turn its background off with Background_SetEnabled().
+ *
+ * @defgroup SPARSELAYER Sparse layers
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** A layer generated by tmxtogba with the sparse property */
+struct SparseLayer
+{
+    const u32 *chunkStarts; /**< `<prefix><Layer>ChunkStarts`, the first cell of each chunk and then the number of cells */
+    const u32 *cells;       /**< `<prefix><Layer>Cells` */
+    int width;              /**< In tiles. Must be a multiple of 32 */
+    int height;             /**< In tiles. Must be a multiple of 32 */
+};
+
+/** The screen entry for the tile at x, y, which must be inside the layer. Empty cells are 0 */
+u16 SparseLayer_ScreenEntry(const struct SparseLayer *layer, int x, int y);
+/**
+ * @brief Whether every cell in the area is empty
+ *
+ * This only looks at whole chunks, so it can return false when the chunks overlapping the area have cells outside
+ * it. The area can go outside the layer, which repeats in every direction like MapStream.
+ */
+bool SparseLayer_IsAreaEmpty(const struct SparseLayer *layer, int x, int y, int width, int height);
+
+/** @} */
@@ -0,0 +1,80 @@
+/**
+ * @file SpriteTiles.h
+ * @brief Share sprite tile memory between sprites and stream animation frames into it
+ *
+ * Rather than copying every frame of every animation into VRAM up front, each animated sprite gets a slot big enough
+ * for one frame. When the frame changes, the new frame's tiles are queued and then copied in with DMA during the
+ * next VBlank, so only the tiles which are actually on screen take up sprite tile memory. Like MapStream, there is a
+ * queue for each of the two frames in Frame.h.
+ *
+ * Tile numbers count 32 byte tiles like ObjectAttribute_SetTile, so an 8bpp tile uses 2 of them.
+ *
+ * @defgroup SPRITETILES Sprite tile streaming
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** The number of 32 byte tiles in sprite tile memory */
+#define SpriteTiles_Length 1024
+/** The most copies which can be waiting for SpriteTiles_CommitQueued() */
+#define SpriteTiles_QueueLength 128
+
+/**
+ * @brief Reserves nTiles consecutive tiles of sprite tile memory
+ * @return The first tile, or -1 if there isn't a gap big enough
+ */
+int SpriteTiles_Allocate(int nTiles);
+/** Releases tiles reserved by SpriteTiles_Allocate() */
+void SpriteTiles_Free(int firstTile, int nTiles);
+
+/**
+ * @brief Queues a copy of tile data into sprite tile memory for the next SpriteTiles_CommitQueued()
+ * @param firstTile The tile to start copying to
+ * @param tileData Must stay valid until the queue is committed
+ * @param length The length of tileData in bytes. Must be a multiple of 4
+ * @return false if the queue for the frame being built is full, in which case nothing is queued
+ */
+bool SpriteTiles_QueueCopy(int firstTile, const u32 *tileData, int length);
+/**
+ * @brief Copies everything queued by SpriteTiles_QueueCopy() into sprite tile memory and empties the queue
+ *
+ * Call this during VBlank so the copies don't tear, either through Frame_QueueCall(), which copies the queue for
+ * the frame being applied, or straight after SystemCall_WaitForVBlank(), which copies the queue being built.
+ */
+void SpriteTiles_CommitQueued(void);
+
+/** One animated sprite's slot in sprite tile memory */
+struct SpriteTileStream
+{
+    /** The TileData of every frame, from pngtogba */
+    const u32 *tileData;
+    /** The length of a frame in bytes, the FrameLength from pngtogba */
+    int frameLength;
+    /** The first tile of the slot, to pass to ObjectAttribute_SetTile() */
+    int slot;
+    /** The FrameTile of the frame in the slot, or queued to go there. -1 before the first frame is set */
+    int currentFrameTile;
+};
+
+/**
+ * @brief Allocates a slot for one frame of the animation in tileData
+ * @param tileData The TileData output by pngtogba for an .aseprite file. It must not be compressed
+ * @param frameLength The FrameLength output by pngtogba
+ * @return false if there isn't enough sprite tile memory left
+ */
+bool SpriteTileStream_Init(struct SpriteTileStream *stream, const u32 *tileData, int frameLength);
+/**
+ * @brief Queues the frame starting at frameTile to be copied into the slot if it isn't there already
+ * @param frameTile An entry of the FrameTile array output by pngtogba
+ *
+ * Frames which pngtogba found to be identical share a FrameTile, so switching between them copies nothing. If the
+ * queue is full the frame is left as it is and the next call tries again.
+ */
+void SpriteTileStream_SetFrame(struct SpriteTileStream *stream, int frameTile);
+/** Releases the slot allocated by SpriteTileStream_Init() */
+void SpriteTileStream_Free(struct SpriteTileStream *stream);
+
+/** @} */
@@ -16,4 +16,18 @@ void SystemCall_WaitForVBlank(void);
 /** Performs a division and collects both the result and the remainder */
 void SystemCall_Divide(s32 numerator, s32 denominator, s32 *result, s32 *remainder);
 
+/**
+ * @brief Decompresses BIOS LZ77 data (as output by pngtogba with COMPRESS=LZ77) to target
+ *
+ * Writes 16 bits at a time so is safe to use with VRAM. source must be word aligned and target halfword aligned.
+ */
+void SystemCall_LZ77UnCompVram(const void *source, volatile void *target);
+
+/**
+ * @brief Decompresses BIOS run length encoded data (as output by pngtogba with COMPRESS=RLE) to target
+ *
+ * Writes 16 bits at a time so is safe to use with VRAM. source must be word aligned and target halfword aligned.
+ */
+void SystemCall_RLUnCompVram(const void *source, volatile void *target);
+
 /** @} */
\ No newline at end of file
@@ -41,6 +41,25 @@ void TileMap_CopyToSpritePalette(const u16 paletteData[TileMap_PaletteLength]);
  * The unsafe version of TileMap_CopyToSpriteTiles
  */
 void LOSTGBA_UNSAFE(TileMap_CopyToSpriteTiles)(int tileNumber, const u32 *tileData, int length);
+/**
+ * @brief Decompresses tile data straight into sprite tile memory
+ * @param tileNumber The sprite background block number. Either 0 or 1
+ * @param compressedData Tile data output by pngtogba with COMPRESS=LZ77 or COMPRESS=RLE
+ *
+ * The compression type is read from the header of compressedData, and LostGBA_Panic() stops the game if it is
+ * neither. Like TileMap_CopyToSpriteTiles, this static asserts on tileNumber.
+ */
+#define TileMap_DecompressToSpriteTiles(tileNumber, compressedData)                                      \
+    do                                                                                                   \
+    {                                                                                                    \
+        _Static_assert(0 <= tileNumber && tileNumber <= 1, "Sprites can only use tile numbers 0 and 1"); \
+        LOSTGBA_UNSAFE(TileMap_DecompressToSpriteTiles)                                                  \
+        (tileNumber, compressedData);                                                                    \
+    } while (0)
+/**
+ * The unsafe version of TileMap_DecompressToSpriteTiles
+ */
+void LOSTGBA_UNSAFE(TileMap_DecompressToSpriteTiles)(int tileNumber, const u32 *compressedData);
 
 /**
  * @brief Copies the provided palette data to the background palette memory location
@@ -68,5 +87,24 @@ void TileMap_CopyToBackgroundPalette(const u16 paletteData[TileMap_PaletteLength
  * The unsafe version of TileMap_CopyToBackgroundPalette
  */
 void LOSTGBA_UNSAFE(TileMap_CopyToBackgroundTiles)(int backgroundNumber, const u32 *tileData, int length);
+/**
+ * @brief Decompresses tile data straight into a background's tile memory
+ * @param backgroundNumber The tile block number to use. Must be between 0 and 3 inclusive.
+ * @param compressedData Tile data output by pngtogba with COMPRESS=LZ77 or COMPRESS=RLE
+ *
+ * The compression type is read from the header of compressedData, and LostGBA_Panic() stops the game if it is
+ * neither. This saves both ROM space and the time spent copying the uncompressed data over the cartridge bus.
+ */
+#define TileMap_DecompressToBackgroundTiles(backgroundNumber, compressedData)                                                  \
+    do                                                                                                                         \
+    {                                                                                                                          \
+        _Static_assert(0 <= backgroundNumber && backgroundNumber <= 3, "Background number must be between 0 and 3 inclusive"); \
+        LOSTGBA_UNSAFE(TileMap_DecompressToBackgroundTiles)                                                                    \
+        (backgroundNumber, compressedData);                                                                                    \
+    } while (0)
+/**
+ * The unsafe version of TileMap_DecompressToBackgroundTiles
+ */
+void LOSTGBA_UNSAFE(TileMap_DecompressToBackgroundTiles)(int backgroundNumber, const u32 *compressedData);
 
 /** @} */
\ No newline at end of file
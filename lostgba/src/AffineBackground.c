@@ -0,0 +1,162 @@
+#include <lostgba/AffineBackground.h>
+#include <lostgba/Dma.h>
+#include <lostgba/SystemCalls.h>
+#include "LostGbaInternal.h"
+
+#define VRAM_BASE ((vu16 *)0x06000000)
+#define SCREEN_BLOCK_LENGTH 1024
+
+static volatile struct AffineBackgroundParameters *AffineBackground_registers = (volatile struct AffineBackgroundParameters *)0x04000020; // REG_BG2PA
+
+// Like Background_setBits, this only changes the shadow register
+static void AffineBackground_setBits(enum BackgroundNumber backgroundNumber, u16 value, u16 length, u16 shift)
+{
+    LostGBA_SetBits16(&LostGBA_displayRegisters.backgroundControl[backgroundNumber], value, length, shift);
+    LostGBA_displayRegisters.dirty |= LostGBA_DisplayRegisterDirty_BackgroundControl0 << backgroundNumber;
+}
+
+void LOSTGBA_UNSAFE(AffineBackground_SetSize)(enum BackgroundNumber backgroundNumber, enum AffineBackgroundSize affineBackgroundSize)
+{
+    AffineBackground_setBits(backgroundNumber, affineBackgroundSize, 2, 14);
+}
+
+void LOSTGBA_UNSAFE(AffineBackground_SetWraparound)(enum BackgroundNumber backgroundNumber, bool wraparound)
+{
+    AffineBackground_setBits(backgroundNumber, wraparound, 1, 13);
+}
+
+volatile struct AffineBackgroundParameters *AffineBackground_Registers(enum BackgroundNumber backgroundNumber)
+{
+    return &AffineBackground_registers[backgroundNumber - BackgroundNumber_2];
+}
+
+void LOSTGBA_UNSAFE(AffineBackground_SetParameters)(enum BackgroundNumber backgroundNumber, const struct AffineBackgroundParameters *parameters)
+{
+    volatile struct AffineBackgroundParameters *registers = AffineBackground_Registers(backgroundNumber);
+
+    registers->pa = parameters->pa;
+    registers->pb = parameters->pb;
+    registers->pc = parameters->pc;
+    registers->pd = parameters->pd;
+    registers->x = parameters->x;
+    registers->y = parameters->y;
+}
+
+static int AffineBackground_widthInTiles(enum AffineBackgroundSize affineBackgroundSize)
+{
+    return 16 << affineBackgroundSize;
+}
+
+void LOSTGBA_UNSAFE(AffineBackground_SetTile)(int screenBaseBlock, enum AffineBackgroundSize affineBackgroundSize, int x, int y, u8 tileId)
+{
+    int index = y * AffineBackground_widthInTiles(affineBackgroundSize) + x;
+    vu16 *entries = VRAM_BASE + SCREEN_BLOCK_LENGTH * screenBaseBlock + index / 2;
+
+    // the even entry is in the low byte
+    LostGBA_SetVBits16(entries, tileId, 8, (index % 2) * 8);
+}
+
+void LOSTGBA_UNSAFE(AffineBackground_CopyMap)(int screenBaseBlock, enum AffineBackgroundSize affineBackgroundSize, const u8 *map)
+{
+    int width = AffineBackground_widthInTiles(affineBackgroundSize);
+    Dma_Copy32(VRAM_BASE + SCREEN_BLOCK_LENGTH * screenBaseBlock, map, width * width / sizeof(u32));
+}
+
+void AffineBackground_RotateScale(struct AffineBackgroundParameters *parameters, Fixed scale, u16 angle, Fixed mapX, Fixed mapY, int screenX, int screenY)
+{
+    // the matrix goes from the screen to the map, so it uses the inverse of the scale
+    s32 inverseScale, remainder;
+    SystemCall_Divide(Fixed_One * Fixed_One, scale, &inverseScale, &remainder);
+
+    s32 cos = (inverseScale * LostGBA_Cos12(angle)) >> 12;
+    s32 sin = (inverseScale * LostGBA_Sin12(angle)) >> 12;
+
+    parameters->pa = cos;
+    parameters->pb = sin;
+    parameters->pc = -sin;
+    parameters->pd = cos;
+    parameters->x = mapX - (cos * screenX + sin * screenY);
+    parameters->y = mapY - (-sin * screenX + cos * screenY);
+}
+
+void AffineBackground_Mode7Lines(struct AffineBackgroundParameters *lines, const struct AffineBackgroundCamera *camera)
+{
+    s32 cos = LostGBA_Cos12(camera->angle);
+    s32 sin = LostGBA_Sin12(camera->angle);
+
+    for (int line = 0; line < Graphics_ScreenHeight; line++)
+    {
+        struct AffineBackgroundParameters *parameters = &lines[line];
+        int linesBelowHorizon = line - camera->horizon;
+
+        // only pa and pc matter since the reference point is set again on every line
+        parameters->pb = 0;
+        parameters->pd = 0;
+
+        if (linesBelowHorizon <= 0)
+        {
+            parameters->pa = 0;
+            parameters->pc = 0;
+            parameters->x = Fixed_FromInt(-1);
+            parameters->y = Fixed_FromInt(-1);
+            continue;
+        }
+
+        // The map under this line is distance pixels in front of the camera, and each pixel across the line covers
+        // scale pixels of the map. Both have 12 fractional bits
+        s32 scale, remainder;
+        SystemCall_Divide(camera->height << 12, linesBelowHorizon, &scale, &remainder);
+        s64 distance = (s64)scale * camera->focalLength;
+
+        parameters->pa = ((s64)scale * cos) >> 16;
+        parameters->pc = ((s64)scale * sin) >> 16;
+
+        // straight ahead is (sin, -cos) on the map and the middle of the line is half the screen from the left
+        parameters->x = camera->x + (s32)((distance * sin) >> 16) - (Graphics_ScreenWidth / 2) * parameters->pa;
+        parameters->y = camera->y - (s32)((distance * cos) >> 16) - (Graphics_ScreenWidth / 2) * parameters->pc;
+    }
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+LostGBA_Test("AffineBackground_RotateScale keeps the map point at the screen point")
+{
+    struct AffineBackgroundParameters parameters;
+
+    AffineBackground_RotateScale(&parameters, Fixed_One, 0, Fixed_FromInt(64), Fixed_FromInt(32), 120, 80);
+    LostGBA_Assert(parameters.pa == Fixed_One && parameters.pb == 0 && parameters.pc == 0 && parameters.pd == Fixed_One, "Unrotated should be the identity");
+    LostGBA_Assert(parameters.x == Fixed_FromInt(64 - 120) && parameters.y == Fixed_FromInt(32 - 80), "Wrong reference point");
+
+    AffineBackground_RotateScale(&parameters, 2 * Fixed_One, Fixed_QuarterTurn, 0, 0, 0, 0);
+    LostGBA_Assert(parameters.pa == 0 && parameters.pb == Fixed_One / 2 && parameters.pc == -Fixed_One / 2, "Wrong rotated and scaled matrix");
+}
+
+LostGBA_Test("AffineBackground_Mode7Lines scales the map by the distance below the horizon")
+{
+    static struct AffineBackgroundParameters lines[Graphics_ScreenHeight];
+    struct AffineBackgroundCamera camera = {
+        .x = Fixed_FromInt(500),
+        .y = Fixed_FromInt(600),
+        .height = 32,
+        .angle = 0,
+        .horizon = 40,
+        .focalLength = 256};
+
+    AffineBackground_Mode7Lines(lines, &camera);
+
+    LostGBA_Assert(lines[40].pa == 0 && lines[40].y < 0, "The horizon line should be off the map");
+
+    // 32 lines below the horizon is as far below the camera as it is high, so the map is unscaled there
+    LostGBA_Assert(lines[72].pa == Fixed_One && lines[72].pc == 0, "Wrong scale");
+    LostGBA_Assert(lines[72].x == Fixed_FromInt(500 - 120) && lines[72].y == Fixed_FromInt(600 - 256), "Wrong reference point");
+    LostGBA_Assert(lines[104].pa == Fixed_One / 2, "Further down the screen should be closer");
+
+    camera.angle = Fixed_QuarterTurn;
+    AffineBackground_Mode7Lines(lines, &camera);
+    LostGBA_Assert(lines[72].pa == 0 && lines[72].pc == Fixed_One, "Facing right, across the screen should go down the map");
+    LostGBA_Assert(lines[72].x == Fixed_FromInt(500 + 256) && lines[72].y == Fixed_FromInt(600 - 120), "Wrong reference point facing right");
+}
+
+#endif
@@ -1,11 +1,18 @@
 #include <lostgba/Background.h>
+#include <lostgba/Dma.h>
 #include "LostGbaInternal.h"
 
-static vu16 *Background_ControlRegisterBaseAddr = (vu16 *)0x04000008;
-
+// These only change the shadow registers, which Graphics_CommitRegisters() writes to the hardware
 static void Background_setBits(enum BackgroundNumber backgroundNumber, u16 value, u16 length, u16 shift)
 {
-    LostGBA_SetVBits16(&Background_ControlRegisterBaseAddr[backgroundNumber], value, length, shift);
+    LostGBA_SetBits16(&LostGBA_displayRegisters.backgroundControl[backgroundNumber], value, length, shift);
+    LostGBA_displayRegisters.dirty |= LostGBA_DisplayRegisterDirty_BackgroundControl0 << backgroundNumber;
+}
+
+void Background_SetEnabled(enum BackgroundNumber backgroundNumber, bool enabled)
+{
+    LostGBA_SetBits16(&LostGBA_displayRegisters.displayControl, enabled, 1, 8 + backgroundNumber);
+    LostGBA_displayRegisters.dirty |= LostGBA_DisplayRegisterDirty_DisplayControl;
 }
 
 void Background_SetPriority(enum BackgroundNumber backgroundNumber, int priority)
@@ -61,16 +68,130 @@ static int Background_screenBlockOffset(enum BackgroundSize backgroundSize, int
 #define VRAM_BASE ((vu16 *)0x06000000)
 #define SCREEN_BLOCK_LENGTH 1024
 
-void LOSTGBA_UNSAFE(Background_SetTile)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int tileId, bool hflip, bool vflip, int paletteBank)
+void LOSTGBA_UNSAFE(Background_SetTileEntry)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, u16 screenEntry)
 {
-    u16 screenEntry = Background_makeScreenEntry(tileId, hflip, vflip, paletteBank);
-
     int screenBlockStep = (x % 32) + (y % 32) * 32;
     int screenBlockOffset = Background_screenBlockOffset(backgroundSize, x, y);
 
     *(VRAM_BASE + (SCREEN_BLOCK_LENGTH * (screenBaseBlock + screenBlockOffset)) + screenBlockStep) = screenEntry;
 }
 
+void LOSTGBA_UNSAFE(Background_SetTile)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int tileId, bool hflip, bool vflip, int paletteBank)
+{
+    u16 screenEntry = Background_makeScreenEntry(tileId, hflip, vflip, paletteBank);
+    LOSTGBA_UNSAFE(Background_SetTileEntry)(screenBaseBlock, backgroundSize, x, y, screenEntry);
+}
+
+static int Background_numScreenBlocks(enum BackgroundSize backgroundSize)
+{
+    switch (backgroundSize)
+    {
+    case BackgroundSize_32x32:
+        return 1;
+    case BackgroundSize_32x64:
+    case BackgroundSize_64x32:
+        return 2;
+    case BackgroundSize_64x64:
+        return 4;
+    default:
+        LOSTGBA_UNREACHABLE();
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_CopyScreenEntries)(int screenBaseBlock, enum BackgroundSize backgroundSize, const u16 *screenEntries)
+{
+    int length = Background_numScreenBlocks(backgroundSize) * SCREEN_BLOCK_LENGTH;
+    Dma_Copy32(VRAM_BASE + SCREEN_BLOCK_LENGTH * screenBaseBlock, screenEntries, length * sizeof(u16) / sizeof(u32));
+}
+
+void LOSTGBA_UNSAFE(Background_FillScreenEntries)(int screenBaseBlock, enum BackgroundSize backgroundSize, u16 screenEntry)
+{
+    int length = Background_numScreenBlocks(backgroundSize) * SCREEN_BLOCK_LENGTH;
+    Dma_Fill32(VRAM_BASE + SCREEN_BLOCK_LENGTH * screenBaseBlock, screenEntry | ((u32)screenEntry << 16), length * sizeof(u16) / sizeof(u32));
+}
+
+static int Background_widthInTiles(enum BackgroundSize backgroundSize)
+{
+    return backgroundSize == BackgroundSize_64x32 || backgroundSize == BackgroundSize_64x64 ? 64 : 32;
+}
+
+static int Background_heightInTiles(enum BackgroundSize backgroundSize)
+{
+    return backgroundSize == BackgroundSize_32x64 || backgroundSize == BackgroundSize_64x64 ? 64 : 32;
+}
+
+// x and y must already be inside the background
+static vu16 *Background_screenEntryAddress(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y)
+{
+    int screenBlock = screenBaseBlock + Background_screenBlockOffset(backgroundSize, x, y);
+    return VRAM_BASE + SCREEN_BLOCK_LENGTH * screenBlock + (y % 32) * 32 + x % 32;
+}
+
+void LOSTGBA_UNSAFE(Background_SetTileRow)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *screenEntries, int length)
+{
+    // the sizes are powers of 2 so this wraps negative positions too
+    int widthMask = Background_widthInTiles(backgroundSize) - 1;
+    y &= Background_heightInTiles(backgroundSize) - 1;
+
+    while (length > 0)
+    {
+        x &= widthMask;
+
+        // the rest of this row of the screenblock is contiguous in VRAM
+        int run = 32 - x % 32;
+        if (run > length)
+        {
+            run = length;
+        }
+
+        LostGBA_VMemCpy(Background_screenEntryAddress(screenBaseBlock, backgroundSize, x, y), screenEntries, run * sizeof(u16));
+
+        screenEntries += run;
+        x += run;
+        length -= run;
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_SetTileColumn)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *screenEntries, int length)
+{
+    int heightMask = Background_heightInTiles(backgroundSize) - 1;
+    x &= Background_widthInTiles(backgroundSize) - 1;
+
+    while (length > 0)
+    {
+        y &= heightMask;
+
+        int run = 32 - y % 32;
+        if (run > length)
+        {
+            run = length;
+        }
+
+        vu16 *target = Background_screenEntryAddress(screenBaseBlock, backgroundSize, x, y);
+        for (int i = 0; i < run; i++)
+        {
+            target[i * 32] = screenEntries[i];
+        }
+
+        screenEntries += run;
+        y += run;
+        length -= run;
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_SetTileRect)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int width, int height, const u16 *screenEntries)
+{
+    for (int row = 0; row < height; row++)
+    {
+        LOSTGBA_UNSAFE(Background_SetTileRow)(screenBaseBlock, backgroundSize, x, y + row, screenEntries + row * width, width);
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_CopyScreenBlock)(int screenBlock, const u16 *screenEntries)
+{
+    Dma_Copy32(VRAM_BASE + SCREEN_BLOCK_LENGTH * screenBlock, screenEntries, SCREEN_BLOCK_LENGTH * sizeof(u16) / sizeof(u32));
+}
+
 static vu16 *Background_HorizontalOffsetBaseAddr = (vu16 *)0x04000010;
 static vu16 *Background_VerticalOffsetBaseAddr = (vu16 *)0x4000012;
 
@@ -82,4 +203,119 @@ void Background_SetHorizontalOffset(enum BackgroundNumber backgroundNumber, int
 void Background_SetVerticalOffset(enum BackgroundNumber backgroundNumber, int vOffset)
 {
     *(Background_VerticalOffsetBaseAddr + 2 * backgroundNumber) = vOffset;
-}
\ No newline at end of file
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+#include <lostgba/Print.h>
+
+// timers 2 and 3 are cascaded into one 32-bit cycle counter
+static vu16 *Background_testTimer2Counter = (vu16 *)0x04000108; // REG_TM2CNT_L
+static vu16 *Background_testTimer2Control = (vu16 *)0x0400010a; // REG_TM2CNT_H
+static vu16 *Background_testTimer3Counter = (vu16 *)0x0400010c; // REG_TM3CNT_L
+static vu16 *Background_testTimer3Control = (vu16 *)0x0400010e; // REG_TM3CNT_H
+
+#define TIMER_CASCADE (1 << 2)
+#define TIMER_ENABLE (1 << 7)
+
+static void Background_testStartTimer(void)
+{
+    *Background_testTimer2Control = 0;
+    *Background_testTimer3Control = 0;
+    // writing the counter sets the value it starts from
+    *Background_testTimer2Counter = 0;
+    *Background_testTimer3Counter = 0;
+    *Background_testTimer3Control = TIMER_CASCADE | TIMER_ENABLE;
+    *Background_testTimer2Control = TIMER_ENABLE;
+}
+
+static u32 Background_testStopTimer(void)
+{
+    *Background_testTimer2Control = 0;
+    return ((u32)*Background_testTimer3Counter << 16) | *Background_testTimer2Counter;
+}
+
+// 64x64 screen entries row by row, which are all different
+__attribute__((aligned(4))) static u16 Background_testMap[64 * 64];
+
+static void Background_testInitMap(void)
+{
+    for (int i = 0; i < 64 * 64; i++)
+    {
+        Background_testMap[i] = i;
+    }
+}
+
+static bool Background_testMatchesMap(int screenBaseBlock)
+{
+    for (int y = 0; y < 64; y++)
+    {
+        for (int x = 0; x < 64; x++)
+        {
+            if (*Background_screenEntryAddress(screenBaseBlock, BackgroundSize_64x64, x, y) != Background_testMap[y * 64 + x])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+LostGBA_Test("Background_SetTileRow and Background_SetTileColumn wrap around the background")
+{
+    static const u16 entries[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    Background_SetTileRow(28, BackgroundSize_64x64, 60, 40, entries, 8);
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 60, 40) == 1, "Row starts in the wrong place");
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 63, 40) == 4, "Row is wrong before the edge");
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 0, 40) == 5, "Row should wrap to the left edge");
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 3, 40) == 8, "Row is wrong after the edge");
+
+    Background_SetTileColumn(28, BackgroundSize_64x64, 31, -2, entries, 8);
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 31, 62) == 1, "Column should start at the bottom");
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 31, 0) == 3, "Column should wrap to the top");
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 31, 5) == 8, "Column is wrong after the edge");
+    LostGBA_Assert(*Background_screenEntryAddress(28, BackgroundSize_64x64, 32, 0) != 3, "Column spilled into the next screenblock");
+}
+
+LostGBA_Test("Background_SetTileRect fills a 64x64 background faster than Background_SetTileEntry")
+{
+    Background_testInitMap();
+
+    Background_testStartTimer();
+    for (int y = 0; y < 64; y++)
+    {
+        for (int x = 0; x < 64; x++)
+        {
+            Background_SetTileEntry(28, BackgroundSize_64x64, x, y, Background_testMap[y * 64 + x]);
+        }
+    }
+    u32 perCellCycles = Background_testStopTimer();
+    LostGBA_Assert(Background_testMatchesMap(28), "Background_SetTileEntry wrote the wrong entries");
+
+    // the map is row by row rather than in screenblock order, so this mixes up the entries again
+    Background_CopyScreenEntries(28, BackgroundSize_64x64, Background_testMap);
+
+    Background_testStartTimer();
+    Background_SetTileRect(28, BackgroundSize_64x64, 0, 0, 64, 64, Background_testMap);
+    u32 rectCycles = Background_testStopTimer();
+    LostGBA_Assert(Background_testMatchesMap(28), "Background_SetTileRect wrote the wrong entries");
+
+    // the map isn't in screenblock order for this one, it's only timed
+    Background_testStartTimer();
+    for (int i = 0; i < 4; i++)
+    {
+        LOSTGBA_UNSAFE(Background_CopyScreenBlock)(28 + i, Background_testMap + i * SCREEN_BLOCK_LENGTH);
+    }
+    u32 copyCycles = Background_testStopTimer();
+
+    LostGBA_PrintLn("64x64 fill: Background_SetTileEntry %d cycles, Background_SetTileRect %d cycles, 4x Background_CopyScreenBlock %d cycles",
+                    (int)perCellCycles, (int)rectCycles, (int)copyCycles);
+
+    LostGBA_Assert(rectCycles < perCellCycles, "Background_SetTileRect should be faster than one entry at a time");
+    LostGBA_Assert(copyCycles < rectCycles, "DMA copies should be faster than Background_SetTileRect");
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include <lostgba/Collision.h>
+#include "LostGbaInternal.h"
+
+bool CollisionMap_IsSolid(const struct CollisionMap *map, int x, int y)
+{
+    return CollisionMap_IsAnySolid(map, x, y, 1);
+}
+
+bool CollisionMap_IsAnySolid(const struct CollisionMap *map, int x, int y, int count)
+{
+    int wordsPerRow = map->width / 32;
+    const u32 *row = map->bitmap + y * wordsPerRow;
+
+    int word = x / 32;
+    int bit = x % 32;
+
+    u32 cells = row[word] >> bit;
+    if (bit + count > 32)
+    {
+        // the rest are the low bits of the next word, which is the start of the row at the right edge
+        cells |= row[(word + 1) % wordsPerRow] << (32 - bit);
+    }
+
+    u32 mask = count == 32 ? ~0u : (1u << count) - 1;
+    return (cells & mask) != 0;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+LostGBA_Test("CollisionMap_IsAnySolid finds solid cells across words")
+{
+    // 64x2, solid at (33, 0) and (0, 1)
+    static const u32 bitmap[] = {0, 1u << 1, 1, 0};
+    struct CollisionMap map = {.bitmap = bitmap, .width = 64, .height = 2};
+
+    LostGBA_Assert(CollisionMap_IsSolid(&map, 33, 0), "Should be solid");
+    LostGBA_Assert(!CollisionMap_IsSolid(&map, 32, 0), "Shouldn't be solid");
+    LostGBA_Assert(!CollisionMap_IsSolid(&map, 1, 0), "Shouldn't read the wrong word");
+
+    LostGBA_Assert(CollisionMap_IsAnySolid(&map, 30, 0, 4), "Should find the solid cell in the next word");
+    LostGBA_Assert(!CollisionMap_IsAnySolid(&map, 30, 0, 3), "Should stop before the solid cell");
+    LostGBA_Assert(!CollisionMap_IsAnySolid(&map, 0, 0, 32), "Should check exactly one word");
+}
+
+LostGBA_Test("CollisionMap_IsAnySolid wraps around to the start of the row")
+{
+    static const u32 bitmap[] = {0, 0, 1, 0};
+    struct CollisionMap map = {.bitmap = bitmap, .width = 64, .height = 2};
+
+    LostGBA_Assert(CollisionMap_IsAnySolid(&map, 62, 1, 3), "Should wrap to the first cell of the row");
+    LostGBA_Assert(!CollisionMap_IsAnySolid(&map, 62, 1, 2), "Should stop at the end of the row");
+    LostGBA_Assert(!CollisionMap_IsAnySolid(&map, 62, 0, 3), "Should wrap within the same row");
+}
+
+#endif
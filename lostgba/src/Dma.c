@@ -0,0 +1,104 @@
+#include <lostgba/Dma.h>
+#include "LostGbaInternal.h"
+
+static vu32 *Dma_sourceAddressRegister3 = (vu32 *)0x040000d4;      // REG_DMA3SAD
+static vu32 *Dma_destinationAddressRegister3 = (vu32 *)0x040000d8; // REG_DMA3DAD
+static vu32 *Dma_controlRegister3 = (vu32 *)0x040000dc;            // REG_DMA3CNT, word count in the low half
+
+// channel n's registers are 12 bytes after channel n - 1's
+static vu32 *Dma_sourceAddressRegister0 = (vu32 *)0x040000b0;      // REG_DMA0SAD
+static vu32 *Dma_destinationAddressRegister0 = (vu32 *)0x040000b4; // REG_DMA0DAD
+static vu32 *Dma_controlRegister0 = (vu32 *)0x040000b8;            // REG_DMA0CNT
+
+#define DMA_CHANNEL_STEP (12 / sizeof(u32))
+
+static vu16 *Dma_interruptMasterEnableRegister = (vu16 *)0x04000208; // REG_IME
+
+#define DMA_DESTINATION_RELOAD (3u << 21)
+#define DMA_SOURCE_FIXED (2u << 23)
+#define DMA_REPEAT (1u << 25)
+#define DMA_32BIT (1u << 26)
+#define DMA_AT_HBLANK (2u << 28)
+#define DMA_ENABLE (1u << 31)
+
+static void Dma_start3(volatile void *target, const void *source, int words, u32 control)
+{
+    // The VBlank interrupt copies on channel 3 too when it applies a Frame. The address registers can't be read
+    // back to restore them afterwards, so interrupts wait until this copy has been started instead
+    u16 interruptsEnabled = *Dma_interruptMasterEnableRegister;
+    *Dma_interruptMasterEnableRegister = 0;
+
+    *Dma_sourceAddressRegister3 = (u32)(uintptr_t)source;
+    *Dma_destinationAddressRegister3 = (u32)(uintptr_t)target;
+
+    // the CPU is halted until an immediate copy is done, so there's no need to wait for the enable bit to clear
+    *Dma_controlRegister3 = (words & LostGBA_AllOnes16(16)) | control | DMA_32BIT | DMA_ENABLE;
+
+    *Dma_interruptMasterEnableRegister = interruptsEnabled;
+}
+
+void Dma_Copy32(volatile void *target, const void *source, int words)
+{
+    Dma_start3(target, source, words, 0);
+}
+
+void Dma_Fill32(volatile void *target, u32 value, int words)
+{
+    // the source stays on value for every word. It's only read while the copy runs, so it can be on the stack
+    Dma_start3(target, &value, words, DMA_SOURCE_FIXED);
+}
+
+void Dma_StartHBlankCopies(int channel, volatile void *target, const void *source, int halfwords)
+{
+    // the low half is how many units are copied each HBlank
+    u32 count = halfwords == 1 ? 1 : (halfwords / 2) | DMA_32BIT;
+
+    Dma_Stop(channel);
+
+    Dma_sourceAddressRegister0[channel * DMA_CHANNEL_STEP] = (u32)(uintptr_t)source;
+    Dma_destinationAddressRegister0[channel * DMA_CHANNEL_STEP] = (u32)(uintptr_t)target;
+    Dma_controlRegister0[channel * DMA_CHANNEL_STEP] = count | DMA_DESTINATION_RELOAD | DMA_REPEAT | DMA_AT_HBLANK | DMA_ENABLE;
+}
+
+void Dma_Stop(int channel)
+{
+    Dma_controlRegister0[channel * DMA_CHANNEL_STEP] = 0;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+LostGBA_Test("Dma_Copy32 copies exactly the requested words")
+{
+    u32 source[16];
+    u32 target[18] = {0};
+
+    for (int i = 0; i < 16; i++)
+    {
+        source[i] = 0x01010101 * (i + 1);
+    }
+
+    Dma_Copy32(target + 1, source, 16);
+
+    LostGBA_Assert(target[0] == 0 && target[17] == 0, "Copied outside of the target");
+    for (int i = 0; i < 16; i++)
+    {
+        LostGBA_Assert(target[i + 1] == source[i], "Copied words don't match");
+    }
+}
+
+LostGBA_Test("Dma_Fill32 fills exactly the requested words")
+{
+    u32 target[18] = {0};
+
+    Dma_Fill32(target + 1, 0x12345678, 16);
+
+    LostGBA_Assert(target[0] == 0 && target[17] == 0, "Filled outside of the target");
+    for (int i = 0; i < 16; i++)
+    {
+        LostGBA_Assert(target[i + 1] == 0x12345678, "Filled words don't match");
+    }
+}
+
+#endif
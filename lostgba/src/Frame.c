@@ -0,0 +1,203 @@
+#include <lostgba/Frame.h>
+#include <lostgba/Dma.h>
+#include <lostgba/Graphics.h>
+#include <lostgba/ObjectAttribute.h>
+#include <lostgba/SystemCalls.h>
+#include "LostGbaInternal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define OBJECT_ATTRIBUTE_MEMORY ((vu32 *)0x07000000)
+
+struct FrameCopy
+{
+    volatile void *target;
+    const void *source;
+    int words;
+};
+
+struct FrameCall
+{
+    void (*function)(void *argument);
+    void *argument;
+};
+
+struct Frame
+{
+    s16 scroll[4][2];
+    u8 scrollSet; // one bit per background
+    bool hasObjectAttributes;
+
+    int copyCount;
+    struct FrameCopy copies[Frame_CopyQueueLength];
+    int callCount;
+    struct FrameCall calls[Frame_CallQueueLength];
+
+    // LostGBA_displayRegisters as they were when the frame was submitted
+    struct LostGBA_DisplayRegisters displayRegisters;
+
+    struct ObjectAttribute objectAttributes[ObjectAttributeBuffer_Length];
+};
+
+static struct Frame Frame_frames[2];
+static struct Frame *Frame_building = &Frame_frames[0];
+// only the VBlank interrupt clears this, and only Frame_Submit() sets it
+static struct Frame *volatile Frame_pending;
+// only set while the VBlank interrupt is applying Frame_pending
+static struct Frame *Frame_applying;
+
+void Frame_SetScroll(enum BackgroundNumber backgroundNumber, int hOffset, int vOffset)
+{
+    Frame_building->scroll[backgroundNumber][0] = hOffset;
+    Frame_building->scroll[backgroundNumber][1] = vOffset;
+    Frame_building->scrollSet |= 1 << backgroundNumber;
+}
+
+void Frame_QueueObjectAttributes(void)
+{
+    memcpy(Frame_building->objectAttributes, objectAttributeBuffer, sizeof(Frame_building->objectAttributes));
+    Frame_building->hasObjectAttributes = true;
+}
+
+bool Frame_QueueCopy(volatile void *target, const void *source, int words)
+{
+    if (Frame_building->copyCount == Frame_CopyQueueLength)
+    {
+        return false;
+    }
+
+    Frame_building->copies[Frame_building->copyCount++] = (struct FrameCopy){target, source, words};
+    return true;
+}
+
+bool Frame_QueueCall(void (*function)(void *argument), void *argument)
+{
+    if (Frame_building->callCount == Frame_CallQueueLength)
+    {
+        return false;
+    }
+
+    Frame_building->calls[Frame_building->callCount++] = (struct FrameCall){function, argument};
+    return true;
+}
+
+void Frame_Submit(void)
+{
+    while (Frame_pending != NULL)
+    {
+        SystemCall_WaitForVBlank();
+    }
+
+    // the setters carry on changing LostGBA_displayRegisters for the next frame, so this frame keeps its own copy
+    Frame_building->displayRegisters = LostGBA_displayRegisters;
+    LostGBA_displayRegisters.dirty = 0;
+
+    Frame_pending = Frame_building;
+
+    Frame_building = Frame_building == &Frame_frames[0] ? &Frame_frames[1] : &Frame_frames[0];
+    Frame_building->scrollSet = 0;
+    Frame_building->hasObjectAttributes = false;
+    Frame_building->copyCount = 0;
+    Frame_building->callCount = 0;
+}
+
+int LostGBA_FrameQueueIndex(void)
+{
+    struct Frame *frame = Frame_applying != NULL ? Frame_applying : Frame_building;
+    return frame - Frame_frames;
+}
+
+void LostGBA_FrameApplyPending(void)
+{
+    struct Frame *frame = Frame_pending;
+    if (frame == NULL)
+    {
+        return;
+    }
+
+    Frame_applying = frame;
+
+    LostGBA_WriteDisplayRegisters(&frame->displayRegisters);
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (frame->scrollSet & (1 << i))
+        {
+            Background_SetHorizontalOffset(i, frame->scroll[i][0]);
+            Background_SetVerticalOffset(i, frame->scroll[i][1]);
+        }
+    }
+
+    if (frame->hasObjectAttributes)
+    {
+        Dma_Copy32(OBJECT_ATTRIBUTE_MEMORY, frame->objectAttributes, ObjectAttributeBuffer_Length * sizeof(struct ObjectAttribute) / sizeof(u32));
+    }
+
+    for (int i = 0; i < frame->copyCount; i++)
+    {
+        Dma_Copy32(frame->copies[i].target, frame->copies[i].source, frame->copies[i].words);
+    }
+
+    for (int i = 0; i < frame->callCount; i++)
+    {
+        frame->calls[i].function(frame->calls[i].argument);
+    }
+
+    Frame_applying = NULL;
+    Frame_pending = NULL;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+static void Frame_testCall(void *argument)
+{
+    (*(int *)argument)++;
+}
+
+LostGBA_Test("Frame is only applied in the VBlank after Frame_Submit")
+{
+    static u32 source[4] = {1, 2, 3, 4};
+    static u32 target[4];
+    static int calls;
+
+    LostGBA_Assert(Frame_QueueCopy(target, source, 4), "Queue shouldn't be full");
+    LostGBA_Assert(Frame_QueueCall(Frame_testCall, &calls), "Queue shouldn't be full");
+
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(target[0] == 0 && calls == 0, "Nothing should be applied before the frame is submitted");
+
+    Frame_Submit();
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(target[0] == 1 && target[3] == 4, "Copy wasn't applied");
+    LostGBA_Assert(calls == 1, "Call wasn't applied");
+
+    Frame_Submit();
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(calls == 1, "An empty frame shouldn't repeat the last one");
+}
+
+LostGBA_Test("Frame_Submit keeps the register settings the frame was built with")
+{
+    static vu16 *blendControlRegister = (vu16 *)0x04000050; // REG_BLDCNT
+    u16 blendControl = *blendControlRegister;
+
+    Graphics_SetBlendingMode(GraphicsBlendingMode_Alpha);
+    Frame_Submit();
+    // building the next frame straight away mustn't change the one waiting for VBlank
+    Graphics_SetBlendingMode(GraphicsBlendingMode_Disabled);
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(((*blendControlRegister >> 6) & 3) == GraphicsBlendingMode_Alpha, "The submitted frame's blending mode wasn't applied");
+
+    Frame_Submit();
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(((*blendControlRegister >> 6) & 3) == GraphicsBlendingMode_Disabled, "The next frame's blending mode wasn't applied");
+
+    Graphics_SetBlendingMode(blendControl >> 6);
+    Frame_Submit();
+    SystemCall_WaitForVBlank();
+}
+
+#endif
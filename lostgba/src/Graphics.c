@@ -2,6 +2,10 @@
 #include "LostGbaInternal.h"
 
 static vu16 *Graphics_displayControlRegister = (vu16 *)0x04000000;
+static vu16 *Graphics_backgroundControlRegisters = (vu16 *)0x04000008; // REG_BG0CNT
+static vu16 *Graphics_blendingModeRegister = (vu16 *)0x04000050;       // REG_BLDCNT
+
+struct LostGBA_DisplayRegisters LostGBA_displayRegisters;
 
 void Graphics_SetMode(struct GraphicsSettings settings)
 {
@@ -15,7 +19,8 @@ void Graphics_SetMode(struct GraphicsSettings settings)
                (settings.enableBG3 << 11) |
                (settings.enableSprites << 12);
 
-    *Graphics_displayControlRegister = mode;
+    LostGBA_displayRegisters.displayControl = mode;
+    LostGBA_displayRegisters.dirty |= LostGBA_DisplayRegisterDirty_DisplayControl;
 }
 
 static vu16 *Graphics_displayStatusRegister = (vu16 *)0x04000004;
@@ -25,9 +30,68 @@ void Graphics_SetVBlankInterrupt(bool enabled)
     *Graphics_displayStatusRegister |= enabled << 3;
 }
 
-static vu16 *Graphics_blendingModeRegister = (vu16 *)0x04000050;
+void Graphics_SetHBlankInterrupt(bool enabled)
+{
+    LostGBA_SetVBits16(Graphics_displayStatusRegister, enabled, 1, 4);
+}
 
 void Graphics_SetBlendingMode(enum GraphicsBlendingMode blendingMode)
 {
-    LostGBA_SetVBits16(Graphics_blendingModeRegister, blendingMode, 2, 6);
-}
\ No newline at end of file
+    LostGBA_SetBits16(&LostGBA_displayRegisters.blendControl, blendingMode, 2, 6);
+    LostGBA_displayRegisters.dirty |= LostGBA_DisplayRegisterDirty_BlendControl;
+}
+
+void LostGBA_WriteDisplayRegisters(const struct LostGBA_DisplayRegisters *shadow)
+{
+    if (shadow->dirty & LostGBA_DisplayRegisterDirty_DisplayControl)
+    {
+        *Graphics_displayControlRegister = shadow->displayControl;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (shadow->dirty & (LostGBA_DisplayRegisterDirty_BackgroundControl0 << i))
+        {
+            Graphics_backgroundControlRegisters[i] = shadow->backgroundControl[i];
+        }
+    }
+
+    if (shadow->dirty & LostGBA_DisplayRegisterDirty_BlendControl)
+    {
+        *Graphics_blendingModeRegister = shadow->blendControl;
+    }
+}
+
+void Graphics_CommitRegisters(void)
+{
+    LostGBA_WriteDisplayRegisters(&LostGBA_displayRegisters);
+    LostGBA_displayRegisters.dirty = 0;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+LostGBA_Test("Graphics_CommitRegisters only writes the registers which have changed")
+{
+    u16 blendControl = *Graphics_blendingModeRegister;
+    u16 backgroundControl3 = Graphics_backgroundControlRegisters[3];
+    Graphics_CommitRegisters();
+
+    Graphics_SetBlendingMode(GraphicsBlendingMode_Alpha);
+    LostGBA_Assert(*Graphics_blendingModeRegister == blendControl, "Setting the blending mode shouldn't write the register");
+
+    // changed behind the shadow's back, so a write would put it back
+    Graphics_backgroundControlRegisters[3] = backgroundControl3 ^ 1;
+
+    Graphics_CommitRegisters();
+    LostGBA_Assert(((*Graphics_blendingModeRegister >> 6) & 3) == GraphicsBlendingMode_Alpha, "Blending mode wasn't committed");
+    LostGBA_Assert(Graphics_backgroundControlRegisters[3] == (backgroundControl3 ^ 1), "BG3CNT wasn't changed so shouldn't be written");
+    LostGBA_Assert(LostGBA_displayRegisters.dirty == 0, "Everything should be clean after committing");
+
+    Graphics_backgroundControlRegisters[3] = backgroundControl3;
+    Graphics_SetBlendingMode(blendControl >> 6);
+    Graphics_CommitRegisters();
+}
+
+#endif
\ No newline at end of file
@@ -15,7 +15,17 @@ IWRAM_CODE ARM_TARGET static void Interrupt_interruptServiceRoutineMain(void)
 {
     u32 irqs = *Interrupt_enabledInterrupts & *Interrupt_acknowledgedInterrupts;
 
-    // Do something clever with them
+    if (irqs & (1 << InterruptType_HBlank))
+    {
+        LostGBA_ScanlineEffectsHBlank();
+    }
+
+    if (irqs & (1 << InterruptType_VBlank))
+    {
+        LostGBA_FrameApplyPending();
+        // after the frame so the effects' first lines win over its scroll offsets
+        LostGBA_ScanlineEffectsVBlank();
+    }
 
     *Interrupt_acknowledgedInterrupts = irqs;
     *Interrupt_acknowledgedInterruptsBios |= irqs;
@@ -33,6 +43,9 @@ void Interrupt_EnableType(enum InterruptType interruptType)
     case InterruptType_VBlank:
         Graphics_SetVBlankInterrupt(true);
         break;
+    case InterruptType_HBlank:
+        Graphics_SetHBlankInterrupt(true);
+        break;
     default: // TODO: the rest of these
         break;
     }
@@ -40,6 +53,16 @@ void Interrupt_EnableType(enum InterruptType interruptType)
     *Interrupt_enabledInterrupts |= (1 << interruptType);
 }
 
+void Interrupt_DisableType(enum InterruptType interruptType)
+{
+    *Interrupt_enabledInterrupts &= ~(1 << interruptType);
+
+    if (interruptType == InterruptType_HBlank)
+    {
+        Graphics_SetHBlankInterrupt(false);
+    }
+}
+
 void Interrupt_Enable(void)
 {
     *Interrupt_shouldThereBeInterrupts = 1;
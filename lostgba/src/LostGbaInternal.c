@@ -1,4 +1,7 @@
 #include "LostGbaInternal.h"
+#include <lostgba/LostGbaUtil.h>
+#include <lostgba/SystemCalls.h>
+#include <lostgba/Print.h>
 
 void LostGBA_SetBits16(u16 *target, u16 value, u16 length, u16 shift)
 {
@@ -14,6 +17,21 @@ void LostGBA_SetVBits16(vu16 *target, u16 value, u16 length, u16 shift)
 
 void LostGBA_VMemCpy(volatile void *target, const void *src, int length); // defined in MemCpyFast.s
 
+void LostGBA_PanicAt(const char *fileName, int lineNumber, const char *message)
+{
+    // only used when printing is enabled
+    (void)fileName;
+    (void)lineNumber;
+    (void)message;
+
+    LostGBA_PrintLn("%s:%d, panic: %s", fileName, lineNumber, message);
+
+    while (1)
+    {
+        SystemCall_WaitForVBlank();
+    }
+}
+
 #ifdef LOSTGBA_TEST
 
 #include <lostgba/test/Test.h>
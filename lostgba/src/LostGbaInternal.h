@@ -34,6 +34,63 @@ void LostGBA_SetVBits16(vu16 *target, u16 value, u16 length, u16 shift);
  */
 void LostGBA_VMemCpy(volatile void *target, const void *src, int length);
 
+/**
+ * @brief RAM copies of the display control registers
+ *
+ * The Background and Graphics setters only change these, and Graphics_CommitRegisters() writes the dirty ones to
+ * the hardware in one go during VBlank. That saves reading the registers back for every field and stops a change
+ * halfway through a frame from tearing.
+ */
+struct LostGBA_DisplayRegisters
+{
+    u16 displayControl;       // REG_DISPCNT
+    u16 backgroundControl[4]; // REG_BG0CNT - REG_BG3CNT
+    u16 blendControl;         // REG_BLDCNT
+    u16 dirty;                // LostGBA_DisplayRegisterDirty flags
+};
+
+/** Which of LostGBA_displayRegisters have changed since the last Graphics_CommitRegisters() */
+enum LostGBA_DisplayRegisterDirty
+{
+    LostGBA_DisplayRegisterDirty_DisplayControl = 1 << 0,
+    // one bit per background starting from here
+    LostGBA_DisplayRegisterDirty_BackgroundControl0 = 1 << 1,
+    LostGBA_DisplayRegisterDirty_BlendControl = 1 << 5,
+};
+
+extern struct LostGBA_DisplayRegisters LostGBA_displayRegisters; // defined in Graphics.c
+
+/** Writes the dirty registers in shadow to the hardware. Used by Graphics_CommitRegisters() and for each Frame */
+void LostGBA_WriteDisplayRegisters(const struct LostGBA_DisplayRegisters *shadow);
+
+/**
+ * @brief Applies the frame handed over by Frame_Submit(), if there is one. Called by the VBlank interrupt
+ *
+ * This is in ROM, so it needs a long call from the interrupt service routine in IWRAM.
+ */
+__attribute__((long_call)) void LostGBA_FrameApplyPending(void);
+/**
+ * @brief Which of the two frames a module's own queue belongs to, 0 or 1
+ *
+ * While the VBlank interrupt is applying a frame this is that frame, and otherwise it is the frame being built.
+ * Modules whose queues are committed through Frame_QueueCall() keep one queue for each, so the game loop can fill
+ * in the next frame's while the last one is still waiting for VBlank.
+ */
+int LostGBA_FrameQueueIndex(void);
+
+/** Starts the scanline effects again from the top of the screen. Called by the VBlank interrupt */
+__attribute__((long_call)) void LostGBA_ScanlineEffectsVBlank(void);
+/** Writes the next line of the effects which don't use DMA. Called by the HBlank interrupt */
+IWRAM_CODE ARM_TARGET void LostGBA_ScanlineEffectsHBlank(void);
+
+#define LOSTGBA_SIN_TABLE_LENGTH 512
+/** A whole turn of sine with 12 fractional bits. Defined in Fixed.c */
+extern const s16 LostGBA_sinTable[LOSTGBA_SIN_TABLE_LENGTH];
+/** The sine of a u16 angle with 12 fractional bits */
+#define LostGBA_Sin12(angle) (LostGBA_sinTable[(u16)(angle) >> 7])
+/** The cosine of a u16 angle with 12 fractional bits */
+#define LostGBA_Cos12(angle) (LostGBA_sinTable[(u16)((angle) + 0x4000) >> 7])
+
 /**
  * @brief Returns a number with the first n bits set to 1
  */
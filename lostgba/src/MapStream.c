@@ -0,0 +1,418 @@
+#include <lostgba/MapStream.h>
+#include <lostgba/Background.h>
+#include "LostGbaInternal.h"
+
+#include <stddef.h>
+
+#define SCREEN_BLOCK_LENGTH 1024
+#define CHUNK_SIZE 32
+
+void LOSTGBA_UNSAFE(MapStream_Init)(struct MapStream *stream, int screenBaseBlock, const u16 *screenEntries, int width, int height)
+{
+    stream->screenEntries = screenEntries;
+    stream->metatileMap = NULL;
+    stream->sparseLayer = NULL;
+    stream->width = width;
+    stream->height = height;
+    stream->screenBaseBlock = screenBaseBlock;
+    stream->tileX = 0;
+    stream->tileY = 0;
+    stream->loaded = false;
+
+    for (int i = 0; i < 2; i++)
+    {
+        stream->queues[i].redraw = false;
+        stream->queues[i].length = 0;
+    }
+}
+
+void LOSTGBA_UNSAFE(MapStream_InitMetatiles)(struct MapStream *stream, int screenBaseBlock, const struct MetatileMap *metatileMap)
+{
+    LOSTGBA_UNSAFE(MapStream_Init)(stream, screenBaseBlock, NULL, metatileMap->width, metatileMap->height);
+    stream->metatileMap = metatileMap;
+}
+
+void LOSTGBA_UNSAFE(MapStream_InitSparse)(struct MapStream *stream, int screenBaseBlock, const struct SparseLayer *sparseLayer)
+{
+    LOSTGBA_UNSAFE(MapStream_Init)(stream, screenBaseBlock, NULL, sparseLayer->width, sparseLayer->height);
+    stream->sparseLayer = sparseLayer;
+}
+
+static int MapStream_wrap(int i, int n)
+{
+    return ((i % n) + n) % n;
+}
+
+// The screen entry for the map tile at x, y which can be outside the map
+static u16 MapStream_screenEntry(const struct MapStream *stream, int x, int y)
+{
+    x = MapStream_wrap(x, stream->width);
+    y = MapStream_wrap(y, stream->height);
+
+    if (stream->metatileMap != NULL)
+    {
+        return MetatileMap_ScreenEntry(stream->metatileMap, x, y);
+    }
+
+    int chunk = (y / CHUNK_SIZE) * (stream->width / CHUNK_SIZE) + x / CHUNK_SIZE;
+    return stream->screenEntries[chunk * SCREEN_BLOCK_LENGTH + (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+}
+
+// Reads the line's screen entries from the sparse layer. The cells in a chunk are sorted by position, so the part of
+// the line in each chunk it crosses is read by walking that chunk's cells once
+static void MapStream_readSparseLine(const struct MapStream *stream, struct MapStreamLine *line, int length)
+{
+    const struct SparseLayer *layer = stream->sparseLayer;
+    int chunksAcross = stream->width / CHUNK_SIZE;
+
+    // a row's cells in a chunk are next to each other, and a column's are a chunk width apart
+    u32 step = line->isRow ? 1 : CHUNK_SIZE;
+
+    for (int i = 0; i < length; i++)
+    {
+        line->screenEntries[i] = 0;
+    }
+
+    for (int i = 0; i < length;)
+    {
+        int x = MapStream_wrap(line->isRow ? line->x + i : line->x, stream->width);
+        int y = MapStream_wrap(line->isRow ? line->y : line->y + i, stream->height);
+        int chunk = (y / CHUNK_SIZE) * chunksAcross + x / CHUNK_SIZE;
+
+        int inChunk = CHUNK_SIZE - (line->isRow ? x : y) % CHUNK_SIZE;
+        if (inChunk > length - i)
+        {
+            inChunk = length - i;
+        }
+
+        u32 first = (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+        u32 last = first + (inChunk - 1) * step;
+
+        const u32 *cell = layer->cells + layer->chunkStarts[chunk];
+        const u32 *end = layer->cells + layer->chunkStarts[chunk + 1];
+
+        while (cell < end && (*cell >> 16) < first)
+        {
+            cell++;
+        }
+
+        for (; cell < end && (*cell >> 16) <= last; cell++)
+        {
+            u32 offset = (*cell >> 16) - first;
+            if (offset % step == 0)
+            {
+                line->screenEntries[i + offset / step] = *cell;
+            }
+        }
+
+        i += inChunk;
+    }
+}
+
+static void MapStream_queueRow(struct MapStream *stream, struct MapStreamQueue *queue, int y)
+{
+    struct MapStreamLine *line = &queue->lines[queue->length++];
+    line->x = stream->tileX;
+    line->y = y;
+    line->isRow = true;
+
+    if (stream->sparseLayer != NULL)
+    {
+        MapStream_readSparseLine(stream, line, MapStream_WindowWidth);
+        return;
+    }
+
+    for (int i = 0; i < MapStream_WindowWidth; i++)
+    {
+        line->screenEntries[i] = MapStream_screenEntry(stream, stream->tileX + i, y);
+    }
+}
+
+static void MapStream_queueColumn(struct MapStream *stream, struct MapStreamQueue *queue, int x)
+{
+    struct MapStreamLine *line = &queue->lines[queue->length++];
+    line->x = x;
+    line->y = stream->tileY;
+    line->isRow = false;
+
+    if (stream->sparseLayer != NULL)
+    {
+        MapStream_readSparseLine(stream, line, MapStream_WindowHeight);
+        return;
+    }
+
+    for (int i = 0; i < MapStream_WindowHeight; i++)
+    {
+        line->screenEntries[i] = MapStream_screenEntry(stream, x, stream->tileY + i);
+    }
+}
+
+// Clears the background and writes the cells of every chunk the window at tileX, tileY overlaps. That's at most 2x2
+// chunks, which fit in the 64x64 background without landing on each other
+static void MapStream_drawSparseWindow(const struct MapStream *stream, int tileX, int tileY)
+{
+    const struct SparseLayer *layer = stream->sparseLayer;
+    int chunksAcross = stream->width / CHUNK_SIZE;
+    int chunksDown = stream->height / CHUNK_SIZE;
+
+    LOSTGBA_UNSAFE(Background_FillScreenEntries)(stream->screenBaseBlock, BackgroundSize_64x64, 0);
+
+    // >> rounds towards negative infinity, so these are the chunks outside the map the window is actually over
+    for (int chunkY = tileY >> 5; chunkY <= (tileY + MapStream_WindowHeight - 1) >> 5; chunkY++)
+    {
+        for (int chunkX = tileX >> 5; chunkX <= (tileX + MapStream_WindowWidth - 1) >> 5; chunkX++)
+        {
+            int chunk = MapStream_wrap(chunkY, chunksDown) * chunksAcross + MapStream_wrap(chunkX, chunksAcross);
+
+            for (u32 i = layer->chunkStarts[chunk]; i < layer->chunkStarts[chunk + 1]; i++)
+            {
+                u32 position = layer->cells[i] >> 16;
+                int x = MapStream_wrap(chunkX * CHUNK_SIZE + position % CHUNK_SIZE, 64);
+                int y = MapStream_wrap(chunkY * CHUNK_SIZE + position / CHUNK_SIZE, 64);
+                LOSTGBA_UNSAFE(Background_SetTileEntry)(stream->screenBaseBlock, BackgroundSize_64x64, x, y, layer->cells[i]);
+            }
+        }
+    }
+}
+
+void MapStream_SetCamera(struct MapStream *stream, int x, int y)
+{
+    // >> rounds towards negative infinity so the tile is right for negative positions too
+    int tileX = x >> 3;
+    int tileY = y >> 3;
+
+    int dx = tileX - stream->tileX;
+    int dy = tileY - stream->tileY;
+
+    if (stream->loaded && dx == 0 && dy == 0)
+    {
+        return;
+    }
+
+    int newColumns = dx < 0 ? -dx : dx;
+    int newRows = dy < 0 ? -dy : dy;
+
+    stream->tileX = tileX;
+    stream->tileY = tileY;
+
+    struct MapStreamQueue *queue = &stream->queues[LostGBA_FrameQueueIndex()];
+
+    if (!stream->loaded || queue->length + newColumns + newRows > MapStream_QueueLength)
+    {
+        // redraw the whole window, which makes anything already queued for this frame out of date. The other frame's
+        // queue is written first, so it can be left alone
+        queue->length = 0;
+        stream->loaded = true;
+
+        if (stream->sparseLayer != NULL)
+        {
+            queue->redraw = true;
+            queue->redrawX = tileX;
+            queue->redrawY = tileY;
+            return;
+        }
+
+        for (int row = 0; row < MapStream_WindowHeight; row++)
+        {
+            MapStream_queueRow(stream, queue, tileY + row);
+        }
+
+        return;
+    }
+
+    // the window has already moved, so these read the new rows and columns at its new size
+    int firstColumn = dx > 0 ? tileX + MapStream_WindowWidth - dx : tileX;
+    for (int i = 0; i < newColumns; i++)
+    {
+        MapStream_queueColumn(stream, queue, firstColumn + i);
+    }
+
+    int firstRow = dy > 0 ? tileY + MapStream_WindowHeight - dy : tileY;
+    for (int i = 0; i < newRows; i++)
+    {
+        MapStream_queueRow(stream, queue, firstRow + i);
+    }
+}
+
+void MapStream_CommitQueued(struct MapStream *stream)
+{
+    // the background is 64x64 tiles and wraps around the same way the map does, so the map tile at x, y goes at
+    // x % 64, y % 64
+    struct MapStreamQueue *queue = &stream->queues[LostGBA_FrameQueueIndex()];
+
+    if (queue->redraw)
+    {
+        MapStream_drawSparseWindow(stream, queue->redrawX, queue->redrawY);
+        queue->redraw = false;
+    }
+
+    for (int i = 0; i < queue->length; i++)
+    {
+        struct MapStreamLine *line = &queue->lines[i];
+
+        if (line->isRow)
+        {
+            LOSTGBA_UNSAFE(Background_SetTileRow)(stream->screenBaseBlock, BackgroundSize_64x64, line->x, line->y, line->screenEntries, MapStream_WindowWidth);
+        }
+        else
+        {
+            LOSTGBA_UNSAFE(Background_SetTileColumn)(stream->screenBaseBlock, BackgroundSize_64x64, line->x, line->y, line->screenEntries, MapStream_WindowHeight);
+        }
+    }
+
+    queue->length = 0;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+#include <lostgba/Frame.h>
+#include <lostgba/SystemCalls.h>
+
+// 64x64 map where each screen entry is its own position, so that x + y * 64 fits in 12 bits
+static u16 MapStream_testMap[64 * 64];
+
+static void MapStream_initTestMap(void)
+{
+    for (int y = 0; y < 64; y++)
+    {
+        for (int x = 0; x < 64; x++)
+        {
+            int chunk = (y / 32) * 2 + x / 32;
+            MapStream_testMap[chunk * 1024 + (y % 32) * 32 + x % 32] = x + y * 64;
+        }
+    }
+}
+
+LostGBA_Test("MapStream_SetCamera draws the whole window the first time")
+{
+    static struct MapStream stream;
+    MapStream_initTestMap();
+    MapStream_Init(&stream, 20, MapStream_testMap, 64, 64);
+
+    MapStream_SetCamera(&stream, 8 * 40, 8 * 50);
+
+    struct MapStreamQueue *queue = &stream.queues[LostGBA_FrameQueueIndex()];
+    LostGBA_Assert(queue->length == MapStream_WindowHeight, "Should queue every row of the window");
+    LostGBA_Assert(queue->lines[0].isRow && queue->lines[0].x == 40 && queue->lines[0].y == 50, "First row is in the wrong place");
+    LostGBA_Assert(queue->lines[0].screenEntries[0] == 40 + 50 * 64, "Read the wrong screen entry");
+    LostGBA_Assert(queue->lines[0].screenEntries[30] == 6 + 50 * 64, "Should wrap around the edge of the map");
+    LostGBA_Assert(queue->lines[20].screenEntries[0] == 40 + 6 * 64, "Should wrap around the bottom of the map");
+}
+
+LostGBA_Test("MapStream_SetCamera only queues what comes into view")
+{
+    static struct MapStream stream;
+    MapStream_initTestMap();
+    MapStream_Init(&stream, 20, MapStream_testMap, 64, 64);
+
+    MapStream_SetCamera(&stream, 0, 0);
+    struct MapStreamQueue *queue = &stream.queues[LostGBA_FrameQueueIndex()];
+    queue->length = 0;
+
+    MapStream_SetCamera(&stream, 7, 7);
+    LostGBA_Assert(queue->length == 0, "Nothing new is visible within the same tile");
+
+    MapStream_SetCamera(&stream, 8, 0);
+    LostGBA_Assert(queue->length == 1, "Moving right one tile should queue one column");
+    LostGBA_Assert(!queue->lines[0].isRow && queue->lines[0].x == 32 && queue->lines[0].y == 0, "Queued the wrong column");
+    LostGBA_Assert(queue->lines[0].screenEntries[20] == 32 + 20 * 64, "Column has the wrong screen entries");
+
+    MapStream_SetCamera(&stream, 8, -1);
+    LostGBA_Assert(queue->length == 2, "Moving up one tile should queue one row");
+    LostGBA_Assert(queue->lines[1].isRow && queue->lines[1].x == 1 && queue->lines[1].y == -1, "Queued the wrong row");
+    LostGBA_Assert(queue->lines[1].screenEntries[0] == 1 + 63 * 64, "Row above the map should come from the bottom");
+
+    MapStream_SetCamera(&stream, 8 * 100, 0);
+    LostGBA_Assert(queue->length == MapStream_WindowHeight && queue->lines[0].isRow, "A big jump should redraw everything");
+}
+
+LostGBA_Test("MapStream_SetCamera queues the next frame's lines while the last frame waits for VBlank")
+{
+    static struct MapStream stream;
+    MapStream_initTestMap();
+    MapStream_Init(&stream, 20, MapStream_testMap, 64, 64);
+
+    MapStream_SetCamera(&stream, 0, 0);
+    struct MapStreamQueue *submitted = &stream.queues[LostGBA_FrameQueueIndex()];
+    Frame_Submit();
+
+    MapStream_SetCamera(&stream, 8, 0);
+    struct MapStreamQueue *building = &stream.queues[LostGBA_FrameQueueIndex()];
+    LostGBA_Assert(building != submitted, "The next frame should have its own queue");
+    LostGBA_Assert(building->length == 1, "Moving right one tile should queue one column");
+    LostGBA_Assert(submitted->length == MapStream_WindowHeight, "The submitted frame's lines shouldn't change");
+
+    SystemCall_WaitForVBlank();
+}
+
+LostGBA_Test("MapStream_InitMetatiles expands metatiles as they come into view")
+{
+    // 32x32 tiles of metatile 0 apart from metatile 1 at 2, 3
+    static u16 mapData[16 * 16];
+    static const u16 metatiles[] = {1, 1, 1, 1, 10, 11, 12, 13};
+    static const u32 attributes[] = {0, 0};
+    mapData[3 * 16 + 2] = 1;
+
+    struct MetatileMap map = {.map = mapData, .metatiles = metatiles, .attributes = attributes, .width = 32, .height = 32};
+    static struct MapStream stream;
+    MapStream_InitMetatiles(&stream, 20, &map);
+
+    MapStream_SetCamera(&stream, 0, 0);
+    struct MapStreamQueue *queue = &stream.queues[LostGBA_FrameQueueIndex()];
+    LostGBA_Assert(queue->lines[6].screenEntries[4] == 10 && queue->lines[6].screenEntries[5] == 11, "Wrong top of the metatile");
+    LostGBA_Assert(queue->lines[7].screenEntries[4] == 12 && queue->lines[7].screenEntries[5] == 13, "Wrong bottom of the metatile");
+    LostGBA_Assert(queue->lines[7].screenEntries[6] == 1, "Wrong screen entry next to the metatile");
+}
+
+// 64x64 layer with cells at 1, 1 and 8, 1 and 8, 20 in the top left chunk and 35, 1 in the top right one
+static const u32 MapStream_testChunkStarts[] = {0, 3, 4, 4, 4};
+static const u32 MapStream_testCells[] = {(33 << 16) | 5, (40 << 16) | 6, (648 << 16) | 8, (35 << 16) | 9};
+
+LostGBA_Test("MapStream_InitSparse clears the background and only writes the cells in view")
+{
+    struct SparseLayer layer = {.chunkStarts = MapStream_testChunkStarts, .cells = MapStream_testCells, .width = 64, .height = 64};
+    static struct MapStream stream;
+    MapStream_InitSparse(&stream, 28, &layer);
+
+    MapStream_SetCamera(&stream, 0, 0);
+    struct MapStreamQueue *queue = &stream.queues[LostGBA_FrameQueueIndex()];
+    LostGBA_Assert(queue->redraw && queue->length == 0, "Drawing the whole window shouldn't queue any lines");
+
+    Background_FillScreenEntries(28, BackgroundSize_64x64, 0xffff);
+    MapStream_CommitQueued(&stream);
+
+    vu16 *screenEntries = (vu16 *)0x06000000 + 28 * SCREEN_BLOCK_LENGTH;
+    LostGBA_Assert(screenEntries[1 * 32 + 1] == 5 && screenEntries[20 * 32 + 8] == 8, "Should write the cells in view");
+    LostGBA_Assert(screenEntries[1 * 32 + 2] == 0, "Empty cells should be cleared");
+    LostGBA_Assert(screenEntries[SCREEN_BLOCK_LENGTH + 1 * 32 + 3] == 0, "Chunks out of view shouldn't be written");
+    LostGBA_Assert(!queue->redraw, "The window should only be drawn once");
+}
+
+LostGBA_Test("MapStream_InitSparse reads streamed lines from the chunks they cross")
+{
+    struct SparseLayer layer = {.chunkStarts = MapStream_testChunkStarts, .cells = MapStream_testCells, .width = 64, .height = 64};
+    static struct MapStream stream;
+    MapStream_InitSparse(&stream, 28, &layer);
+
+    MapStream_SetCamera(&stream, 8 * 9, 8 * 2);
+    struct MapStreamQueue *queue = &stream.queues[LostGBA_FrameQueueIndex()];
+    queue->redraw = false;
+
+    MapStream_SetCamera(&stream, 8 * 8, 8 * 1);
+    LostGBA_Assert(queue->length == 2, "Moving up and left should queue a column and a row");
+    LostGBA_Assert(queue->lines[0].screenEntries[0] == 6 && queue->lines[0].screenEntries[19] == 8, "Column has the wrong cells");
+    LostGBA_Assert(queue->lines[1].screenEntries[0] == 6 && queue->lines[1].screenEntries[27] == 9, "Row has the wrong cells");
+
+    for (int i = 0; i < MapStream_WindowHeight; i++)
+    {
+        LostGBA_Assert(queue->lines[0].screenEntries[i] == SparseLayer_ScreenEntry(&layer, 8, 1 + i), "Column doesn't match the layer");
+    }
+
+    for (int i = 0; i < MapStream_WindowWidth; i++)
+    {
+        LostGBA_Assert(queue->lines[1].screenEntries[i] == SparseLayer_ScreenEntry(&layer, 8 + i, 1), "Row doesn't match the layer");
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include <lostgba/Metatiles.h>
+#include "LostGbaInternal.h"
+
+static int MetatileMap_metatile(const struct MetatileMap *map, int metatileX, int metatileY)
+{
+    return map->map[metatileY * (map->width / 2) + metatileX];
+}
+
+u16 MetatileMap_ScreenEntry(const struct MetatileMap *map, int x, int y)
+{
+    int metatile = MetatileMap_metatile(map, x / 2, y / 2);
+    return map->metatiles[metatile * 4 + (y % 2) * 2 + x % 2];
+}
+
+u8 MetatileMap_TileAttributes(const struct MetatileMap *map, int x, int y)
+{
+    int metatile = MetatileMap_metatile(map, x / 2, y / 2);
+    return map->attributes[metatile] >> (((y % 2) * 2 + x % 2) * 8);
+}
+
+bool MetatileMap_HasAttribute(const struct MetatileMap *map, int metatileX, int metatileY, enum TileAttribute attribute)
+{
+    // the attribute in each of the 4 bytes
+    u32 mask = attribute * 0x01010101u;
+    return (map->attributes[MetatileMap_metatile(map, metatileX, metatileY)] & mask) != 0;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+LostGBA_Test("MetatileMap expands metatiles into screen entries and attributes")
+{
+    // 4x2 tiles, a plain metatile then a tree with a solid bottom right tile
+    static const u16 mapData[] = {0, 1};
+    static const u16 metatiles[] = {1, 1, 1, 1, 10, 11, 12, 13};
+    static const u32 attributes[] = {0, TileAttribute_Solid << 24};
+
+    struct MetatileMap map = {.map = mapData, .metatiles = metatiles, .attributes = attributes, .width = 4, .height = 2};
+
+    LostGBA_Assert(MetatileMap_ScreenEntry(&map, 1, 1) == 1, "Wrong screen entry for the first metatile");
+    LostGBA_Assert(MetatileMap_ScreenEntry(&map, 2, 0) == 10, "Wrong top left screen entry");
+    LostGBA_Assert(MetatileMap_ScreenEntry(&map, 3, 0) == 11, "Wrong top right screen entry");
+    LostGBA_Assert(MetatileMap_ScreenEntry(&map, 2, 1) == 12, "Wrong bottom left screen entry");
+
+    LostGBA_Assert(MetatileMap_TileAttributes(&map, 3, 1) == TileAttribute_Solid, "Bottom right should be solid");
+    LostGBA_Assert(MetatileMap_TileAttributes(&map, 2, 1) == 0, "Bottom left shouldn't be solid");
+
+    LostGBA_Assert(MetatileMap_HasAttribute(&map, 1, 0, TileAttribute_Solid), "The tree should be solid");
+    LostGBA_Assert(!MetatileMap_HasAttribute(&map, 0, 0, TileAttribute_Solid), "The plain metatile shouldn't be solid");
+    LostGBA_Assert(!MetatileMap_HasAttribute(&map, 1, 0, TileAttribute_Water), "The tree isn't water");
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include <lostgba/ScanlineEffect.h>
+#include <lostgba/Dma.h>
+#include <lostgba/Interrupt.h>
+#include "LostGbaInternal.h"
+
+#include <stddef.h>
+
+static vu16 *ScanlineEffect_verticalCountRegister = (vu16 *)0x04000006; // REG_VCOUNT
+
+#define DMA_CHANNELS 3
+
+static const struct
+{
+    uintptr_t address;
+    int entrySize;
+} ScanlineEffect_targets[] = {
+    [ScanlineEffectTarget_BackgroundScroll0] = {0x04000010, sizeof(u32)}, // REG_BG0HOFS
+    [ScanlineEffectTarget_BackgroundScroll1] = {0x04000014, sizeof(u32)}, // REG_BG1HOFS
+    [ScanlineEffectTarget_BackgroundScroll2] = {0x04000018, sizeof(u32)}, // REG_BG2HOFS
+    [ScanlineEffectTarget_BackgroundScroll3] = {0x0400001c, sizeof(u32)}, // REG_BG3HOFS
+    [ScanlineEffectTarget_BlendAlpha] = {0x04000052, sizeof(u16)},        // REG_BLDALPHA
+    [ScanlineEffectTarget_BlendBrightness] = {0x04000054, sizeof(u16)},   // REG_BLDY
+    [ScanlineEffectTarget_Window0Horizontal] = {0x04000040, sizeof(u16)}, // REG_WIN0H
+    [ScanlineEffectTarget_Window1Horizontal] = {0x04000042, sizeof(u16)}, // REG_WIN1H
+    [ScanlineEffectTarget_BackdropColour] = {0x05000000, sizeof(u16)},    // background palette colour 0
+};
+
+// Slots are only ever set or cleared with a single store, so the interrupts never see an effect half added
+static struct ScanlineEffect *volatile ScanlineEffect_effects[ScanlineEffect_MaxEffects];
+
+static bool ScanlineEffect_isChannelUsed(int channel)
+{
+    for (int i = 0; i < ScanlineEffect_MaxEffects; i++)
+    {
+        if (ScanlineEffect_effects[i] != NULL && ScanlineEffect_effects[i]->channel == channel)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool ScanlineEffect_anyUseCpu(void)
+{
+    return ScanlineEffect_isChannelUsed(-1);
+}
+
+static bool ScanlineEffect_start(struct ScanlineEffect *effect, volatile void *target, int entrySize, enum ScanlineEffectMode mode, void *front, void *back)
+{
+    int slot = 0;
+    while (slot < ScanlineEffect_MaxEffects && ScanlineEffect_effects[slot] != NULL)
+    {
+        slot++;
+    }
+
+    if (slot == ScanlineEffect_MaxEffects)
+    {
+        return false;
+    }
+
+    effect->tables[0] = front;
+    effect->tables[1] = back;
+    effect->target = target;
+    effect->entrySize = entrySize;
+    effect->front = 0;
+    effect->shown = false;
+    effect->swapQueued = false;
+
+    effect->channel = -1;
+    for (int channel = 0; mode == ScanlineEffectMode_Dma && channel < DMA_CHANNELS; channel++)
+    {
+        if (!ScanlineEffect_isChannelUsed(channel))
+        {
+            effect->channel = channel;
+            break;
+        }
+    }
+
+    ScanlineEffect_effects[slot] = effect;
+
+    if (effect->channel == -1)
+    {
+        Interrupt_EnableType(InterruptType_HBlank);
+    }
+
+    return true;
+}
+
+bool ScanlineEffect_Start(struct ScanlineEffect *effect, enum ScanlineEffectTarget target, enum ScanlineEffectMode mode, u32 tables[2][ScanlineEffect_TableLength])
+{
+    volatile void *address = (volatile void *)ScanlineEffect_targets[target].address;
+    return ScanlineEffect_start(effect, address, ScanlineEffect_targets[target].entrySize, mode, tables[0], tables[1]);
+}
+
+bool ScanlineEffect_StartAffine(struct ScanlineEffect *effect, enum BackgroundNumber backgroundNumber, enum ScanlineEffectMode mode,
+                                struct AffineBackgroundParameters tables[2][ScanlineEffect_TableLength])
+{
+    volatile void *address = AffineBackground_Registers(backgroundNumber);
+    return ScanlineEffect_start(effect, address, sizeof(struct AffineBackgroundParameters), mode, tables[0], tables[1]);
+}
+
+void ScanlineEffect_Stop(struct ScanlineEffect *effect)
+{
+    for (int i = 0; i < ScanlineEffect_MaxEffects; i++)
+    {
+        if (ScanlineEffect_effects[i] == effect)
+        {
+            ScanlineEffect_effects[i] = NULL;
+        }
+    }
+
+    if (effect->channel != -1)
+    {
+        Dma_Stop(effect->channel);
+    }
+    else if (!ScanlineEffect_anyUseCpu())
+    {
+        Interrupt_DisableType(InterruptType_HBlank);
+    }
+}
+
+u16 *ScanlineEffect_BackTable16(struct ScanlineEffect *effect)
+{
+    return (u16 *)effect->tables[effect->front ^ 1];
+}
+
+u32 *ScanlineEffect_BackTable32(struct ScanlineEffect *effect)
+{
+    return effect->tables[effect->front ^ 1];
+}
+
+struct AffineBackgroundParameters *ScanlineEffect_BackTableAffine(struct ScanlineEffect *effect)
+{
+    return effect->tables[effect->front ^ 1];
+}
+
+void ScanlineEffect_Swap(struct ScanlineEffect *effect)
+{
+    effect->swapQueued = true;
+}
+
+// Inlined so that the HBlank interrupt doesn't have to call back out of IWRAM
+static inline void ScanlineEffect_writeEntry(const struct ScanlineEffect *effect, int line)
+{
+    const void *table = effect->tables[effect->front];
+
+    if (effect->entrySize == sizeof(u16))
+    {
+        *(vu16 *)effect->target = ((const u16 *)table)[line];
+        return;
+    }
+
+    int words = effect->entrySize / sizeof(u32);
+    const u32 *entry = (const u32 *)table + line * words;
+    for (int i = 0; i < words; i++)
+    {
+        ((vu32 *)effect->target)[i] = entry[i];
+    }
+}
+
+void LostGBA_ScanlineEffectsVBlank(void)
+{
+    for (int i = 0; i < ScanlineEffect_MaxEffects; i++)
+    {
+        struct ScanlineEffect *effect = ScanlineEffect_effects[i];
+        if (effect == NULL)
+        {
+            continue;
+        }
+
+        if (effect->swapQueued)
+        {
+            effect->front ^= 1;
+            effect->shown = true;
+            effect->swapQueued = false;
+        }
+
+        if (!effect->shown)
+        {
+            continue;
+        }
+
+        // the first line is drawn before there has been an HBlank, so it is written now
+        ScanlineEffect_writeEntry(effect, 0);
+
+        if (effect->channel != -1)
+        {
+            const u8 *secondLine = (const u8 *)effect->tables[effect->front] + effect->entrySize;
+            Dma_StartHBlankCopies(effect->channel, effect->target, secondLine, effect->entrySize / sizeof(u16));
+        }
+    }
+}
+
+IWRAM_CODE ARM_TARGET void LostGBA_ScanlineEffectsHBlank(void)
+{
+    // HBlank happens on the lines in VBlank too, and after the last line there is nothing left to draw
+    int nextLine = *ScanlineEffect_verticalCountRegister + 1;
+    if (nextLine >= Graphics_ScreenHeight)
+    {
+        return;
+    }
+
+    for (int i = 0; i < ScanlineEffect_MaxEffects; i++)
+    {
+        struct ScanlineEffect *effect = ScanlineEffect_effects[i];
+        if (effect == NULL || effect->channel != -1 || !effect->shown)
+        {
+            continue;
+        }
+
+        ScanlineEffect_writeEntry(effect, nextLine);
+    }
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+#include <lostgba/SystemCalls.h>
+
+static vu16 *ScanlineEffect_testBackdrop = (vu16 *)0x05000000;
+
+// Fills the backdrop table with the line number and checks the colour part way down the screen
+static void ScanlineEffect_testBackdropFollowsTable(const char *LostGBA_TestName, enum ScanlineEffectMode mode)
+{
+    static struct ScanlineEffect effect;
+    static u32 tables[2][ScanlineEffect_TableLength];
+    u16 backdrop = *ScanlineEffect_testBackdrop;
+
+    LostGBA_Assert(ScanlineEffect_Start(&effect, ScanlineEffectTarget_BackdropColour, mode, tables), "Should be room for the effect");
+    LostGBA_Assert(mode == ScanlineEffectMode_Cpu ? effect.channel == -1 : effect.channel == 0, "Wrong DMA channel");
+
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(*ScanlineEffect_testBackdrop == backdrop, "Nothing should be written before the first swap");
+
+    u16 *table = ScanlineEffect_BackTable16(&effect);
+    for (int line = 0; line < Graphics_ScreenHeight; line++)
+    {
+        table[line] = line + 1;
+    }
+    ScanlineEffect_Swap(&effect);
+
+    SystemCall_WaitForVBlank();
+    LostGBA_Assert(*ScanlineEffect_testBackdrop == 1, "The first line should be written in VBlank");
+
+    while (*ScanlineEffect_verticalCountRegister != 80)
+    {
+    }
+    // the line might have finished between reading the register and the colour
+    int colour = *ScanlineEffect_testBackdrop;
+    LostGBA_Assert(colour == 81 || colour == 82, "The colour should follow the table down the screen");
+
+    ScanlineEffect_Stop(&effect);
+    *ScanlineEffect_testBackdrop = backdrop;
+}
+
+LostGBA_Test("ScanlineEffect with DMA changes the register on every line")
+{
+    ScanlineEffect_testBackdropFollowsTable(LostGBA_TestName, ScanlineEffectMode_Dma);
+}
+
+LostGBA_Test("ScanlineEffect with the HBlank interrupt changes the register on every line")
+{
+    ScanlineEffect_testBackdropFollowsTable(LostGBA_TestName, ScanlineEffectMode_Cpu);
+}
+
+#endif
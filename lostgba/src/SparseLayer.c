@@ -0,0 +1,98 @@
+#include <lostgba/SparseLayer.h>
+#include "LostGbaInternal.h"
+
+#define CHUNK_SIZE 32
+
+u16 SparseLayer_ScreenEntry(const struct SparseLayer *layer, int x, int y)
+{
+    int chunk = (y / CHUNK_SIZE) * (layer->width / CHUNK_SIZE) + x / CHUNK_SIZE;
+    u32 position = (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+
+    // binary search the chunk's cells, which are sorted by position
+    int low = layer->chunkStarts[chunk];
+    int high = layer->chunkStarts[chunk + 1];
+
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        u32 cellPosition = layer->cells[middle] >> 16;
+
+        if (cellPosition == position)
+        {
+            return layer->cells[middle];
+        }
+
+        if (cellPosition < position)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return 0;
+}
+
+static int SparseLayer_wrap(int i, int n)
+{
+    return ((i % n) + n) % n;
+}
+
+bool SparseLayer_IsAreaEmpty(const struct SparseLayer *layer, int x, int y, int width, int height)
+{
+    int chunksAcross = layer->width / CHUNK_SIZE;
+    int chunksDown = layer->height / CHUNK_SIZE;
+
+    // the chunks overlapping the area, which can wrap around the edges
+    int firstChunkX = SparseLayer_wrap(x, layer->width) / CHUNK_SIZE;
+    int firstChunkY = SparseLayer_wrap(y, layer->height) / CHUNK_SIZE;
+    int nChunksX = (SparseLayer_wrap(x, CHUNK_SIZE) + width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int nChunksY = (SparseLayer_wrap(y, CHUNK_SIZE) + height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    for (int i = 0; i < nChunksY && i < chunksDown; i++)
+    {
+        for (int j = 0; j < nChunksX && j < chunksAcross; j++)
+        {
+            int chunk = ((firstChunkY + i) % chunksDown) * chunksAcross + (firstChunkX + j) % chunksAcross;
+            if (layer->chunkStarts[chunk] != layer->chunkStarts[chunk + 1])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+// 64x64 with two cells in the top left chunk and one in the bottom right
+static const u32 SparseLayer_testChunkStarts[] = {0, 2, 2, 2, 3};
+static const u32 SparseLayer_testCells[] = {(33 << 16) | 5, (40 << 16) | 6, (1023 << 16) | 7};
+
+LostGBA_Test("SparseLayer_ScreenEntry finds cells and returns 0 for empty ones")
+{
+    struct SparseLayer layer = {.chunkStarts = SparseLayer_testChunkStarts, .cells = SparseLayer_testCells, .width = 64, .height = 64};
+
+    LostGBA_Assert(SparseLayer_ScreenEntry(&layer, 1, 1) == 5, "Should find the first cell");
+    LostGBA_Assert(SparseLayer_ScreenEntry(&layer, 8, 1) == 6, "Should find the second cell");
+    LostGBA_Assert(SparseLayer_ScreenEntry(&layer, 63, 63) == 7, "Should find the cell in the last chunk");
+    LostGBA_Assert(SparseLayer_ScreenEntry(&layer, 2, 1) == 0, "Empty cells should be 0");
+    LostGBA_Assert(SparseLayer_ScreenEntry(&layer, 33, 1) == 0, "Cells in an empty chunk should be 0");
+}
+
+LostGBA_Test("SparseLayer_IsAreaEmpty only looks at the chunks in the area")
+{
+    struct SparseLayer layer = {.chunkStarts = SparseLayer_testChunkStarts, .cells = SparseLayer_testCells, .width = 64, .height = 64};
+
+    LostGBA_Assert(SparseLayer_IsAreaEmpty(&layer, 32, 0, 30, 20), "The top right chunk is empty");
+    LostGBA_Assert(!SparseLayer_IsAreaEmpty(&layer, 20, 0, 30, 20), "Overlaps the top left chunk");
+    LostGBA_Assert(!SparseLayer_IsAreaEmpty(&layer, 40, 20, 30, 20), "Wraps around into the top left chunk");
+    LostGBA_Assert(!SparseLayer_IsAreaEmpty(&layer, -10, -10, 5, 5), "Negative positions wrap to the bottom right chunk");
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include <lostgba/SpriteTiles.h>
+#include <lostgba/Dma.h>
+#include "LostGbaInternal.h"
+
+#define SPRITE_TILE_MEMORY_LOCATION ((vu32 *)0x06010000)
+#define WORDS_PER_TILE (32 / sizeof(u32))
+
+// one bit per tile, set if it has been allocated
+static u32 SpriteTiles_allocated[SpriteTiles_Length / 32];
+
+static bool SpriteTiles_isAllocated(int tile)
+{
+    return (SpriteTiles_allocated[tile / 32] >> (tile % 32)) & 1;
+}
+
+static void SpriteTiles_setAllocated(int firstTile, int nTiles, bool allocated)
+{
+    for (int tile = firstTile; tile < firstTile + nTiles; tile++)
+    {
+        if (allocated)
+        {
+            SpriteTiles_allocated[tile / 32] |= 1u << (tile % 32);
+        }
+        else
+        {
+            SpriteTiles_allocated[tile / 32] &= ~(1u << (tile % 32));
+        }
+    }
+}
+
+int SpriteTiles_Allocate(int nTiles)
+{
+    if (nTiles <= 0)
+    {
+        return -1;
+    }
+
+    // first fit
+    int gapStart = 0;
+    for (int tile = 0; tile < SpriteTiles_Length; tile++)
+    {
+        if (SpriteTiles_isAllocated(tile))
+        {
+            gapStart = tile + 1;
+        }
+        else if (tile - gapStart + 1 == nTiles)
+        {
+            SpriteTiles_setAllocated(gapStart, nTiles, true);
+            return gapStart;
+        }
+    }
+
+    return -1;
+}
+
+void SpriteTiles_Free(int firstTile, int nTiles)
+{
+    SpriteTiles_setAllocated(firstTile, nTiles, false);
+}
+
+struct SpriteTiles_queuedCopy
+{
+    const u32 *source;
+    int firstTile;
+    int words;
+};
+
+// one queue per Frame, see LostGBA_FrameQueueIndex()
+static struct SpriteTiles_queuedCopy SpriteTiles_queues[2][SpriteTiles_QueueLength];
+static int SpriteTiles_queueLengths[2];
+
+bool SpriteTiles_QueueCopy(int firstTile, const u32 *tileData, int length)
+{
+    int queue = LostGBA_FrameQueueIndex();
+    if (SpriteTiles_queueLengths[queue] == SpriteTiles_QueueLength)
+    {
+        return false;
+    }
+
+    SpriteTiles_queues[queue][SpriteTiles_queueLengths[queue]++] = (struct SpriteTiles_queuedCopy){
+        .source = tileData,
+        .firstTile = firstTile,
+        .words = length / sizeof(u32)};
+
+    return true;
+}
+
+void SpriteTiles_CommitQueued(void)
+{
+    int queue = LostGBA_FrameQueueIndex();
+    for (int i = 0; i < SpriteTiles_queueLengths[queue]; i++)
+    {
+        struct SpriteTiles_queuedCopy *copy = &SpriteTiles_queues[queue][i];
+        Dma_Copy32(SPRITE_TILE_MEMORY_LOCATION + copy->firstTile * WORDS_PER_TILE, copy->source, copy->words);
+    }
+
+    SpriteTiles_queueLengths[queue] = 0;
+}
+
+bool SpriteTileStream_Init(struct SpriteTileStream *stream, const u32 *tileData, int frameLength)
+{
+    int slot = SpriteTiles_Allocate(frameLength / 32);
+    if (slot < 0)
+    {
+        return false;
+    }
+
+    stream->tileData = tileData;
+    stream->frameLength = frameLength;
+    stream->slot = slot;
+    stream->currentFrameTile = -1;
+
+    return true;
+}
+
+void SpriteTileStream_SetFrame(struct SpriteTileStream *stream, int frameTile)
+{
+    if (frameTile == stream->currentFrameTile)
+    {
+        return;
+    }
+
+    if (SpriteTiles_QueueCopy(stream->slot, stream->tileData + frameTile * WORDS_PER_TILE, stream->frameLength))
+    {
+        stream->currentFrameTile = frameTile;
+    }
+}
+
+void SpriteTileStream_Free(struct SpriteTileStream *stream)
+{
+    SpriteTiles_Free(stream->slot, stream->frameLength / 32);
+    stream->slot = -1;
+}
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+LostGBA_Test("SpriteTiles_Allocate reuses freed gaps which are big enough")
+{
+    int first = SpriteTiles_Allocate(4);
+    int second = SpriteTiles_Allocate(8);
+    int third = SpriteTiles_Allocate(4);
+
+    LostGBA_Assert(first >= 0 && second == first + 4 && third == second + 8, "Allocations should be consecutive");
+
+    SpriteTiles_Free(second, 8);
+
+    LostGBA_Assert(SpriteTiles_Allocate(16) > third, "A gap too small shouldn't be used");
+    SpriteTiles_Free(third + 4, 16);
+
+    int reused = SpriteTiles_Allocate(6);
+    LostGBA_Assert(reused == second, "Should have reused the freed gap");
+
+    SpriteTiles_Free(first, 4);
+    SpriteTiles_Free(reused, 6);
+    SpriteTiles_Free(third, 4);
+}
+
+LostGBA_Test("SpriteTiles_Allocate fails when sprite tile memory is full")
+{
+    LostGBA_Assert(SpriteTiles_Allocate(SpriteTiles_Length + 1) == -1, "Can't allocate more than all the tiles");
+    LostGBA_Assert(SpriteTiles_Allocate(0) == -1, "Can't allocate no tiles");
+}
+
+LostGBA_Test("SpriteTileStream_SetFrame only queues frames which change")
+{
+    static const u32 tileData[3 * 4 * WORDS_PER_TILE];
+    struct SpriteTileStream stream;
+
+    LostGBA_Assert(SpriteTileStream_Init(&stream, tileData, 4 * 32), "Failed to allocate a slot");
+    int queue = LostGBA_FrameQueueIndex();
+
+    SpriteTileStream_SetFrame(&stream, 4);
+    SpriteTileStream_SetFrame(&stream, 4);
+    LostGBA_Assert(SpriteTiles_queueLengths[queue] == 1, "Setting the same frame twice should only queue it once");
+    LostGBA_Assert(SpriteTiles_queues[queue][0].source == tileData + 4 * WORDS_PER_TILE, "Queued the wrong frame");
+    LostGBA_Assert(SpriteTiles_queues[queue][0].words == 4 * WORDS_PER_TILE, "Queued the wrong length");
+
+    SpriteTileStream_SetFrame(&stream, 8);
+    LostGBA_Assert(SpriteTiles_queueLengths[queue] == 2, "A new frame should be queued");
+
+    SpriteTiles_CommitQueued();
+    LostGBA_Assert(SpriteTiles_queueLengths[queue] == 0, "Committing should empty the queue");
+
+    SpriteTileStream_Free(&stream);
+}
+
+#endif
@@ -0,0 +1,20 @@
+.include "AsmMacros.i"
+
+@ void SystemCall_LZ77UnCompVram(const void *source, volatile void *target)
+@ Written in assembly so the arguments are guaranteed to still be in r0 and r1 for the system call
+@
+@ r0 = source
+@ r1 = target
+LostGBA_ThumbFunc SystemCall_LZ77UnCompVram
+    swi 0x12
+    bx lr
+LostGBA_EndThumbFunc SystemCall_LZ77UnCompVram
+
+@ void SystemCall_RLUnCompVram(const void *source, volatile void *target)
+@
+@ r0 = source
+@ r1 = target
+LostGBA_ThumbFunc SystemCall_RLUnCompVram
+    swi 0x15
+    bx lr
+LostGBA_EndThumbFunc SystemCall_RLUnCompVram
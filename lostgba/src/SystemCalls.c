@@ -20,3 +20,45 @@ void SystemCall_WaitForVBlank(void)
 {
     swi_call(0x05);
 }
+
+#ifdef LOSTGBA_TEST
+
+#include <lostgba/test/Test.h>
+
+// 32 bytes of 0, 1, ..., 7 repeating: 8 literals followed by copies of length 18 and 6 from 8 bytes back
+static const u8 LZ77TestData[] LOSTGBA_ALIGN(4) = {
+    0x10, 0x20, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0xc0, 0xf0, 0x07, 0x30, 0x07,
+    0x00, 0x00};
+
+// 20 bytes of 0xaa followed by 1, 2, ..., 12
+static const u8 RLTestData[] LOSTGBA_ALIGN(4) = {
+    0x30, 0x20, 0x00, 0x00,
+    0x91, 0xaa,
+    0x0b, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c,
+    0x00};
+
+LostGBA_Test("LZ77UnCompVram decompresses literals and back references")
+{
+    u8 target[32] LOSTGBA_ALIGN(4) = {0};
+    SystemCall_LZ77UnCompVram(LZ77TestData, target);
+
+    for (int i = 0; i < 32; i++)
+    {
+        LostGBA_Assert(target[i] == i % 8, "Decompressed data doesn't match");
+    }
+}
+
+LostGBA_Test("RLUnCompVram decompresses runs and literals")
+{
+    u8 target[32] LOSTGBA_ALIGN(4) = {0};
+    SystemCall_RLUnCompVram(RLTestData, target);
+
+    for (int i = 0; i < 32; i++)
+    {
+        LostGBA_Assert(target[i] == (i < 20 ? 0xaa : i - 19), "Decompressed data doesn't match");
+    }
+}
+
+#endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <lostgba/TileMap.h>
 #include "LostGbaInternal.h"
+#include <lostgba/SystemCalls.h>
 
 #include <string.h>
 
@@ -11,7 +12,29 @@ void TileMap_CopyToSpritePalette(const u16 paletteData[TileMap_PaletteLength])
 }
 
 #define SPRITE_CHARBLOCK_BASE ((vu16 *)0x06010000)
-#define CHARBLOCK_SIZE 0x4000
+// in halfwords since the base addresses are vu16 pointers
+#define CHARBLOCK_SIZE (0x4000 / sizeof(u16))
+
+#define COMPRESSION_TYPE_MASK 0xf0
+#define COMPRESSION_TYPE_LZ77 0x10
+#define COMPRESSION_TYPE_RL 0x30
+
+// The BIOS header's first byte says which compression was used
+static void TileMap_decompress(vu16 *target, const u32 *compressedData)
+{
+    switch (compressedData[0] & COMPRESSION_TYPE_MASK)
+    {
+    case COMPRESSION_TYPE_LZ77:
+        SystemCall_LZ77UnCompVram(compressedData, target);
+        break;
+    case COMPRESSION_TYPE_RL:
+        SystemCall_RLUnCompVram(compressedData, target);
+        break;
+    default:
+        // most likely uncompressed tiles, which need TileMap_CopyToBackgroundTiles() etc. instead
+        LostGBA_Panic("Tile data isn't LZ77 or RLE compressed");
+    }
+}
 
 void LOSTGBA_UNSAFE(TileMap_CopyToSpriteTiles)(int tileNumber, const u32 *tileData, int length)
 {
@@ -31,3 +54,13 @@ void LOSTGBA_UNSAFE(TileMap_CopyToBackgroundTiles)(int tileNumber, const u32 *ti
 {
     LostGBA_VMemCpy(TILE_MEMORY_LOCATION + tileNumber * CHARBLOCK_SIZE, tileData, length);
 }
+
+void LOSTGBA_UNSAFE(TileMap_DecompressToSpriteTiles)(int tileNumber, const u32 *compressedData)
+{
+    TileMap_decompress(SPRITE_CHARBLOCK_BASE + tileNumber * CHARBLOCK_SIZE, compressedData);
+}
+
+void LOSTGBA_UNSAFE(TileMap_DecompressToBackgroundTiles)(int tileNumber, const u32 *compressedData)
+{
+    TileMap_decompress(TILE_MEMORY_LOCATION + tileNumber * CHARBLOCK_SIZE, compressedData);
+}
\ No newline at end of file
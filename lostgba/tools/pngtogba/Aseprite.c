@@ -0,0 +1,956 @@
+#define _GNU_SOURCE // cause stdio.h to include asprintf
+
+#include "Aseprite.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zlib.h>
+
+#define ASEPRITE_HEADER_SIZE 128
+#define ASEPRITE_MAGIC 0xa5e0
+#define ASEPRITE_FRAME_MAGIC 0xf1fa
+#define ASEPRITE_FRAME_HEADER_SIZE 16
+
+#define ASEPRITE_CHUNK_OLD_PALETTE 0x0004
+#define ASEPRITE_CHUNK_LAYER 0x2004
+#define ASEPRITE_CHUNK_CEL 0x2005
+#define ASEPRITE_CHUNK_TAGS 0x2018
+#define ASEPRITE_CHUNK_PALETTE 0x2019
+
+#define ASEPRITE_LAYER_VISIBLE 1
+#define ASEPRITE_LAYER_BACKGROUND 8
+#define ASEPRITE_LAYER_REFERENCE 64
+
+#define ASEPRITE_CEL_RAW 0
+#define ASEPRITE_CEL_LINKED 1
+#define ASEPRITE_CEL_COMPRESSED 2
+
+// header flag saying the layer opacity field is set
+#define ASEPRITE_FLAG_LAYER_OPACITY 1
+
+#define ASEPRITE_MAX_CHILD_LEVEL 64
+
+struct AsepriteLayer
+{
+    bool visible;
+    bool background;
+    int opacity;
+};
+
+struct AsepriteCel
+{
+    int layer;
+    int x;
+    int y;
+    int opacity;
+    int zIndex;
+    int type;
+    int width;
+    int height;
+
+    // points into the file, zlib compressed if type is ASEPRITE_CEL_COMPRESSED
+    const uint8_t *data;
+    size_t dataLength;
+};
+
+struct AsepriteFrame
+{
+    int duration;
+    int nCels;
+    struct AsepriteCel *cels;
+};
+
+struct AsepriteTag
+{
+    char *name;
+    int from;
+    int to;
+};
+
+struct Aseprite
+{
+    uint8_t *file;
+
+    int width;
+    int height;
+    // 32 for RGBA, 16 for grayscale with alpha, 8 for indexed
+    int depth;
+    int transparentIndex;
+    uint8_t palette[256][4];
+
+    int nLayers;
+    struct AsepriteLayer *layers;
+
+    int nFrames;
+    struct AsepriteFrame *frames;
+
+    int nTags;
+    struct AsepriteTag *tags;
+
+    char *error;
+};
+
+// Bounds checked little endian reads. Reading past the end returns zeros and sets overflow
+struct AsepriteReader
+{
+    const uint8_t *data;
+    size_t length;
+    size_t pos;
+    bool overflow;
+};
+
+static const uint8_t *AsepriteReader_bytes(struct AsepriteReader *reader, size_t length)
+{
+    if (reader->overflow || length > reader->length - reader->pos)
+    {
+        reader->overflow = true;
+        return NULL;
+    }
+
+    const uint8_t *bytes = reader->data + reader->pos;
+    reader->pos += length;
+    return bytes;
+}
+
+static uint32_t AsepriteReader_u8(struct AsepriteReader *reader)
+{
+    const uint8_t *bytes = AsepriteReader_bytes(reader, 1);
+    return bytes ? bytes[0] : 0;
+}
+
+static uint32_t AsepriteReader_u16(struct AsepriteReader *reader)
+{
+    const uint8_t *bytes = AsepriteReader_bytes(reader, 2);
+    return bytes ? bytes[0] | (bytes[1] << 8) : 0;
+}
+
+static int AsepriteReader_s16(struct AsepriteReader *reader)
+{
+    return (int16_t)AsepriteReader_u16(reader);
+}
+
+static uint32_t AsepriteReader_u32(struct AsepriteReader *reader)
+{
+    const uint8_t *bytes = AsepriteReader_bytes(reader, 4);
+    return bytes ? bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24) : 0;
+}
+
+// Returns a malloc'd, null terminated copy of a length prefixed string
+static char *AsepriteReader_string(struct AsepriteReader *reader)
+{
+    uint32_t length = AsepriteReader_u16(reader);
+    const uint8_t *bytes = AsepriteReader_bytes(reader, length);
+    if (bytes == NULL)
+    {
+        return NULL;
+    }
+
+    char *string = malloc(length + 1);
+    if (string != NULL)
+    {
+        memcpy(string, bytes, length);
+        string[length] = '\0';
+    }
+
+    return string;
+}
+
+static void Aseprite_readLayer(struct Aseprite *ase, struct AsepriteReader *chunk, bool layerOpacityValid, bool *groupVisible)
+{
+    uint32_t flags = AsepriteReader_u16(chunk);
+    AsepriteReader_u16(chunk); // type
+    uint32_t childLevel = AsepriteReader_u16(chunk);
+    AsepriteReader_u16(chunk); // default width
+    AsepriteReader_u16(chunk); // default height
+    AsepriteReader_u16(chunk); // blend mode
+    uint32_t opacity = AsepriteReader_u8(chunk);
+
+    if (childLevel >= ASEPRITE_MAX_CHILD_LEVEL)
+    {
+        childLevel = ASEPRITE_MAX_CHILD_LEVEL - 1;
+    }
+
+    struct AsepriteLayer *layers = realloc(ase->layers, (ase->nLayers + 1) * sizeof(struct AsepriteLayer));
+    if (layers == NULL)
+    {
+        return;
+    }
+
+    ase->layers = layers;
+
+    // a layer is only shown if every group it is in is too
+    bool visible = (flags & ASEPRITE_LAYER_VISIBLE) && !(flags & ASEPRITE_LAYER_REFERENCE);
+    if (childLevel > 0)
+    {
+        visible = visible && groupVisible[childLevel - 1];
+    }
+
+    groupVisible[childLevel] = visible;
+
+    ase->layers[ase->nLayers++] = (struct AsepriteLayer){
+        .visible = visible,
+        .background = flags & ASEPRITE_LAYER_BACKGROUND,
+        .opacity = layerOpacityValid ? (int)opacity : 255};
+}
+
+// Returns non-zero if the cel links to a cel which hasn't been read yet
+static int Aseprite_readCel(struct Aseprite *ase, struct AsepriteReader *chunk, struct AsepriteFrame *frame)
+{
+    struct AsepriteCel cel = {0};
+
+    cel.layer = AsepriteReader_u16(chunk);
+    cel.x = AsepriteReader_s16(chunk);
+    cel.y = AsepriteReader_s16(chunk);
+    cel.opacity = AsepriteReader_u8(chunk);
+    cel.type = AsepriteReader_u16(chunk);
+    cel.zIndex = AsepriteReader_s16(chunk);
+    AsepriteReader_bytes(chunk, 5);
+
+    if (cel.type == ASEPRITE_CEL_LINKED)
+    {
+        uint32_t linkedFrame = AsepriteReader_u16(chunk);
+        if (linkedFrame >= (uint32_t)(frame - ase->frames))
+        {
+            return 1;
+        }
+
+        // the position and opacity come from the linked cel too
+        struct AsepriteFrame *linked = &ase->frames[linkedFrame];
+        bool found = false;
+
+        for (int i = 0; i < linked->nCels && !found; i++)
+        {
+            if (linked->cels[i].layer == cel.layer)
+            {
+                cel = linked->cels[i];
+                found = true;
+            }
+        }
+
+        if (!found)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        cel.width = AsepriteReader_u16(chunk);
+        cel.height = AsepriteReader_u16(chunk);
+        cel.dataLength = chunk->length - chunk->pos;
+        cel.data = AsepriteReader_bytes(chunk, cel.dataLength);
+    }
+
+    struct AsepriteCel *cels = realloc(frame->cels, (frame->nCels + 1) * sizeof(struct AsepriteCel));
+    if (cels == NULL)
+    {
+        return 1;
+    }
+
+    frame->cels = cels;
+    frame->cels[frame->nCels++] = cel;
+    return 0;
+}
+
+static void Aseprite_readTags(struct Aseprite *ase, struct AsepriteReader *chunk)
+{
+    uint32_t nTags = AsepriteReader_u16(chunk);
+    AsepriteReader_bytes(chunk, 8);
+
+    // only one tags chunk is expected, but don't leak the first if there are more
+    for (int i = 0; i < ase->nTags; i++)
+    {
+        free(ase->tags[i].name);
+    }
+
+    free(ase->tags);
+    ase->nTags = 0;
+    ase->tags = calloc(nTags ? nTags : 1, sizeof(struct AsepriteTag));
+    if (ase->tags == NULL)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < nTags && !chunk->overflow; i++)
+    {
+        struct AsepriteTag *tag = &ase->tags[ase->nTags];
+
+        tag->from = AsepriteReader_u16(chunk);
+        tag->to = AsepriteReader_u16(chunk);
+        // direction, repeat count, reserved bytes, colour
+        AsepriteReader_bytes(chunk, 1 + 2 + 6 + 4);
+        tag->name = AsepriteReader_string(chunk);
+
+        if (tag->name != NULL)
+        {
+            ase->nTags++;
+        }
+    }
+}
+
+static void Aseprite_readPalette(struct Aseprite *ase, struct AsepriteReader *chunk)
+{
+    AsepriteReader_u32(chunk); // new palette size
+    uint32_t first = AsepriteReader_u32(chunk);
+    uint32_t last = AsepriteReader_u32(chunk);
+    AsepriteReader_bytes(chunk, 8);
+
+    for (uint32_t i = first; i <= last && !chunk->overflow; i++)
+    {
+        uint32_t flags = AsepriteReader_u16(chunk);
+        const uint8_t *rgba = AsepriteReader_bytes(chunk, 4);
+
+        if (rgba != NULL && i < 256)
+        {
+            memcpy(ase->palette[i], rgba, 4);
+        }
+
+        // has a name
+        if (flags & 1)
+        {
+            free(AsepriteReader_string(chunk));
+        }
+    }
+}
+
+// Only used by files from before the palette chunk existed
+static void Aseprite_readOldPalette(struct Aseprite *ase, struct AsepriteReader *chunk)
+{
+    uint32_t nPackets = AsepriteReader_u16(chunk);
+    uint32_t index = 0;
+
+    for (uint32_t packet = 0; packet < nPackets && !chunk->overflow; packet++)
+    {
+        index += AsepriteReader_u8(chunk);
+        uint32_t nColours = AsepriteReader_u8(chunk);
+        if (nColours == 0)
+        {
+            nColours = 256;
+        }
+
+        for (uint32_t i = 0; i < nColours; i++, index++)
+        {
+            const uint8_t *rgb = AsepriteReader_bytes(chunk, 3);
+            if (rgb != NULL && index < 256)
+            {
+                memcpy(ase->palette[index], rgb, 3);
+                ase->palette[index][3] = 255;
+            }
+        }
+    }
+}
+
+static int Aseprite_readFile(struct Aseprite *ase, const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        asprintf(&ase->error, "Failed to open file %s", filename);
+        return 1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    ase->file = length > 0 ? malloc(length) : NULL;
+    bool ok = ase->file != NULL && fread(ase->file, 1, length, file) == (size_t)length;
+    fclose(file);
+
+    if (!ok)
+    {
+        asprintf(&ase->error, "Failed to read file %s", filename);
+        return 1;
+    }
+
+    struct AsepriteReader reader = {.data = ase->file, .length = length};
+
+    AsepriteReader_u32(&reader); // file size
+    uint32_t magic = AsepriteReader_u16(&reader);
+    ase->nFrames = AsepriteReader_u16(&reader);
+    ase->width = AsepriteReader_u16(&reader);
+    ase->height = AsepriteReader_u16(&reader);
+    ase->depth = AsepriteReader_u16(&reader);
+    uint32_t flags = AsepriteReader_u32(&reader);
+    AsepriteReader_bytes(&reader, 2 + 4 + 4); // speed and two reserved words
+    ase->transparentIndex = AsepriteReader_u8(&reader);
+
+    if (magic != ASEPRITE_MAGIC || reader.overflow || length < ASEPRITE_HEADER_SIZE)
+    {
+        asprintf(&ase->error, "%s is not an aseprite file", filename);
+        return 1;
+    }
+
+    if (ase->depth != 32 && ase->depth != 16 && ase->depth != 8)
+    {
+        asprintf(&ase->error, "Unsupported colour depth %d", ase->depth);
+        return 1;
+    }
+
+    ase->frames = calloc(ase->nFrames ? ase->nFrames : 1, sizeof(struct AsepriteFrame));
+    if (ase->frames == NULL)
+    {
+        asprintf(&ase->error, "Failed to allocate frames");
+        return 1;
+    }
+
+    bool groupVisible[ASEPRITE_MAX_CHILD_LEVEL] = {0};
+    reader.pos = ASEPRITE_HEADER_SIZE;
+
+    for (int f = 0; f < ase->nFrames; f++)
+    {
+        size_t frameStart = reader.pos;
+        uint32_t frameLength = AsepriteReader_u32(&reader);
+        uint32_t frameMagic = AsepriteReader_u16(&reader);
+        uint32_t nChunks = AsepriteReader_u16(&reader);
+        ase->frames[f].duration = AsepriteReader_u16(&reader);
+        AsepriteReader_bytes(&reader, 2);
+        uint32_t nNewChunks = AsepriteReader_u32(&reader);
+
+        if (nNewChunks != 0)
+        {
+            nChunks = nNewChunks;
+        }
+
+        if (frameMagic != ASEPRITE_FRAME_MAGIC || reader.overflow || frameLength < ASEPRITE_FRAME_HEADER_SIZE ||
+            frameLength > reader.length - frameStart)
+        {
+            asprintf(&ase->error, "Frame %d is corrupt", f);
+            return 1;
+        }
+
+        size_t frameEnd = frameStart + frameLength;
+
+        for (uint32_t c = 0; c < nChunks; c++)
+        {
+            size_t chunkStart = reader.pos;
+            uint32_t chunkLength = AsepriteReader_u32(&reader);
+            uint32_t chunkType = AsepriteReader_u16(&reader);
+
+            if (reader.overflow || chunkLength < 6 || chunkStart + chunkLength > frameEnd)
+            {
+                asprintf(&ase->error, "Chunk %d of frame %d is corrupt", c, f);
+                return 1;
+            }
+
+            struct AsepriteReader chunk = {.data = ase->file + reader.pos, .length = chunkLength - 6};
+            int err = 0;
+
+            switch (chunkType)
+            {
+            case ASEPRITE_CHUNK_LAYER:
+                Aseprite_readLayer(ase, &chunk, flags & ASEPRITE_FLAG_LAYER_OPACITY, groupVisible);
+                break;
+            case ASEPRITE_CHUNK_CEL:
+                err = Aseprite_readCel(ase, &chunk, &ase->frames[f]);
+                break;
+            case ASEPRITE_CHUNK_TAGS:
+                Aseprite_readTags(ase, &chunk);
+                break;
+            case ASEPRITE_CHUNK_PALETTE:
+                Aseprite_readPalette(ase, &chunk);
+                break;
+            case ASEPRITE_CHUNK_OLD_PALETTE:
+                Aseprite_readOldPalette(ase, &chunk);
+                break;
+            default:
+                // colour profiles, user data, slices and so on don't affect the pixels
+                break;
+            }
+
+            if (err || chunk.overflow)
+            {
+                asprintf(&ase->error, "Chunk %d of frame %d is corrupt", c, f);
+                return 1;
+            }
+
+            reader.pos = chunkStart + chunkLength;
+        }
+
+        reader.pos = frameEnd;
+    }
+
+    for (int i = 0; i < ase->nTags; i++)
+    {
+        if (ase->tags[i].from > ase->tags[i].to || ase->tags[i].to >= ase->nFrames)
+        {
+            asprintf(&ase->error, "Tag %s is outside the frames", ase->tags[i].name);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+struct Aseprite *Aseprite_New(const char *filename)
+{
+    struct Aseprite *ase = calloc(1, sizeof(struct Aseprite));
+    if (ase == NULL)
+    {
+        return NULL;
+    }
+
+    Aseprite_readFile(ase, filename);
+    return ase;
+}
+
+char *Aseprite_Error(struct Aseprite *ase)
+{
+    return ase->error;
+}
+
+void Aseprite_Free(struct Aseprite *ase)
+{
+    if (ase == NULL)
+    {
+        return;
+    }
+
+    for (int f = 0; f < ase->nFrames && ase->frames != NULL; f++)
+    {
+        free(ase->frames[f].cels);
+    }
+
+    for (int i = 0; i < ase->nTags; i++)
+    {
+        free(ase->tags[i].name);
+    }
+
+    free(ase->frames);
+    free(ase->layers);
+    free(ase->tags);
+    free(ase->file);
+    free(ase->error);
+    free(ase);
+}
+
+int Aseprite_Width(struct Aseprite *ase)
+{
+    return ase->width;
+}
+
+int Aseprite_Height(struct Aseprite *ase)
+{
+    return ase->height;
+}
+
+int Aseprite_NumFrames(struct Aseprite *ase)
+{
+    return ase->nFrames;
+}
+
+int Aseprite_FrameDuration(struct Aseprite *ase, int frame)
+{
+    return ase->frames[frame].duration;
+}
+
+int Aseprite_NumTags(struct Aseprite *ase)
+{
+    return ase->nTags;
+}
+
+const char *Aseprite_TagName(struct Aseprite *ase, int tag)
+{
+    return ase->tags[tag].name;
+}
+
+int Aseprite_TagFrom(struct Aseprite *ase, int tag)
+{
+    return ase->tags[tag].from;
+}
+
+int Aseprite_TagTo(struct Aseprite *ase, int tag)
+{
+    return ase->tags[tag].to;
+}
+
+// Cels are drawn in layer order, moved by their z-index. Ties go to the lower z-index
+static int Aseprite_compareCels(const void *a, const void *b)
+{
+    const struct AsepriteCel *left = a;
+    const struct AsepriteCel *right = b;
+
+    int leftOrder = left->layer + left->zIndex;
+    int rightOrder = right->layer + right->zIndex;
+
+    if (leftOrder != rightOrder)
+    {
+        return leftOrder - rightOrder;
+    }
+
+    return left->zIndex - right->zIndex;
+}
+
+static void Aseprite_celPixel(struct Aseprite *ase, const uint8_t *pixel, bool background, uint8_t *rgba)
+{
+    switch (ase->depth)
+    {
+    case 32:
+        memcpy(rgba, pixel, 4);
+        break;
+    case 16:
+        rgba[0] = rgba[1] = rgba[2] = pixel[0];
+        rgba[3] = pixel[1];
+        break;
+    default:
+        memcpy(rgba, ase->palette[pixel[0]], 4);
+        // the background layer is opaque, so the transparent index is just another colour there
+        if (pixel[0] == ase->transparentIndex && !background)
+        {
+            rgba[3] = 0;
+        }
+        break;
+    }
+}
+
+// Source over with 8 bit channels
+static void Aseprite_blend(uint8_t *target, const uint8_t *source, int opacity)
+{
+    int sourceAlpha = source[3] * opacity / 255;
+    if (sourceAlpha == 0)
+    {
+        return;
+    }
+
+    int targetAlpha = target[3] * (255 - sourceAlpha) / 255;
+    int alpha = sourceAlpha + targetAlpha;
+
+    for (int i = 0; i < 3; i++)
+    {
+        target[i] = (source[i] * sourceAlpha + target[i] * targetAlpha) / alpha;
+    }
+
+    target[3] = alpha;
+}
+
+int Aseprite_RenderFrame(struct Aseprite *ase, int frame, uint8_t *rgba)
+{
+    struct AsepriteFrame *f = &ase->frames[frame];
+    memset(rgba, 0, (size_t)ase->width * ase->height * 4);
+
+    struct AsepriteCel *cels = malloc((f->nCels ? f->nCels : 1) * sizeof(struct AsepriteCel));
+    if (cels == NULL)
+    {
+        asprintf(&ase->error, "Failed to allocate cels");
+        return 1;
+    }
+
+    memcpy(cels, f->cels, f->nCels * sizeof(struct AsepriteCel));
+    qsort(cels, f->nCels, sizeof(struct AsepriteCel), Aseprite_compareCels);
+
+    int bytesPerPixel = ase->depth / 8;
+    int err = 0;
+
+    for (int i = 0; i < f->nCels && !err; i++)
+    {
+        struct AsepriteCel *cel = &cels[i];
+
+        if (cel->layer >= ase->nLayers || !ase->layers[cel->layer].visible)
+        {
+            continue;
+        }
+
+        if (cel->type != ASEPRITE_CEL_RAW && cel->type != ASEPRITE_CEL_COMPRESSED)
+        {
+            asprintf(&ase->error, "Frame %d uses a tilemap layer, which isn't supported", frame);
+            err = 1;
+            break;
+        }
+
+        uLongf pixelsLength = (uLongf)cel->width * cel->height * bytesPerPixel;
+        const uint8_t *pixels = cel->data;
+        uint8_t *decompressed = NULL;
+
+        if (cel->type == ASEPRITE_CEL_COMPRESSED)
+        {
+            decompressed = malloc(pixelsLength ? pixelsLength : 1);
+            uLongf decompressedLength = pixelsLength;
+
+            if (decompressed == NULL || uncompress(decompressed, &decompressedLength, cel->data, cel->dataLength) != Z_OK ||
+                decompressedLength != pixelsLength)
+            {
+                asprintf(&ase->error, "Failed to decompress a cel in frame %d", frame);
+                free(decompressed);
+                err = 1;
+                break;
+            }
+
+            pixels = decompressed;
+        }
+        else if (cel->dataLength < pixelsLength)
+        {
+            asprintf(&ase->error, "A cel in frame %d is truncated", frame);
+            err = 1;
+            break;
+        }
+
+        struct AsepriteLayer *layer = &ase->layers[cel->layer];
+        int opacity = cel->opacity * layer->opacity / 255;
+
+        for (int y = 0; y < cel->height; y++)
+        {
+            int targetY = cel->y + y;
+            if (targetY < 0 || targetY >= ase->height)
+            {
+                continue;
+            }
+
+            for (int x = 0; x < cel->width; x++)
+            {
+                int targetX = cel->x + x;
+                if (targetX < 0 || targetX >= ase->width)
+                {
+                    continue;
+                }
+
+                uint8_t pixel[4];
+                Aseprite_celPixel(ase, pixels + ((size_t)y * cel->width + x) * bytesPerPixel, layer->background, pixel);
+                Aseprite_blend(rgba + ((size_t)targetY * ase->width + targetX) * 4, pixel, opacity);
+            }
+        }
+
+        free(decompressed);
+    }
+
+    free(cels);
+    return err;
+}
+
+#ifdef TEST
+
+#include <assert.h>
+
+// gcc -DTEST Aseprite.c -lz
+
+struct TestWriter
+{
+    uint8_t data[4096];
+    size_t length;
+};
+
+static void TestWriter_u8(struct TestWriter *writer, uint32_t value)
+{
+    writer->data[writer->length++] = value;
+}
+
+static void TestWriter_u16(struct TestWriter *writer, uint32_t value)
+{
+    TestWriter_u8(writer, value & 0xff);
+    TestWriter_u8(writer, value >> 8);
+}
+
+static void TestWriter_u32(struct TestWriter *writer, uint32_t value)
+{
+    TestWriter_u16(writer, value & 0xffff);
+    TestWriter_u16(writer, value >> 16);
+}
+
+static void TestWriter_save(const struct TestWriter *writer, const char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    assert(file);
+    fwrite(writer->data, 1, writer->length, file);
+    fclose(file);
+}
+
+static void TestWriter_patch32(struct TestWriter *writer, size_t pos, uint32_t value)
+{
+    size_t length = writer->length;
+    writer->length = pos;
+    TestWriter_u32(writer, value);
+    writer->length = length;
+}
+
+static size_t TestWriter_startChunk(struct TestWriter *writer, uint32_t type)
+{
+    size_t start = writer->length;
+    TestWriter_u32(writer, 0);
+    TestWriter_u16(writer, type);
+    return start;
+}
+
+static void TestWriter_endChunk(struct TestWriter *writer, size_t start)
+{
+    TestWriter_patch32(writer, start, writer->length - start);
+}
+
+static void TestWriter_layer(struct TestWriter *writer, uint32_t flags, const char *name)
+{
+    size_t chunk = TestWriter_startChunk(writer, ASEPRITE_CHUNK_LAYER);
+    TestWriter_u16(writer, flags);
+    TestWriter_u16(writer, 0);
+    TestWriter_u16(writer, 0);
+    TestWriter_u32(writer, 0);
+    TestWriter_u16(writer, 0);
+    TestWriter_u8(writer, 255);
+    TestWriter_u8(writer, 0);
+    TestWriter_u16(writer, 0);
+    TestWriter_u16(writer, strlen(name));
+    memcpy(writer->data + writer->length, name, strlen(name));
+    writer->length += strlen(name);
+    TestWriter_endChunk(writer, chunk);
+}
+
+static void TestWriter_celHeader(struct TestWriter *writer, int layer, int x, int y, int type)
+{
+    TestWriter_u16(writer, layer);
+    TestWriter_u16(writer, x);
+    TestWriter_u16(writer, y);
+    TestWriter_u8(writer, 255);
+    TestWriter_u16(writer, type);
+    TestWriter_u16(writer, 0);
+    writer->length += 5;
+}
+
+// A 4x2, 2 frame RGBA file. A hidden layer fills every frame with red, and a visible layer has a green pixel at
+// (1, 1) in a compressed cel which the second frame links to. One tag covers both frames
+static void writeTestFile(const char *filename)
+{
+    struct TestWriter writer = {0};
+
+    TestWriter_u32(&writer, 0);
+    TestWriter_u16(&writer, ASEPRITE_MAGIC);
+    TestWriter_u16(&writer, 2);
+    TestWriter_u16(&writer, 4);
+    TestWriter_u16(&writer, 2);
+    TestWriter_u16(&writer, 32);
+    TestWriter_u32(&writer, ASEPRITE_FLAG_LAYER_OPACITY);
+    writer.length = ASEPRITE_HEADER_SIZE;
+
+    for (int f = 0; f < 2; f++)
+    {
+        size_t frame = writer.length;
+        TestWriter_u32(&writer, 0);
+        TestWriter_u16(&writer, ASEPRITE_FRAME_MAGIC);
+        TestWriter_u16(&writer, 0);
+        TestWriter_u16(&writer, f == 0 ? 100 : 250);
+        TestWriter_u16(&writer, 0);
+        TestWriter_u32(&writer, f == 0 ? 5 : 2);
+
+        if (f == 0)
+        {
+            TestWriter_layer(&writer, 0, "Background");
+            TestWriter_layer(&writer, ASEPRITE_LAYER_VISIBLE, "Sprite");
+
+            size_t tags = TestWriter_startChunk(&writer, ASEPRITE_CHUNK_TAGS);
+            TestWriter_u16(&writer, 1);
+            writer.length += 8;
+            TestWriter_u16(&writer, 0);
+            TestWriter_u16(&writer, 1);
+            writer.length += 1 + 2 + 6 + 4;
+            TestWriter_u16(&writer, 4);
+            memcpy(writer.data + writer.length, "Walk", 4);
+            writer.length += 4;
+            TestWriter_endChunk(&writer, tags);
+        }
+
+        size_t background = TestWriter_startChunk(&writer, ASEPRITE_CHUNK_CEL);
+        TestWriter_celHeader(&writer, 0, 0, 0, ASEPRITE_CEL_RAW);
+        TestWriter_u16(&writer, 4);
+        TestWriter_u16(&writer, 2);
+        for (int i = 0; i < 8; i++)
+        {
+            TestWriter_u32(&writer, 0xff0000ff);
+        }
+        TestWriter_endChunk(&writer, background);
+
+        size_t sprite = TestWriter_startChunk(&writer, ASEPRITE_CHUNK_CEL);
+        if (f == 0)
+        {
+            uint8_t pixel[4] = {0, 255, 0, 255};
+            uLongf compressedLength = 64;
+            TestWriter_celHeader(&writer, 1, 1, 1, ASEPRITE_CEL_COMPRESSED);
+            TestWriter_u16(&writer, 1);
+            TestWriter_u16(&writer, 1);
+            assert(compress(writer.data + writer.length, &compressedLength, pixel, 4) == Z_OK);
+            writer.length += compressedLength;
+        }
+        else
+        {
+            TestWriter_celHeader(&writer, 1, 0, 0, ASEPRITE_CEL_LINKED);
+            TestWriter_u16(&writer, 0);
+        }
+        TestWriter_endChunk(&writer, sprite);
+
+        TestWriter_patch32(&writer, frame, writer.length - frame);
+    }
+
+    TestWriter_patch32(&writer, 0, writer.length);
+    TestWriter_save(&writer, filename);
+}
+
+// One frame which claims to be 0 bytes long, holding a palette chunk longer than the file
+static void writeZeroLengthFrameFile(const char *filename)
+{
+    struct TestWriter writer = {0};
+
+    TestWriter_u32(&writer, 0);
+    TestWriter_u16(&writer, ASEPRITE_MAGIC);
+    TestWriter_u16(&writer, 1);
+    TestWriter_u16(&writer, 4);
+    TestWriter_u16(&writer, 2);
+    TestWriter_u16(&writer, 32);
+    writer.length = ASEPRITE_HEADER_SIZE;
+
+    TestWriter_u32(&writer, 0);
+    TestWriter_u16(&writer, ASEPRITE_FRAME_MAGIC);
+    TestWriter_u16(&writer, 1);
+    TestWriter_u16(&writer, 100);
+    TestWriter_u16(&writer, 0);
+    TestWriter_u32(&writer, 0);
+
+    size_t palette = TestWriter_startChunk(&writer, ASEPRITE_CHUNK_PALETTE);
+    TestWriter_u32(&writer, 256);
+    TestWriter_u32(&writer, 0);
+    TestWriter_u32(&writer, 255);
+    TestWriter_patch32(&writer, palette, 0x10000);
+
+    TestWriter_patch32(&writer, 0, writer.length);
+    TestWriter_save(&writer, filename);
+}
+
+int main(void)
+{
+    const char *filename = "AsepriteTest.aseprite";
+    writeTestFile(filename);
+
+    struct Aseprite *ase = Aseprite_New(filename);
+    remove(filename);
+
+    assert(ase && Aseprite_Error(ase) == NULL);
+    assert(Aseprite_Width(ase) == 4 && Aseprite_Height(ase) == 2);
+    assert(Aseprite_NumFrames(ase) == 2);
+    assert(Aseprite_FrameDuration(ase, 0) == 100 && Aseprite_FrameDuration(ase, 1) == 250);
+
+    assert(Aseprite_NumTags(ase) == 1);
+    assert(strcmp(Aseprite_TagName(ase, 0), "Walk") == 0);
+    assert(Aseprite_TagFrom(ase, 0) == 0 && Aseprite_TagTo(ase, 0) == 1);
+
+    for (int f = 0; f < 2; f++)
+    {
+        uint8_t rgba[4 * 2 * 4];
+        assert(Aseprite_RenderFrame(ase, f, rgba) == 0);
+
+        for (int i = 0; i < 8; i++)
+        {
+            // the hidden red layer must not show through
+            uint8_t expected[4] = {0, i == 5 ? 255 : 0, 0, i == 5 ? 255 : 0};
+            assert(memcmp(rgba + i * 4, expected, 4) == 0);
+        }
+    }
+
+    Aseprite_Free(ase);
+
+    writeZeroLengthFrameFile(filename);
+    ase = Aseprite_New(filename);
+    remove(filename);
+
+    assert(ase && Aseprite_Error(ase) != NULL);
+    Aseprite_Free(ase);
+
+    printf("Aseprite tests passed\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+// An .aseprite / .ase file, see https://github.com/aseprite/aseprite/blob/main/docs/ase-file-specs.md
+struct Aseprite;
+
+// Check Aseprite_Error on the result, like Image_New
+struct Aseprite *Aseprite_New(const char *filename);
+char *Aseprite_Error(struct Aseprite *ase);
+void Aseprite_Free(struct Aseprite *ase);
+
+int Aseprite_Width(struct Aseprite *ase);
+int Aseprite_Height(struct Aseprite *ase);
+
+int Aseprite_NumFrames(struct Aseprite *ase);
+// In milliseconds
+int Aseprite_FrameDuration(struct Aseprite *ase, int frame);
+
+int Aseprite_NumTags(struct Aseprite *ase);
+const char *Aseprite_TagName(struct Aseprite *ase, int tag);
+// The first and last frames of the tag, both inclusive
+int Aseprite_TagFrom(struct Aseprite *ase, int tag);
+int Aseprite_TagTo(struct Aseprite *ase, int tag);
+
+// Composites the visible layers of frame into width * height RGBA8 pixels, row by row. Every blend mode is treated
+// as normal. Returns non-zero and sets the error on failure
+int Aseprite_RenderFrame(struct Aseprite *ase, int frame, uint8_t *rgba);
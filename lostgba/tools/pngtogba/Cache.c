@@ -0,0 +1,170 @@
+#include "Cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+struct Cache
+{
+    char *directory;
+    // FNV-1a
+    uint64_t hash;
+};
+
+struct Cache *Cache_New(const char *directory)
+{
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST)
+    {
+        return NULL;
+    }
+
+    struct Cache *cache = malloc(sizeof(struct Cache));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+
+    cache->directory = strdup(directory);
+    cache->hash = 14695981039346656037ull;
+
+    Cache_AddBytes(cache, PNGTOGBA_VERSION, sizeof(PNGTOGBA_VERSION));
+
+    return cache;
+}
+
+void Cache_Free(struct Cache *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    free(cache->directory);
+    free(cache);
+}
+
+void Cache_AddBytes(struct Cache *cache, const void *data, size_t length)
+{
+    const uint8_t *bytes = data;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        cache->hash = (cache->hash ^ bytes[i]) * 1099511628211ull;
+    }
+}
+
+int Cache_AddFile(struct Cache *cache, const char *fileName)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL)
+    {
+        return 1;
+    }
+
+    uint8_t buffer[65536];
+    size_t bytesRead;
+    uint64_t length = 0;
+
+    while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        Cache_AddBytes(cache, buffer, bytesRead);
+        length += bytesRead;
+    }
+
+    int err = ferror(file);
+    fclose(file);
+
+    // so that the boundary between files is part of the key
+    Cache_AddBytes(cache, &length, sizeof(length));
+
+    return err;
+}
+
+static char *Cache_entryFileName(struct Cache *cache, const char *extension)
+{
+    size_t length = strlen(cache->directory) + 1 + 16 + strlen(extension) + 1;
+    char *fileName = malloc(length);
+
+    if (fileName != NULL)
+    {
+        snprintf(fileName, length, "%s/%016llx%s", cache->directory, (unsigned long long)cache->hash, extension);
+    }
+
+    return fileName;
+}
+
+// Returns non-zero on failure, in which case a partially written target is removed
+static int Cache_copyFile(const char *sourceFileName, const char *targetFileName)
+{
+    FILE *source = fopen(sourceFileName, "rb");
+    if (source == NULL)
+    {
+        return 1;
+    }
+
+    FILE *target = fopen(targetFileName, "wb");
+    if (target == NULL)
+    {
+        fclose(source);
+        return 1;
+    }
+
+    uint8_t buffer[65536];
+    size_t bytesRead;
+    int err = 0;
+
+    while (!err && (bytesRead = fread(buffer, 1, sizeof(buffer), source)) > 0)
+    {
+        err = fwrite(buffer, 1, bytesRead, target) != bytesRead;
+    }
+
+    err |= ferror(source);
+    fclose(source);
+    err |= fclose(target) != 0;
+
+    if (err)
+    {
+        remove(targetFileName);
+    }
+
+    return err;
+}
+
+bool Cache_Fetch(struct Cache *cache, const char *extension, const char *outFileName)
+{
+    char *entryFileName = Cache_entryFileName(cache, extension);
+    bool hit = entryFileName != NULL && Cache_copyFile(entryFileName, outFileName) == 0;
+
+    free(entryFileName);
+    return hit;
+}
+
+void Cache_Store(struct Cache *cache, const char *extension, const char *outFileName)
+{
+    char *entryFileName = Cache_entryFileName(cache, extension);
+    if (entryFileName == NULL)
+    {
+        return;
+    }
+
+    // write somewhere private then rename, so that parallel builds never see half an entry
+    size_t tempLength = strlen(entryFileName) + 32;
+    char *tempFileName = malloc(tempLength);
+
+    if (tempFileName != NULL)
+    {
+        snprintf(tempFileName, tempLength, "%s.%ld.tmp", entryFileName, (long)getpid());
+
+        if (Cache_copyFile(outFileName, tempFileName) == 0 && rename(tempFileName, entryFileName) != 0)
+        {
+            remove(tempFileName);
+        }
+    }
+
+    free(tempFileName);
+    free(entryFileName);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Bump this whenever the output for the same input changes
+#define PNGTOGBA_VERSION "pngtogba 4"
+
+// A persistent store of previous outputs, keyed by a hash of everything that was added to it
+struct Cache;
+
+// Returns NULL if the directory doesn't exist and couldn't be created
+struct Cache *Cache_New(const char *directory);
+void Cache_Free(struct Cache *cache);
+
+void Cache_AddBytes(struct Cache *cache, const void *data, size_t length);
+// returns non-zero if the file couldn't be read
+int Cache_AddFile(struct Cache *cache, const char *fileName);
+
+// Copies the output stored for the current key to outFileName. Returns false if there isn't one
+bool Cache_Fetch(struct Cache *cache, const char *extension, const char *outFileName);
+// Stores outFileName under the current key. Failing to store is not an error, the output just gets rebuilt next time
+void Cache_Store(struct Cache *cache, const char *extension, const char *outFileName);
@@ -0,0 +1,329 @@
+#include "Compression.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define LZ77_HEADER 0x10
+#define RLE_HEADER 0x30
+
+#define LZ77_MIN_LENGTH 3
+#define LZ77_MAX_LENGTH 18
+#define LZ77_WINDOW 4096
+// The VRAM decompressor writes 16 bits at a time, so it can't copy from the byte it has only half written
+#define LZ77_MIN_DISTANCE 2
+// How many earlier positions with the same hash to check before giving up on finding a longer match
+#define LZ77_MAX_CHAIN 256
+#define LZ77_HASH_SIZE (1 << 16)
+
+#define RLE_MIN_RUN 3
+#define RLE_MAX_RUN 130
+#define RLE_MAX_LITERALS 128
+
+static int Compression_writeHeader(uint8_t *out, uint8_t type, int length)
+{
+    out[0] = type;
+    out[1] = length & 0xff;
+    out[2] = (length >> 8) & 0xff;
+    out[3] = (length >> 16) & 0xff;
+
+    return 4;
+}
+
+static uint32_t Compression_hash3(const uint8_t *data)
+{
+    uint32_t value = data[0] | (data[1] << 8) | (data[2] << 16);
+    return (value * 2654435761u) >> 16;
+}
+
+static int Compression_lz77(const uint8_t *data, int length, uint8_t *out)
+{
+    int outPos = Compression_writeHeader(out, LZ77_HEADER, length);
+
+    // hash chains of earlier positions starting with the same 3 bytes, -1 terminated
+    int *head = malloc(LZ77_HASH_SIZE * sizeof(int));
+    int *previous = malloc((length > 0 ? length : 1) * sizeof(int));
+    assert(head && previous);
+    memset(head, -1, LZ77_HASH_SIZE * sizeof(int));
+
+    int inserted = 0;
+    int pos = 0;
+
+    while (pos < length)
+    {
+        int flagPos = outPos++;
+        out[flagPos] = 0;
+
+        for (int block = 0; block < 8 && pos < length; block++)
+        {
+            int bestLength = 0;
+            int bestDistance = 0;
+
+            if (pos + LZ77_MIN_LENGTH <= length)
+            {
+                int maxLength = length - pos < LZ77_MAX_LENGTH ? length - pos : LZ77_MAX_LENGTH;
+                int chain = 0;
+
+                for (int candidate = head[Compression_hash3(data + pos)];
+                     candidate != -1 && pos - candidate <= LZ77_WINDOW && chain < LZ77_MAX_CHAIN;
+                     candidate = previous[candidate], chain++)
+                {
+                    if (pos - candidate < LZ77_MIN_DISTANCE)
+                    {
+                        continue;
+                    }
+
+                    int matchLength = 0;
+                    while (matchLength < maxLength && data[candidate + matchLength] == data[pos + matchLength])
+                    {
+                        matchLength++;
+                    }
+
+                    if (matchLength > bestLength)
+                    {
+                        bestLength = matchLength;
+                        bestDistance = pos - candidate;
+
+                        if (bestLength == maxLength)
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+
+            int consumed = 1;
+            if (bestLength >= LZ77_MIN_LENGTH)
+            {
+                out[flagPos] |= 0x80 >> block;
+                out[outPos++] = ((bestLength - LZ77_MIN_LENGTH) << 4) | ((bestDistance - 1) >> 8);
+                out[outPos++] = (bestDistance - 1) & 0xff;
+                consumed = bestLength;
+            }
+            else
+            {
+                out[outPos++] = data[pos];
+            }
+
+            pos += consumed;
+
+            for (; inserted < pos && inserted + LZ77_MIN_LENGTH <= length; inserted++)
+            {
+                uint32_t hash = Compression_hash3(data + inserted);
+                previous[inserted] = head[hash];
+                head[hash] = inserted;
+            }
+        }
+    }
+
+    free(head);
+    free(previous);
+
+    return outPos;
+}
+
+static int Compression_runLength(const uint8_t *data, int length, int pos)
+{
+    int run = 1;
+    while (pos + run < length && run < RLE_MAX_RUN && data[pos + run] == data[pos])
+    {
+        run++;
+    }
+
+    return run;
+}
+
+static int Compression_rle(const uint8_t *data, int length, uint8_t *out)
+{
+    int outPos = Compression_writeHeader(out, RLE_HEADER, length);
+    int pos = 0;
+
+    while (pos < length)
+    {
+        int run = Compression_runLength(data, length, pos);
+        if (run >= RLE_MIN_RUN)
+        {
+            out[outPos++] = 0x80 | (run - RLE_MIN_RUN);
+            out[outPos++] = data[pos];
+            pos += run;
+            continue;
+        }
+
+        // copy bytes verbatim until the next run worth encoding
+        int literals = 0;
+        while (pos + literals < length && literals < RLE_MAX_LITERALS &&
+               Compression_runLength(data, length, pos + literals) < RLE_MIN_RUN)
+        {
+            literals++;
+        }
+
+        out[outPos++] = literals - 1;
+        memcpy(out + outPos, data + pos, literals);
+        outPos += literals;
+        pos += literals;
+    }
+
+    return outPos;
+}
+
+uint8_t *Compression_Compress(enum CompressionType type, const uint8_t *data, int length, int *compressedLength)
+{
+    if (length < 0 || length >= (1 << 24) || type == CompressionType_None)
+    {
+        return NULL;
+    }
+
+    // worst cases are one flag byte per 8 literals for LZ77 and one per 128 for RLE, plus header and padding
+    uint8_t *out = calloc(length + length / 8 + 16, 1);
+    if (out == NULL)
+    {
+        return NULL;
+    }
+
+    int outLength = type == CompressionType_LZ77 ? Compression_lz77(data, length, out) : Compression_rle(data, length, out);
+
+    // the system calls need the source to be word aligned, so the stream is emitted as words
+    *compressedLength = (outLength + 3) & ~3;
+
+    return out;
+}
+
+#ifdef TEST
+
+#include <stdio.h>
+
+// Decompresses the same way as the BIOS, including only writing whole halfwords in VRAM mode
+static int testDecompress(const uint8_t *in, uint8_t *out, int outSize, bool vram)
+{
+    int length = in[1] | (in[2] << 8) | (in[3] << 16);
+    assert(length <= outSize);
+
+    // bytes are only visible once their halfword has been flushed, as in VRAM
+    uint8_t *visible = calloc(length + 2, 1);
+    int pos = 0;
+    int inPos = 4;
+
+#define WRITE(byte)                                      \
+    do                                                   \
+    {                                                    \
+        out[pos] = (byte);                               \
+        if (!vram || (pos & 1))                          \
+        {                                                \
+            visible[pos & ~1] = out[pos & ~1];           \
+            visible[pos] = out[pos];                     \
+        }                                                \
+        pos++;                                           \
+    } while (0)
+
+    if (in[0] == LZ77_HEADER)
+    {
+        while (pos < length)
+        {
+            uint8_t flags = in[inPos++];
+            for (int block = 0; block < 8 && pos < length; block++)
+            {
+                if (flags & (0x80 >> block))
+                {
+                    int copyLength = (in[inPos] >> 4) + LZ77_MIN_LENGTH;
+                    int distance = (((in[inPos] & 0xf) << 8) | in[inPos + 1]) + 1;
+                    inPos += 2;
+
+                    for (int i = 0; i < copyLength; i++)
+                    {
+                        assert(pos - distance >= 0);
+                        WRITE(visible[pos - distance]);
+                    }
+                }
+                else
+                {
+                    WRITE(in[inPos++]);
+                }
+            }
+        }
+    }
+    else
+    {
+        assert(in[0] == RLE_HEADER);
+        while (pos < length)
+        {
+            uint8_t flag = in[inPos++];
+            if (flag & 0x80)
+            {
+                uint8_t byte = in[inPos++];
+                for (int i = 0; i < (flag & 0x7f) + RLE_MIN_RUN; i++)
+                {
+                    WRITE(byte);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < flag + 1; i++)
+                {
+                    WRITE(in[inPos++]);
+                }
+            }
+        }
+    }
+
+#undef WRITE
+
+    free(visible);
+    return pos;
+}
+
+static void testRoundTrip(const char *name, const uint8_t *data, int length)
+{
+    enum CompressionType types[] = {CompressionType_LZ77, CompressionType_RLE};
+
+    for (int t = 0; t < 2; t++)
+    {
+        int compressedLength;
+        uint8_t *compressed = Compression_Compress(types[t], data, length, &compressedLength);
+        assert(compressed);
+        assert(compressedLength % 4 == 0);
+
+        uint8_t *decompressed = malloc(length + 1);
+        assert(testDecompress(compressed, decompressed, length, types[t] == CompressionType_LZ77) == length);
+        assert(memcmp(decompressed, data, length) == 0);
+
+        printf("%s %s: %d -> %d bytes\n", name, types[t] == CompressionType_LZ77 ? "LZ77" : "RLE", length, compressedLength);
+
+        free(decompressed);
+        free(compressed);
+    }
+}
+
+int main(void)
+{
+    enum
+    {
+        LENGTH = 32768
+    };
+    static uint8_t data[LENGTH];
+
+    testRoundTrip("empty", data, 0);
+    testRoundTrip("zeros", data, LENGTH);
+
+    // single byte repeats are the case the VRAM distance limit exists for
+    for (int i = 0; i < LENGTH; i++)
+    {
+        data[i] = (i / 37) % 3 == 0 ? 0x11 : (uint8_t)(i * 7 / 5);
+    }
+    testRoundTrip("mixed", data, LENGTH);
+
+    uint32_t state = 12023908;
+    for (int i = 0; i < LENGTH; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data[i] = state & (i % 512 < 256 ? 0x3 : 0xff);
+    }
+    testRoundTrip("random", data, LENGTH);
+    testRoundTrip("odd length", data, 1001);
+
+    return 0;
+}
+
+#endif
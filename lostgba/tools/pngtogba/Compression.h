@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+enum CompressionType
+{
+    CompressionType_None,
+    // GBA BIOS LZ77, safe for the VRAM variant of the decompression system call
+    CompressionType_LZ77,
+    // GBA BIOS run length encoding
+    CompressionType_RLE
+};
+
+// Returns a malloc'd stream including the 4 byte BIOS header, padded with zeros to a multiple of 4 bytes.
+// compressedLength is set to the padded length. Returns NULL on failure (including if length doesn't fit in 24 bits)
+uint8_t *Compression_Compress(enum CompressionType type, const uint8_t *data, int length, int *compressedLength);
@@ -4,6 +4,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <ctype.h>
@@ -11,6 +12,18 @@
 #define TILESIZE_VAR_NAME "TILESIZE"
 #define TRANSPARENT_VAR_NAME "TRANSPARENT"
 #define PREFIX_VAR_NAME "PREFIX"
+#define DEDUPE_VAR_NAME "DEDUPE"
+#define SOLVERTIME_VAR_NAME "SOLVERTIME"
+#define COMPRESS_VAR_NAME "COMPRESS"
+#define BPP_VAR_NAME "BPP"
+#define IMAGES_VAR_NAME "IMAGES"
+#define SECTION_VAR_NAME "SECTION"
+#define TILESET_VAR_NAME "TILESET"
+#define METATILES_VAR_NAME "METATILES"
+
+#define PALETTE_GROUP_EXTENSION ".palette.h"
+
+#define DEFAULT_SOLVER_TIME_MS 1000
 
 // Returns -1 on an invalid number
 static int parseTileSize(const char *tileSizeString)
@@ -25,6 +38,63 @@ static int parseTileSize(const char *tileSizeString)
     return tileSize;
 }
 
+// Anything starting with 1, t(rue) or y(es) is true
+static bool parseBool(const char *boolString)
+{
+    return boolString[0] == '1' || tolower(boolString[0]) == 't' || tolower(boolString[0]) == 'y';
+}
+
+// LZ77, RLE or NONE in any case. Returns -1 if it is none of those
+static int parseCompression(const char *compressionString)
+{
+    if (strncasecmp(compressionString, "LZ77", 4) == 0)
+    {
+        return CompressionType_LZ77;
+    }
+
+    if (strncasecmp(compressionString, "RLE", 3) == 0)
+    {
+        return CompressionType_RLE;
+    }
+
+    if (strncasecmp(compressionString, "NONE", 4) == 0)
+    {
+        return CompressionType_None;
+    }
+
+    return -1;
+}
+
+// ROM, IWRAM or EWRAM in any case, ROM if there is no SECTION=. Returns -1 if it is none of those
+static int parseSection(const char *buffer)
+{
+    const char *sectionVar = strstr(buffer, SECTION_VAR_NAME "=");
+    if (sectionVar == NULL)
+    {
+        return OutputSection_Rom;
+    }
+
+    const char *sectionString = sectionVar + strlen(SECTION_VAR_NAME "=");
+
+    if (strncasecmp(sectionString, "ROM", 3) == 0)
+    {
+        return OutputSection_Rom;
+    }
+
+    if (strncasecmp(sectionString, "IWRAM", 5) == 0)
+    {
+        return OutputSection_Iwram;
+    }
+
+    if (strncasecmp(sectionString, "EWRAM", 5) == 0)
+    {
+        return OutputSection_Ewram;
+    }
+
+    fprintf(stderr, "Section must be one of ROM, IWRAM or EWRAM");
+    return -1;
+}
+
 // Returns INVALID_COLOUR if colour is invalid
 uint16_t parseColour(const char *colourString)
 {
@@ -43,20 +113,71 @@ uint16_t parseColour(const char *colourString)
     return rgb15(c);
 }
 
+// filename without its last extension, followed by newExtension. Returns a malloc'd string
+static char *replaceExtension(const char *filename, const char *newExtension)
+{
+    int baseLength = strrchr(filename, '.') - filename;
+    char *result = malloc(baseLength + strlen(newExtension) + 1);
+    strncpy(result, filename, baseLength);
+    strcpy(result + baseLength, newExtension);
+
+    return result;
+}
+
+// Returns a malloc'd copy of the alphanumeric characters following PREFIX=, or NULL if there isn't one
+static char *parsePrefix(const char *buffer)
+{
+    const char *prefixVar = strstr(buffer, PREFIX_VAR_NAME "=");
+    if (prefixVar == NULL)
+    {
+        fprintf(stderr, "Prefix required. Please include " PREFIX_VAR_NAME "=<prefix in the first 256 characters of your file");
+        return NULL;
+    }
+
+    const char *prefixVarLocation = prefixVar + strlen(PREFIX_VAR_NAME "=");
+    int prefixValueLen = 0;
+    while (isalnum(prefixVarLocation[prefixValueLen]))
+    {
+        prefixValueLen++;
+    }
+
+    char *prefix = malloc(prefixValueLen + 1);
+    strncpy(prefix, prefixVarLocation, prefixValueLen);
+    prefix[prefixValueLen] = '\0';
+
+    return prefix;
+}
+
+// Returns -1 on an invalid time
+static int parseSolverTime(const char *buffer)
+{
+    const char *solverTimeVar = strstr(buffer, SOLVERTIME_VAR_NAME "=");
+    if (solverTimeVar == NULL)
+    {
+        return DEFAULT_SOLVER_TIME_MS;
+    }
+
+    char *end;
+    long int solverTimeMs = strtol(solverTimeVar + strlen(SOLVERTIME_VAR_NAME "="), &end, 10);
+    if (solverTimeMs < 0 || solverTimeMs >= INT32_MAX)
+    {
+        fprintf(stderr, "Solver time provided is invalid");
+        return -1;
+    }
+
+    return solverTimeMs;
+}
+
 struct Config ConfigReader_ReadConfig(const char *filename, bool *ok)
 {
     *ok = false;
 
     struct Config config;
 
-    int imageFileNameLen = strrchr(filename, '.') - filename;
-    config.imgFileName = malloc(imageFileNameLen + 1);
-    strncpy(config.imgFileName, filename, imageFileNameLen);
-    config.imgFileName[imageFileNameLen] = '\0';
-
-    config.outFileName = malloc(imageFileNameLen + 3); // .c\0
-    strncpy(config.outFileName, filename, imageFileNameLen);
-    strncpy(config.outFileName + imageFileNameLen, ".c", 3);
+    config.imgFileName = replaceExtension(filename, "");
+    config.outFileName = replaceExtension(filename, ".c");
+    config.objFileName = replaceExtension(filename, ".o");
+    config.sharedPalette = false;
 
     FILE *file = fopen(filename, "r");
 
@@ -97,23 +218,66 @@ struct Config ConfigReader_ReadConfig(const char *filename, bool *ok)
     }
 
     // -------- Extract prefix ------------
-    char *prefixVar = strstr(buffer, PREFIX_VAR_NAME "=");
-    if (prefixVar == NULL)
+    config.prefix = parsePrefix(buffer);
+    if (config.prefix == NULL)
     {
-        fprintf(stderr, "Prefix required. Please include " PREFIX_VAR_NAME "=<prefix in the first 256 characters of your file");
         return config;
     }
 
-    char *prefixVarLocation = prefixVar + strlen(PREFIX_VAR_NAME "=");
-    int prefixValueLen = 0;
-    while (isalnum(prefixVarLocation[prefixValueLen]))
+    // -------- Extract dedupe option ------------
+    char *dedupeVar = strstr(buffer, DEDUPE_VAR_NAME "=");
+    config.dedupe = dedupeVar != NULL && parseBool(dedupeVar + strlen(DEDUPE_VAR_NAME "="));
+
+    // a flipped 16x16 tile has its 8x8 tiles swapped round too, which one screen entry can't say
+    if (config.dedupe && config.tileSize != 8)
     {
-        prefixValueLen++;
+        fprintf(stderr, DEDUPE_VAR_NAME " needs " TILESIZE_VAR_NAME "=8");
+        return config;
     }
 
-    config.prefix = malloc(prefixValueLen + 1);
-    strncpy(config.prefix, prefixVarLocation, prefixValueLen);
-    config.prefix[prefixValueLen] = '\0';
+    // -------- Extract bits per pixel ------------
+    config.bitsPerPixel = 4;
+    char *bppVar = strstr(buffer, BPP_VAR_NAME "=");
+    if (bppVar != NULL)
+    {
+        config.bitsPerPixel = strtol(bppVar + strlen(BPP_VAR_NAME "="), NULL, 10);
+        if (config.bitsPerPixel != 4 && config.bitsPerPixel != 8)
+        {
+            fprintf(stderr, "Bits per pixel must be 4 or 8");
+            return config;
+        }
+    }
+
+    // -------- Extract compression ------------
+    config.compression = CompressionType_None;
+    char *compressVar = strstr(buffer, COMPRESS_VAR_NAME "=");
+    if (compressVar != NULL)
+    {
+        int compression = parseCompression(compressVar + strlen(COMPRESS_VAR_NAME "="));
+        if (compression == -1)
+        {
+            fprintf(stderr, "Compression must be one of LZ77, RLE or NONE");
+            return config;
+        }
+
+        config.compression = compression;
+    }
+
+    // -------- Extract solver time budget ------------
+    config.solverTimeMs = parseSolverTime(buffer);
+    if (config.solverTimeMs == -1)
+    {
+        return config;
+    }
+
+    // -------- Extract section ------------
+    int section = parseSection(buffer);
+    if (section == -1)
+    {
+        return config;
+    }
+
+    config.section = section;
 
     // -------- Extract transparent colour ------------
     config.transparentColour = INVALID_COLOUR;
@@ -135,4 +299,220 @@ struct Config ConfigReader_ReadConfig(const char *filename, bool *ok)
 
     *ok = true;
     return config;
-}
\ No newline at end of file
+}
+bool ConfigReader_IsPaletteGroup(const char *filename)
+{
+    size_t length = strlen(filename);
+    size_t extensionLength = strlen(PALETTE_GROUP_EXTENSION);
+
+    return length > extensionLength && strcmp(filename + length - extensionLength, PALETTE_GROUP_EXTENSION) == 0;
+}
+
+struct PaletteGroupConfig ConfigReader_ReadPaletteGroupConfig(const char *filename, bool *ok)
+{
+    *ok = false;
+
+    struct PaletteGroupConfig config = {0};
+
+    config.outFileName = replaceExtension(filename, ".c");
+    config.objFileName = replaceExtension(filename, ".o");
+
+    FILE *file = fopen(filename, "r");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Failed to open file %s", filename);
+        return config;
+    }
+
+    // groups get more room than images since they list every image in the group
+#define GROUP_BUFFER_SIZE 1024
+    char buffer[GROUP_BUFFER_SIZE];
+    int bytesRead = fread(buffer, 1, GROUP_BUFFER_SIZE - 1, file);
+    fclose(file);
+
+    if (bytesRead <= 0)
+    {
+        fprintf(stderr, "Failed to read anything from file %s", filename);
+        return config;
+    }
+
+    buffer[bytesRead] = '\0';
+
+    // -------- Extract prefix ------------
+    config.prefix = parsePrefix(buffer);
+    if (config.prefix == NULL)
+    {
+        return config;
+    }
+
+    // -------- Extract solver time budget ------------
+    config.solverTimeMs = parseSolverTime(buffer);
+    if (config.solverTimeMs == -1)
+    {
+        return config;
+    }
+
+    // -------- Extract section ------------
+    int section = parseSection(buffer);
+    if (section == -1)
+    {
+        return config;
+    }
+
+    config.section = section;
+
+    // -------- Extract transparent colour ------------
+    char *transparentVar = strstr(buffer, TRANSPARENT_VAR_NAME "=");
+    if (transparentVar == NULL)
+    {
+        fprintf(stderr, "Palette groups need a transparent colour. Please include " TRANSPARENT_VAR_NAME "=<colour> in the first %d characters of your file", GROUP_BUFFER_SIZE);
+        return config;
+    }
+
+    config.transparentColour = parseColour(transparentVar + strlen(TRANSPARENT_VAR_NAME "="));
+    if (config.transparentColour == INVALID_COLOUR)
+    {
+        fprintf(stderr, "Failed to parse transparent colour");
+        return config;
+    }
+
+    // -------- Extract images ------------
+    char *imagesVar = strstr(buffer, IMAGES_VAR_NAME "=");
+    if (imagesVar == NULL)
+    {
+        fprintf(stderr, "Palette groups need a list of images. Please include " IMAGES_VAR_NAME "=<image.png.h> <sprite.aseprite.h> in the first %d characters of your file", GROUP_BUFFER_SIZE);
+        return config;
+    }
+
+    // names are relative to the group file, and the list ends at the end of the line or comment
+    const char *lastSlash = strrchr(filename, '/');
+    int directoryLength = lastSlash == NULL ? 0 : lastSlash - filename + 1;
+
+    config.imageConfigFileNames = malloc(GROUP_BUFFER_SIZE * sizeof(char *));
+
+    const char *c = imagesVar + strlen(IMAGES_VAR_NAME "=");
+    while (*c != '\0' && *c != '\n' && strncmp(c, "*/", 2) != 0)
+    {
+        if (isspace((unsigned char)*c))
+        {
+            c++;
+            continue;
+        }
+
+        int nameLength = 0;
+        while (c[nameLength] != '\0' && !isspace((unsigned char)c[nameLength]) && strncmp(c + nameLength, "*/", 2) != 0)
+        {
+            nameLength++;
+        }
+
+        char *name = malloc(directoryLength + nameLength + 1);
+        strncpy(name, filename, directoryLength);
+        strncpy(name + directoryLength, c, nameLength);
+        name[directoryLength + nameLength] = '\0';
+
+        config.imageConfigFileNames[config.nImages++] = name;
+        c += nameLength;
+    }
+
+    if (config.nImages == 0)
+    {
+        fprintf(stderr, "Palette group contains no images");
+        return config;
+    }
+
+    *ok = true;
+    return config;
+}
+
+void ConfigReader_FreePaletteGroupConfig(struct PaletteGroupConfig config)
+{
+    for (int i = 0; i < config.nImages; i++)
+    {
+        free(config.imageConfigFileNames[i]);
+    }
+
+    free(config.imageConfigFileNames);
+    free(config.outFileName);
+    free(config.objFileName);
+    free(config.prefix);
+}
+
+struct MapConfig ConfigReader_ReadMapConfig(const char *filename, bool *ok)
+{
+    *ok = false;
+
+    struct MapConfig config = {0};
+
+    config.mapFileName = replaceExtension(filename, "");
+    config.outFileName = replaceExtension(filename, ".c");
+    config.objFileName = replaceExtension(filename, ".o");
+
+    FILE *file = fopen(filename, "r");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Failed to open file %s", filename);
+        return config;
+    }
+
+    char buffer[BUFFER_SIZE];
+    int bytesRead = fread(buffer, 1, BUFFER_SIZE - 1, file);
+    fclose(file);
+
+    if (bytesRead <= 0)
+    {
+        fprintf(stderr, "Failed to read anything from file %s", filename);
+        return config;
+    }
+
+    buffer[bytesRead] = '\0';
+
+    // -------- Extract prefix ------------
+    config.prefix = parsePrefix(buffer);
+    if (config.prefix == NULL)
+    {
+        return config;
+    }
+
+    // -------- Extract section ------------
+    int section = parseSection(buffer);
+    if (section == -1)
+    {
+        return config;
+    }
+
+    config.section = section;
+
+    // -------- Extract tileset ------------
+    char *tilesetVar = strstr(buffer, TILESET_VAR_NAME "=");
+    if (tilesetVar == NULL)
+    {
+        fprintf(stderr, "Tileset required. Please include " TILESET_VAR_NAME "=<tileset.png.h> in the first 256 characters of your file");
+        return config;
+    }
+
+    // relative to the map config, and ends at whitespace or the end of the comment
+    const char *tilesetLocation = tilesetVar + strlen(TILESET_VAR_NAME "=");
+    int tilesetLength = 0;
+    while (tilesetLocation[tilesetLength] != '\0' && !isspace((unsigned char)tilesetLocation[tilesetLength]) &&
+           strncmp(tilesetLocation + tilesetLength, "*/", 2) != 0)
+    {
+        tilesetLength++;
+    }
+
+    const char *lastSlash = strrchr(filename, '/');
+    int directoryLength = lastSlash == NULL ? 0 : lastSlash - filename + 1;
+
+    config.tilesetConfigFileName = malloc(directoryLength + tilesetLength + 1);
+    strncpy(config.tilesetConfigFileName, filename, directoryLength);
+    strncpy(config.tilesetConfigFileName + directoryLength, tilesetLocation, tilesetLength);
+    config.tilesetConfigFileName[directoryLength + tilesetLength] = '\0';
+
+    // -------- Extract metatiles option ------------
+    char *metatilesVar = strstr(buffer, METATILES_VAR_NAME "=");
+    config.metatiles = metatilesVar != NULL && parseBool(metatilesVar + strlen(METATILES_VAR_NAME "="));
+
+    *ok = true;
+    return config;
+}
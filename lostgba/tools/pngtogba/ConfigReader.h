@@ -3,14 +3,70 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "Compression.h"
+#include "Output.h"
+
 struct Config
 {
     int tileSize;
+    // 4 for 16 colour palettes chosen per tile, 8 for one 256 colour palette
+    int bitsPerPixel;
     uint16_t transparentColour;
+    // Only allowed with 8x8 tiles
+    bool dedupe;
+    // Applies to the tile data only
+    enum CompressionType compression;
+    // How long to spend looking for fewer palettes than the greedy optimiser finds, 0 to skip
+    int solverTimeMs;
+    // Where the output goes on the GBA, from SECTION=ROM, IWRAM or EWRAM
+    enum OutputSection section;
+    // Set for the images of a palette group, whose palette is only output once by the group. Not read from the file
+    bool sharedPalette;
 
     char *imgFileName;
     char *outFileName;
+    char *objFileName;
+    char *prefix;
+};
+
+struct Config ConfigReader_ReadConfig(const char *filename, bool *ok);
+
+// A group.palette.h file. Its images have their tiles optimised together into one set of palette banks
+struct PaletteGroupConfig
+{
+    // The colour 0 of every bank. Each image's own transparent colour is replaced by this one
+    uint16_t transparentColour;
+    int solverTimeMs;
+    // Where the shared palette goes on the GBA. The images each have their own
+    enum OutputSection section;
+
+    // The config files of the images, from IMAGES=a.png.h b.aseprite.h relative to the group file
+    int nImages;
+    char **imageConfigFileNames;
+
+    char *outFileName;
+    char *objFileName;
+    char *prefix;
+};
+
+bool ConfigReader_IsPaletteGroup(const char *filename);
+struct PaletteGroupConfig ConfigReader_ReadPaletteGroupConfig(const char *filename, bool *ok);
+void ConfigReader_FreePaletteGroupConfig(struct PaletteGroupConfig config);
+
+// A map.tmx.h file, read by tmxtogba
+struct MapConfig
+{
+    // The pngtogba config of the tileset image, from TILESET=../images/tileset.png.h relative to the map config. The
+    // screen entries come from the TileRemap in its object file, so it needs DEDUPE=1
+    char *tilesetConfigFileName;
+    enum OutputSection section;
+    // METATILES=1 stores each layer as indices into a table of 2x2 tile blocks rather than as screen entries
+    bool metatiles;
+
+    char *mapFileName;
+    char *outFileName;
+    char *objFileName;
     char *prefix;
 };
 
-struct Config ConfigReader_ReadConfig(const char *filename, bool *ok);
\ No newline at end of file
+struct MapConfig ConfigReader_ReadMapConfig(const char *filename, bool *ok);
\ No newline at end of file
@@ -0,0 +1,619 @@
+#include "Converter.h"
+#include "Compression.h"
+#include "TileDeduplicator.h"
+#include "Aseprite.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+
+// The GBA refreshes every 280896 cycles of its 16.78MHz clock, about 59.73 times a second
+#define CYCLES_PER_SECOND 16777216
+#define CYCLES_PER_VBLANK 280896
+
+// Screen entries have 10 bits for the tile index
+#define MAX_SCREEN_ENTRY_TILES 1024
+
+static void fillPalette(uint16_t *paletteData, struct Palette16 *palette, uint16_t transparent);
+static int transparentPaletteIndex(struct Palette16 *palette, uint16_t colour, uint16_t transparent);
+
+struct PaletteOptimiser *Converter_OptimiserForImage(struct Image *img)
+{
+    return Converter_OptimiserForImages(&img, 1);
+}
+
+static int Converter_numTiles(struct Image *img)
+{
+    int tileSize = Image_TileSize(img);
+    return (Image_Width(img) / tileSize) * (Image_Height(img) / tileSize);
+}
+
+// Decodes img once, printing why if it couldn't be decoded. A bandFn which stops the decode prints its own reason
+static int Converter_forEachBand(struct Image *img, Image_BandFn *bandFn, void *user)
+{
+    int err = Image_ForEachBand(img, bandFn, user);
+    if (err && Image_Error(img) != NULL)
+    {
+        fprintf(stderr, "Error: %s\n", Image_Error(img));
+    }
+
+    return err;
+}
+
+struct Converter_optimiserPass
+{
+    struct PaletteOptimiser *optimiser;
+    int nImages;
+};
+
+// Adds the colours of each tile in the band to the optimiser as a palette of its own
+static int Converter_addTilePalettes(struct Image *img, void *user, const uint16_t *tiles, int tileY)
+{
+    struct Converter_optimiserPass *pass = user;
+    int tileSize = Image_TileSize(img);
+    int tilesX = Image_Width(img) / tileSize;
+    int tileLength = tileSize * tileSize;
+
+    for (int x = 0; x < tilesX; x++)
+    {
+        struct Palette16 *palette = Palette16_New();
+        assert(palette);
+
+        const uint16_t *colours = tiles + x * tileLength;
+        for (int i = 0; i < tileLength; i++)
+        {
+            if (Palette16_AddColour(palette, colours[i]) == PALETTE16_NUM_COLOURS)
+            {
+                fprintf(stderr, "Tile %d, %d contains more than %d colours! Set BPP=8 to use a single 256 colour palette\n", x, tileY, PALETTE16_NUM_COLOURS);
+                Palette16_Free(palette);
+                return 1;
+            }
+        }
+
+        int err = PaletteOptimiser_AddPalette(pass->optimiser, palette);
+        if (err)
+        {
+            fprintf(stderr, pass->nImages == 1 ? "Image contains more than 256 colours!\n" : "Images contain more than 256 colours between them!\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+struct PaletteOptimiser *Converter_OptimiserForImages(struct Image **imgs, int nImages)
+{
+    int nTiles = 0;
+    for (int image = 0; image < nImages; image++)
+    {
+        nTiles += Converter_numTiles(imgs[image]);
+    }
+
+    struct PaletteOptimiser *optimiser = PaletteOptimiser_New(nTiles);
+    assert(optimiser);
+
+    struct Converter_optimiserPass pass = {.optimiser = optimiser, .nImages = nImages};
+    for (int image = 0; image < nImages; image++)
+    {
+        if (Converter_forEachBand(imgs[image], Converter_addTilePalettes, &pass) != 0)
+        {
+            PaletteOptimiser_Free(optimiser);
+            return NULL;
+        }
+    }
+
+    return optimiser;
+}
+
+void Converter_GroupPalettesByImage(struct PaletteOptimisationResults results, struct Image **imgs, int nImages, int *bankOffset, int *bankCount)
+{
+    int *newBank = malloc(results.nPalettes * sizeof(int));
+    struct Palette16 **palettes = malloc(results.nPalettes * sizeof(struct Palette16 *));
+    assert(newBank && palettes);
+
+    for (int i = 0; i < results.nPalettes; i++)
+    {
+        newBank[i] = -1;
+    }
+
+    // banks are numbered in the order the tiles first use them, and the tiles are in image order
+    int nTiles = 0;
+    int nBanks = 0;
+    for (int image = 0; image < nImages; image++)
+    {
+        nTiles += Converter_numTiles(imgs[image]);
+    }
+
+    for (int t = 0; t < nTiles; t++)
+    {
+        int bank = results.paletteAssignment[t];
+        if (newBank[bank] == -1)
+        {
+            newBank[bank] = nBanks++;
+        }
+
+        results.paletteAssignment[t] = newBank[bank];
+    }
+
+    for (int i = 0; i < results.nPalettes; i++)
+    {
+        palettes[newBank[i]] = results.palettes[i];
+    }
+
+    memcpy(results.palettes, palettes, results.nPalettes * sizeof(struct Palette16 *));
+
+    int firstTile = 0;
+    for (int image = 0; image < nImages; image++)
+    {
+        int lowest = results.nPalettes;
+        int highest = -1;
+
+        for (int t = firstTile; t < firstTile + Converter_numTiles(imgs[image]); t++)
+        {
+            int bank = results.paletteAssignment[t];
+            lowest = bank < lowest ? bank : lowest;
+            highest = bank > highest ? bank : highest;
+        }
+
+        bankOffset[image] = highest == -1 ? 0 : lowest;
+        bankCount[image] = highest - bankOffset[image] + 1;
+        firstTile += Converter_numTiles(imgs[image]);
+    }
+
+    free(newBank);
+    free(palettes);
+}
+
+// tile is stored row by row, and is written as (tileSize / 8)^2 8x8 tiles in row major order.
+// At 4bpp each row of 8 pixels is one word, at 8bpp it is two. The first pixel is in the lowest bits
+static void encodeTile(uint32_t *tileData, const uint8_t *tile, int tileSize, int bitsPerPixel)
+{
+    int pixelsPerWord = 32 / bitsPerPixel;
+
+    for (int innerY = 0; innerY < tileSize / 8; innerY++)
+    {
+        for (int innerX = 0; innerX < tileSize / 8; innerX++)
+        {
+            for (int j = innerY * 8; j < innerY * 8 + 8; j++)
+            {
+                for (int word = innerX * 8; word < innerX * 8 + 8; word += pixelsPerWord)
+                {
+                    uint32_t row = 0;
+
+                    for (int i = word + pixelsPerWord - 1; i >= word; i--)
+                    {
+                        row = (row << bitsPerPixel) | tile[j * tileSize + i];
+                    }
+
+                    *tileData++ = row;
+                }
+            }
+        }
+    }
+}
+
+// Compresses the little endian bytes of data. The stream is stored as words too since the decompression
+// system calls need it word aligned
+static void addCompressedArray(struct Output *output, const char *name, enum CompressionType compression, const uint32_t *data, int length)
+{
+    uint8_t *bytes = malloc((size_t)length * 4);
+    assert(bytes);
+
+    for (int i = 0; i < length; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            bytes[i * 4 + j] = data[i] >> (j * 8);
+        }
+    }
+
+    int compressedLength;
+    uint8_t *compressed = Compression_Compress(compression, bytes, length * 4, &compressedLength);
+    assert(compressed);
+
+    uint32_t *words = malloc(compressedLength);
+    assert(words);
+
+    for (int i = 0; i < compressedLength / 4; i++)
+    {
+        words[i] = compressed[i * 4] | (compressed[i * 4 + 1] << 8) | (compressed[i * 4 + 2] << 16) | ((uint32_t)compressed[i * 4 + 3] << 24);
+    }
+
+    Output_AddArray(output, name, OutputType_U32, words, compressedLength / 4, 8);
+
+    free(words);
+    free(compressed);
+    free(bytes);
+}
+
+static struct IndexedTiles *Converter_newIndexedTiles(struct Image *img)
+{
+    struct IndexedTiles *indexed = calloc(1, sizeof(struct IndexedTiles));
+    assert(indexed);
+
+    indexed->tileSize = Image_TileSize(img);
+    indexed->nTiles = (Image_Width(img) / indexed->tileSize) * (Image_Height(img) / indexed->tileSize);
+    indexed->tiles = malloc((size_t)indexed->nTiles * indexed->tileSize * indexed->tileSize);
+    indexed->paletteNumbers = calloc(indexed->nTiles, sizeof(int));
+    assert(indexed->tiles && indexed->paletteNumbers);
+
+    return indexed;
+}
+
+void Converter_FreeIndexedTiles(struct IndexedTiles *indexed)
+{
+    if (indexed == NULL)
+    {
+        return;
+    }
+
+    free(indexed->tiles);
+    free(indexed->paletteNumbers);
+    free(indexed);
+}
+
+struct Converter_indexPass
+{
+    struct IndexedTiles *indexed;
+    uint16_t transparent;
+
+    // 4bpp
+    struct PaletteOptimisationResults results;
+    // 8bpp, indexed by colour. used is filled in by the first pass and indices read by the second
+    bool *used;
+    const uint8_t *indices;
+};
+
+static int Converter_indexBand4bpp(struct Image *img, void *user, const uint16_t *tiles, int tileY)
+{
+    struct Converter_indexPass *pass = user;
+    struct IndexedTiles *indexed = pass->indexed;
+    int tilesX = Image_Width(img) / indexed->tileSize;
+    int tileLength = indexed->tileSize * indexed->tileSize;
+
+    for (int x = 0; x < tilesX; x++)
+    {
+        int t = tileY * tilesX + x;
+        struct Palette16 *palette = pass->results.palettes[pass->results.paletteAssignment[t]];
+        uint8_t *tile = indexed->tiles + (size_t)t * tileLength;
+        const uint16_t *colours = tiles + x * tileLength;
+
+        indexed->paletteNumbers[t] = pass->results.paletteAssignment[t];
+
+        for (int i = 0; i < tileLength; i++)
+        {
+            tile[i] = transparentPaletteIndex(palette, colours[i], pass->transparent);
+        }
+    }
+
+    return 0;
+}
+
+struct IndexedTiles *Converter_IndexTiles4bpp(struct Image *img, struct PaletteOptimisationResults results, uint16_t transparent)
+{
+    struct IndexedTiles *indexed = Converter_newIndexedTiles(img);
+
+    for (int i = 0; i < results.nPalettes; i++)
+    {
+        fillPalette(indexed->paletteData + i * PALETTE16_NUM_COLOURS, results.palettes[i], transparent);
+    }
+
+    struct Converter_indexPass pass = {.indexed = indexed, .transparent = transparent, .results = results};
+    if (Converter_forEachBand(img, Converter_indexBand4bpp, &pass) != 0)
+    {
+        Converter_FreeIndexedTiles(indexed);
+        return NULL;
+    }
+
+    return indexed;
+}
+
+static int Converter_markUsedColours(struct Image *img, void *user, const uint16_t *tiles, int tileY)
+{
+    (void)tileY;
+    struct Converter_indexPass *pass = user;
+
+    for (size_t i = 0; i < (size_t)Image_Width(img) * Image_TileSize(img); i++)
+    {
+        pass->used[tiles[i]] = true;
+    }
+
+    return 0;
+}
+
+static int Converter_indexBand8bpp(struct Image *img, void *user, const uint16_t *tiles, int tileY)
+{
+    struct Converter_indexPass *pass = user;
+    struct IndexedTiles *indexed = pass->indexed;
+    size_t bandLength = (size_t)Image_Width(img) * indexed->tileSize;
+
+    // the band's tiles go in the same order as the indexed tiles
+    uint8_t *band = indexed->tiles + tileY * bandLength;
+
+    for (size_t i = 0; i < bandLength; i++)
+    {
+        band[i] = tiles[i] == pass->transparent ? 0 : pass->indices[tiles[i]];
+    }
+
+    return 0;
+}
+
+// Builds a single 256 colour palette in numerical order. Index 0 is always transparent on the GBA, so it holds the
+// transparent colour and the rest start at 1. Returns NULL if there are too many colours or the image can't be decoded
+struct IndexedTiles *Converter_IndexTiles8bpp(struct Image *img, uint16_t transparent)
+{
+    struct IndexedTiles *indexed = Converter_newIndexedTiles(img);
+    uint16_t *paletteData = indexed->paletteData;
+
+    bool *used = calloc(INVALID_COLOUR, sizeof(bool));
+    uint8_t *indices = malloc(INVALID_COLOUR);
+    assert(used && indices);
+
+    struct Converter_indexPass pass = {.indexed = indexed, .transparent = transparent, .used = used, .indices = indices};
+    if (Converter_forEachBand(img, Converter_markUsedColours, &pass) != 0)
+    {
+        goto error;
+    }
+
+    int nColours = 1;
+    paletteData[0] = transparent == INVALID_COLOUR ? 0 : transparent;
+
+    for (int colour = 0; colour < INVALID_COLOUR; colour++)
+    {
+        if (!used[colour] || colour == transparent)
+        {
+            continue;
+        }
+
+        if (nColours == 256)
+        {
+            fprintf(stderr, "Image contains more than 255 colours as well as the transparent one!\n");
+            goto error;
+        }
+
+        indices[colour] = nColours;
+        paletteData[nColours++] = colour;
+    }
+
+    if (Converter_forEachBand(img, Converter_indexBand8bpp, &pass) != 0)
+    {
+        goto error;
+    }
+
+    free(used);
+    free(indices);
+    return indexed;
+
+error:
+    free(used);
+    free(indices);
+    Converter_FreeIndexedTiles(indexed);
+    return NULL;
+}
+
+struct Output *Converter_BuildOutput(struct IndexedTiles *indexed, struct Config *config)
+{
+    struct Output *output = Output_New(config->prefix);
+    Output_SetSection(output, config->section);
+
+    int tileSize = indexed->tileSize;
+    int tileLength = tileSize * tileSize;
+    int nTiles = indexed->nTiles;
+    const uint8_t *tiles = indexed->tiles;
+    const int *paletteNumbers = indexed->paletteNumbers;
+    const uint16_t *paletteData = indexed->paletteData;
+
+    // images in a palette group share the group's palette instead
+    if (!config->sharedPalette)
+    {
+        Output_AddArray(output, "PaletteData", OutputType_U16, paletteData, 256, PALETTE16_NUM_COLOURS);
+    }
+
+    struct TileDeduplicationResults dedupe = {0};
+    int nOutputTiles = nTiles;
+    if (config->dedupe)
+    {
+        dedupe = TileDeduplicator_Deduplicate(tiles, paletteNumbers, nTiles, tileSize);
+        nOutputTiles = dedupe.nUniqueTiles;
+
+        // any more and the tile index of the TileRemap would run into the flip and palette bits
+        if (nOutputTiles > MAX_SCREEN_ENTRY_TILES)
+        {
+            fprintf(stderr, "%d unique tiles after deduplication, but screen entries can only use %d\n", nOutputTiles, MAX_SCREEN_ENTRY_TILES);
+            TileDeduplicator_FreeResults(dedupe);
+            Output_Free(output);
+            return NULL;
+        }
+    }
+
+    // Each 8x8 tile is 8 words at 4bpp or 16 at 8bpp, one or two per row of pixels
+    int subTilesPerTile = (tileSize / 8) * (tileSize / 8);
+    int wordsPerTile = subTilesPerTile * 2 * config->bitsPerPixel;
+    uint32_t *tileData = malloc((size_t)nOutputTiles * wordsPerTile * sizeof(uint32_t));
+    assert(tileData);
+
+    for (int i = 0; i < nOutputTiles; i++)
+    {
+        int sourceTile = config->dedupe ? dedupe.uniqueTiles[i] : i;
+        encodeTile(tileData + i * wordsPerTile, tiles + (size_t)sourceTile * tileLength, tileSize, config->bitsPerPixel);
+    }
+
+    int tileDataLength = nOutputTiles * wordsPerTile;
+    if (config->compression == CompressionType_None)
+    {
+        Output_AddArray(output, "TileData", OutputType_U32, tileData, tileDataLength, wordsPerTile);
+    }
+    else
+    {
+        addCompressedArray(output, "TileData", config->compression, tileData, tileDataLength);
+    }
+
+    // Always the uncompressed length, which is how much space the tiles need in VRAM
+    Output_AddValue(output, "TileDataLength", OutputType_Int, tileDataLength * sizeof(uint32_t));
+
+    // there are only 16 banks
+    uint8_t *narrowPaletteNumbers = malloc(nTiles > 0 ? nTiles : 1);
+    assert(narrowPaletteNumbers);
+
+    for (int i = 0; i < nTiles; i++)
+    {
+        narrowPaletteNumbers[i] = paletteNumbers[i];
+    }
+
+    Output_AddArray(output, "TilePaletteNumber", OutputType_U8, narrowPaletteNumbers, nTiles, 16);
+    free(narrowPaletteNumbers);
+
+    if (config->dedupe)
+    {
+        // GBA screen entry format: tile index in bits 0-9, hflip in 10, vflip in 11 and palette bank in 12-15.
+        // In 8bpp mode the tile index counts 64 byte tiles and the palette bank is ignored
+        uint16_t *remap = malloc(nTiles * sizeof(uint16_t));
+        assert(remap);
+
+        for (int i = 0; i < nTiles; i++)
+        {
+            remap[i] = (dedupe.remapTile[i] * subTilesPerTile) |
+                       (dedupe.remapFlip[i] << 10) |
+                       (paletteNumbers[i] << 12);
+        }
+
+        Output_AddArray(output, "TileRemap", OutputType_U16, remap, nTiles, 16);
+        free(remap);
+
+        TileDeduplicator_FreeResults(dedupe);
+    }
+
+    free(tileData);
+    return output;
+}
+
+int *Converter_DedupeFrames(struct IndexedTiles *indexed, struct Image *img)
+{
+    struct Aseprite *ase = Image_Aseprite(img);
+    int nFrames = Aseprite_NumFrames(ase);
+
+    int tileSize = indexed->tileSize;
+    int tilesPerFrame = (Aseprite_Width(ase) / tileSize) * (Aseprite_Height(ase) / tileSize);
+    size_t frameBytes = (size_t)tilesPerFrame * tileSize * tileSize;
+
+    int *frameMap = malloc(nFrames * sizeof(int));
+    assert(frameMap);
+
+    int nUniqueFrames = 0;
+
+    for (int frame = 0; frame < nFrames; frame++)
+    {
+        const uint8_t *tiles = indexed->tiles + frame * frameBytes;
+        const int *paletteNumbers = indexed->paletteNumbers + frame * tilesPerFrame;
+
+        frameMap[frame] = -1;
+        for (int unique = 0; unique < nUniqueFrames && frameMap[frame] == -1; unique++)
+        {
+            if (memcmp(indexed->tiles + unique * frameBytes, tiles, frameBytes) == 0 &&
+                memcmp(indexed->paletteNumbers + unique * tilesPerFrame, paletteNumbers, tilesPerFrame * sizeof(int)) == 0)
+            {
+                frameMap[frame] = unique;
+            }
+        }
+
+        if (frameMap[frame] != -1)
+        {
+            continue;
+        }
+
+        // unique frames are moved down over the duplicates, which are always earlier
+        memmove(indexed->tiles + nUniqueFrames * frameBytes, tiles, frameBytes);
+        memmove(indexed->paletteNumbers + nUniqueFrames * tilesPerFrame, paletteNumbers, tilesPerFrame * sizeof(int));
+        frameMap[frame] = nUniqueFrames++;
+    }
+
+    indexed->nTiles = nUniqueFrames * tilesPerFrame;
+    return frameMap;
+}
+
+void Converter_AddAnimation(struct Output *output, struct Image *img, struct Config *config, const int *frameMap)
+{
+    struct Aseprite *ase = Image_Aseprite(img);
+    int nFrames = Aseprite_NumFrames(ase);
+
+    int tileSize = Image_TileSize(img);
+    int subTilesPerTile = (tileSize / 8) * (tileSize / 8);
+    int tilesPerFrame = (Aseprite_Width(ase) / tileSize) * (Aseprite_Height(ase) / tileSize);
+
+    // sprite tile numbers always count 32 byte 4bpp tiles, even for 8bpp sprites
+    int objectTilesPerFrame = tilesPerFrame * subTilesPerTile * config->bitsPerPixel / 4;
+
+    uint16_t *frameTile = malloc(nFrames * sizeof(uint16_t));
+    uint16_t *frameDuration = malloc(nFrames * sizeof(uint16_t));
+    assert(frameTile && frameDuration);
+
+    for (int frame = 0; frame < nFrames; frame++)
+    {
+        frameTile[frame] = frameMap[frame] * objectTilesPerFrame;
+
+        // rounded to the nearest VBlank, but never 0 so that every frame is shown
+        int64_t cycles = (int64_t)Aseprite_FrameDuration(ase, frame) * CYCLES_PER_SECOND / 1000;
+        int vblanks = (cycles + CYCLES_PER_VBLANK / 2) / CYCLES_PER_VBLANK;
+        frameDuration[frame] = vblanks > 0 ? vblanks : 1;
+    }
+
+    Output_AddValue(output, "FrameCount", OutputType_Int, nFrames);
+    Output_AddValue(output, "FrameLength", OutputType_Int, objectTilesPerFrame * 32);
+    Output_AddArray(output, "FrameTile", OutputType_U16, frameTile, nFrames, 16);
+    Output_AddArray(output, "FrameDuration", OutputType_U16, frameDuration, nFrames, 16);
+
+    for (int tag = 0; tag < Aseprite_NumTags(ase); tag++)
+    {
+        char *start = Output_SymbolName(Aseprite_TagName(ase, tag), "Start");
+        char *end = Output_SymbolName(Aseprite_TagName(ase, tag), "End");
+
+        Output_AddValue(output, start, OutputType_Int, Aseprite_TagFrom(ase, tag));
+        Output_AddValue(output, end, OutputType_Int, Aseprite_TagTo(ase, tag) + 1);
+
+        free(start);
+        free(end);
+    }
+
+    free(frameTile);
+    free(frameDuration);
+}
+
+static int transparentPaletteIndex(struct Palette16 *palette, uint16_t colour, uint16_t transparent)
+{
+    if (colour == transparent)
+    {
+        return 0;
+    }
+
+    int index = Palette16_GetIndex(palette, colour);
+    if (colour < transparent)
+    {
+        return index + 1;
+    }
+
+    return index;
+}
+
+static void fillPalette(uint16_t *paletteData, struct Palette16 *palette, uint16_t transparent)
+{
+    int n = 0;
+
+    if (transparent != INVALID_COLOUR)
+    {
+        paletteData[n++] = transparent;
+    }
+
+    for (int j = 0; j < Palette16_GetNumColours(palette); j++)
+    {
+        uint16_t colour = Palette16_GetColour(palette, j);
+        if (colour == transparent)
+        {
+            continue;
+        }
+
+        paletteData[n++] = colour;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Image.h"
+#include "PaletteOptimiser.h"
+#include "ConfigReader.h"
+#include "Output.h"
+
+#include <stdint.h>
+
+// The stages of turning an Image into an Output, shared by pngtogba and its benchmark
+
+// Every tile of an image as colour indices into its palette
+struct IndexedTiles
+{
+    int nTiles;
+    int tileSize;
+
+    // tileSize * tileSize colour indices per tile, row by row
+    uint8_t *tiles;
+    // The palette bank of each tile, always 0 in 8bpp mode
+    int *paletteNumbers;
+    uint16_t paletteData[256];
+};
+
+// Returns NULL if any tile has too many colours, the whole image has more than 256 or it couldn't be decoded, after
+// printing why
+struct PaletteOptimiser *Converter_OptimiserForImage(struct Image *img);
+// The same for the tiles of several images, one image after the other, so that they can share palettes
+struct PaletteOptimiser *Converter_OptimiserForImages(struct Image **imgs, int nImages);
+// For results from Converter_OptimiserForImages. Renumbers the palettes in the order the images first use them, so
+// each image's banks are together unless it shares some with an earlier image. Fills in the lowest bank each image
+// uses and how many banks from there it spans
+void Converter_GroupPalettesByImage(struct PaletteOptimisationResults results, struct Image **imgs, int nImages, int *bankOffset, int *bankCount);
+
+// Both decode the image again, so they return NULL if it couldn't be decoded, after printing why
+struct IndexedTiles *Converter_IndexTiles4bpp(struct Image *img, struct PaletteOptimisationResults results, uint16_t transparent);
+// One 256 colour palette for the whole image, which takes two passes over it. Also returns NULL if there are too
+// many colours, after printing why
+struct IndexedTiles *Converter_IndexTiles8bpp(struct Image *img, uint16_t transparent);
+void Converter_FreeIndexedTiles(struct IndexedTiles *indexed);
+
+// Encodes, deduplicates and compresses the tiles according to config. Returns NULL if deduplication leaves more tiles
+// than a screen entry can refer to, after printing why
+struct Output *Converter_BuildOutput(struct IndexedTiles *indexed, struct Config *config);
+
+// For images from aseprite files. Every frame is a run of tiles, so frames whose tiles and palettes are identical
+// can share one copy: this removes the later copies from indexed and returns a malloc'd map from each frame to the
+// copy it uses. Call before Converter_BuildOutput
+int *Converter_DedupeFrames(struct IndexedTiles *indexed, struct Image *img);
+
+// For images from aseprite files, adds
+//   FrameCount
+//   FrameLength: the bytes of tile data in each frame
+//   FrameTile[frame]: the first tile of the frame in TileData, counting 32 byte sprite tiles like ObjectAttribute_SetTile
+//   FrameDuration[frame]: how many VBlanks to show the frame for
+//   <Tag>Start and <Tag>End: the frames of each tag, end exclusive. "Walk down" becomes WalkDownStart and WalkDownEnd
+//
+// With TILESIZE the frame width, each frame's tiles are in 1D sprite mapping order so they can be streamed into VRAM
+// with one copy of FrameLength bytes
+void Converter_AddAnimation(struct Output *output, struct Image *img, struct Config *config, const int *frameMap);
@@ -2,68 +2,116 @@
 
 #include "Image.h"
 
+#include "Aseprite.h"
 #include "spng/spng.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 
 struct Image
 {
-    size_t bufferLen;
-    unsigned char *buffer;
+    // Only the header is read up front, and Image_ForEachBand decodes the file again from the start each time
+    char *filename;
 
     uint32_t width;
     uint32_t height;
+    uint32_t tileSize;
+
+    // Set by Image_ReplaceColour, and applied to every band as it is decoded
+    bool replacing;
+    uint16_t replaceFrom;
+    uint16_t replaceTo;
+
+    // NULL unless the image came from Image_NewAseprite
+    struct Aseprite *aseprite;
+    // Aseprite pixels less than half opaque become this
+    uint16_t transparentColour;
 
     char *error;
 };
 
-struct Image *Image_New(const char *filename)
+// The row of tiles being decoded by Image_ForEachBand
+struct ImageBand
 {
-    char *pngBuffer = NULL;
-    FILE *png = NULL;
-    spng_ctx *ctx = NULL;
+    struct Image *img;
+    // One rgb15 colour per pixel, tile by tile with each tile stored row by row, so that a tile's pixels are
+    // contiguous
+    uint16_t *tiles;
+
+    Image_BandFn *bandFn;
+    void *user;
+    // What bandFn returned if it stopped the decode, otherwise 0
+    int stopped;
+};
 
-    struct Image *img = calloc(1, sizeof(struct Image));
-    if (img == NULL)
-    {
-        goto error;
-    }
+static int Image_readPng(spng_ctx *ctx, void *user, void *dest, size_t length)
+{
+    (void)ctx;
+    FILE *png = user;
 
-    png = fopen(filename, "rb");
-    if (png == NULL)
+    if (fread(dest, 1, length, png) != length)
     {
-        asprintf(&img->error, "Failed to open file %s", filename);
-        goto error;
+        return feof(png) ? SPNG_IO_EOF : SPNG_IO_ERROR;
     }
 
-    fseek(png, 0, SEEK_END);
-    long pngBufferSize = ftell(png);
-    rewind(png);
+    return 0;
+}
 
-    if (pngBufferSize < 1)
+// Converts one row of RGBA8 pixels into the band, and hands the band over once its last row is in. If
+// transparentColour isn't negative, pixels less than half opaque become it. Returns non-zero if bandFn stopped
+static int Image_storeRgbaRow(struct ImageBand *band, const unsigned char *row, uint32_t rowIndex, int transparentColour)
+{
+    struct Image *img = band->img;
+    uint32_t tileSize = img->tileSize;
+    uint32_t tilesX = img->width / tileSize;
+
+    // the row within each tile of the band
+    uint16_t *target = band->tiles + (rowIndex % tileSize) * tileSize;
+
+    for (uint32_t tileX = 0; tileX < tilesX; tileX++)
     {
-        asprintf(&img->error, "Loading png file %s failed", filename);
-        goto error;
+        for (uint32_t i = 0; i < tileSize; i++)
+        {
+            const unsigned char *pixel = row + (tileX * tileSize + i) * 4;
+            struct Colour c = {.r = pixel[0], .g = pixel[1], .b = pixel[2], .a = pixel[3]};
+            uint16_t colour = transparentColour >= 0 && c.a < 128 ? transparentColour : rgb15(c);
+
+            target[i] = img->replacing && colour == img->replaceFrom ? img->replaceTo : colour;
+        }
+
+        target += tileSize * tileSize;
     }
 
-    pngBuffer = malloc(pngBufferSize);
-    if (pngBuffer == NULL)
+    if (rowIndex % tileSize == tileSize - 1)
     {
-        asprintf(&img->error, "Failed to allocate buffer for png file %s", filename);
-        goto error;
+        band->stopped = band->bandFn(img, band->user, band->tiles, rowIndex / tileSize);
     }
 
-    if (fread(pngBuffer, pngBufferSize, 1, png) != 1)
+    return band->stopped;
+}
+
+static int Image_storeRow(spng_ctx *ctx, void *user, const unsigned char *row, uint32_t rowIndex)
+{
+    (void)ctx;
+
+    // PNGs mark transparency with the transparent colour itself, so alpha is ignored
+    return Image_storeRgbaRow(user, row, rowIndex, -1);
+}
+
+// Returns NULL after setting the error if the PNG couldn't be opened. Otherwise *png must be closed after the context
+// is freed
+static spng_ctx *Image_openPng(struct Image *img, FILE **png)
+{
+    *png = fopen(img->filename, "rb");
+    if (*png == NULL)
     {
-        asprintf(&img->error, "Failed to read png file to buffer %s", filename);
-        goto error;
+        asprintf(&img->error, "Failed to open file %s", img->filename);
+        return NULL;
     }
 
-    fclose(png);
-    png = NULL;
-
-    ctx = spng_ctx_new(0);
+    spng_ctx *ctx = spng_ctx_new(0);
     if (ctx == NULL)
     {
         asprintf(&img->error, "Failed to create png context");
@@ -77,61 +125,171 @@ struct Image *Image_New(const char *filename)
         goto error;
     }
 
-    err = spng_set_png_buffer(ctx, pngBuffer, pngBufferSize);
+    // the compressed data is read as it is needed rather than loaded up front
+    err = spng_set_png_stream(ctx, Image_readPng, *png);
     if (err)
     {
-        asprintf(&img->error, "Failed to set png buffer: %s", spng_strerror(err));
+        asprintf(&img->error, "Failed to set png stream: %s", spng_strerror(err));
         goto error;
     }
 
-    err = spng_decoded_image_size(ctx, SPNG_FMT_RGBA8, &img->bufferLen);
-    if (err)
+    return ctx;
+
+error:
+    spng_ctx_free(ctx);
+    fclose(*png);
+    *png = NULL;
+
+    return NULL;
+}
+
+struct Image *Image_New(const char *filename, int tileSize)
+{
+    struct Image *img = calloc(1, sizeof(struct Image));
+    if (img == NULL)
     {
-        asprintf(&img->error, "Failed to get decoded image size: %s", spng_strerror(err));
-        goto error;
+        return NULL;
+    }
+
+    img->filename = strdup(filename);
+    img->tileSize = tileSize;
+    assert(img->filename);
+
+    FILE *png;
+    spng_ctx *ctx = Image_openPng(img, &png);
+    if (ctx == NULL)
+    {
+        return img;
     }
 
     struct spng_ihdr ihdr;
-    err = spng_get_ihdr(ctx, &ihdr);
+    int err = spng_get_ihdr(ctx, &ihdr);
     if (err)
     {
         asprintf(&img->error, "Failed to get IHDR: %s", spng_strerror(err));
-        goto error;
     }
+    else
+    {
+        img->width = ihdr.width;
+        img->height = ihdr.height;
+
+        if (tileSize <= 0 || img->width % tileSize != 0 || img->height % tileSize != 0)
+        {
+            asprintf(&img->error, "Image width or height not a multiple of the tile size");
+        }
+    }
+
+    spng_ctx_free(ctx);
+    fclose(png);
 
-    img->width = ihdr.width;
-    img->height = ihdr.height;
+    return img;
+}
 
-    img->buffer = malloc(img->bufferLen);
-    if (img->buffer == NULL)
+struct Image *Image_NewAseprite(const char *filename, int tileSize, uint16_t transparentColour)
+{
+    struct Image *img = calloc(1, sizeof(struct Image));
+    if (img == NULL)
     {
-        asprintf(&img->error, "Failed to allocate buffer for decoded image data");
-        goto error;
+        return NULL;
     }
 
-    err = spng_decode_image(ctx, img->buffer, img->bufferLen, SPNG_FMT_RGBA8, 0);
-    if (err)
+    img->filename = strdup(filename);
+    img->tileSize = tileSize;
+    img->transparentColour = transparentColour;
+    assert(img->filename);
+
+    img->aseprite = Aseprite_New(filename);
+    if (img->aseprite == NULL || Aseprite_Error(img->aseprite) != NULL)
     {
-        asprintf(&img->error, "Failed to decode image: %s", spng_strerror(err));
-        goto error;
+        asprintf(&img->error, "%s", img->aseprite ? Aseprite_Error(img->aseprite) : "Failed to allocate aseprite");
+        return img;
     }
 
-    spng_ctx_free(ctx);
-    free(pngBuffer);
+    struct Aseprite *ase = img->aseprite;
+    int frameHeight = Aseprite_Height(ase);
+
+    img->width = Aseprite_Width(ase);
+    img->height = frameHeight * Aseprite_NumFrames(ase);
+
+    // a band never spans two frames, so each frame only has to be rendered once per pass
+    if (tileSize <= 0 || img->width % tileSize != 0 || frameHeight % tileSize != 0 || img->height == 0)
+    {
+        asprintf(&img->error, "Frame width or height not a multiple of the tile size");
+    }
 
     return img;
+}
 
-error:
-    if (png != NULL)
+static int Image_decodePng(struct ImageBand *band)
+{
+    struct Image *img = band->img;
+
+    FILE *png;
+    spng_ctx *ctx = Image_openPng(img, &png);
+    if (ctx == NULL)
     {
-        fclose(png);
+        return 1;
+    }
+
+    int err = spng_decode_rows(ctx, SPNG_FMT_RGBA8, 0, Image_storeRow, band);
+    if (err && !band->stopped)
+    {
+        asprintf(&img->error, "Failed to decode image: %s", spng_strerror(err));
     }
 
     spng_ctx_free(ctx);
+    fclose(png);
 
-    free(pngBuffer);
-    free(img->buffer);
-    return img;
+    return err;
+}
+
+static int Image_decodeAseprite(struct ImageBand *band)
+{
+    struct Image *img = band->img;
+    struct Aseprite *ase = img->aseprite;
+    int frameHeight = Aseprite_Height(ase);
+
+    uint8_t *rgba = malloc((size_t)img->width * frameHeight * 4);
+    if (rgba == NULL)
+    {
+        asprintf(&img->error, "Failed to allocate a frame of decoded image data");
+        return 1;
+    }
+
+    int err = 0;
+    for (int frame = 0; frame < Aseprite_NumFrames(ase) && !err; frame++)
+    {
+        if (Aseprite_RenderFrame(ase, frame, rgba) != 0)
+        {
+            asprintf(&img->error, "Failed to render frame %d: %s", frame, Aseprite_Error(ase));
+            err = 1;
+        }
+
+        for (int y = 0; y < frameHeight && !err; y++)
+        {
+            err = Image_storeRgbaRow(band, rgba + (size_t)y * img->width * 4, frame * frameHeight + y, img->transparentColour);
+        }
+    }
+
+    free(rgba);
+    return err;
+}
+
+int Image_ForEachBand(struct Image *img, Image_BandFn *bandFn, void *user)
+{
+    struct ImageBand band = {.img = img, .bandFn = bandFn, .user = user};
+
+    band.tiles = malloc((size_t)img->width * img->tileSize * sizeof(uint16_t));
+    if (band.tiles == NULL)
+    {
+        asprintf(&img->error, "Failed to allocate a band of decoded image data");
+        return 1;
+    }
+
+    int err = img->aseprite != NULL ? Image_decodeAseprite(&band) : Image_decodePng(&band);
+    free(band.tiles);
+
+    return band.stopped ? band.stopped : err;
 }
 
 char *Image_Error(struct Image *img)
@@ -141,8 +299,9 @@ char *Image_Error(struct Image *img)
 
 void Image_Free(struct Image *img)
 {
+    Aseprite_Free(img->aseprite);
     free(img->error);
-    free(img->buffer);
+    free(img->filename);
     free(img);
 }
 
@@ -156,19 +315,48 @@ int Image_Height(struct Image *img)
     return img->height;
 }
 
-struct Colour Image_Colour(struct Image *img, int x, int y)
+int Image_TileSize(struct Image *img)
+{
+    return img->tileSize;
+}
+
+struct Aseprite *Image_Aseprite(struct Image *img)
+{
+    return img->aseprite;
+}
+
+static int Image_findColour(struct Image *img, void *user, const uint16_t *tiles, int tileY)
+{
+    (void)tileY;
+    uint16_t colour = *(uint16_t *)user;
+
+    for (size_t i = 0; i < (size_t)img->width * img->tileSize; i++)
+    {
+        if (tiles[i] == colour)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int Image_ReplaceColour(struct Image *img, uint16_t from, uint16_t to)
 {
-    assert(0 <= x && x < Image_Width(img));
-    assert(0 <= y && y < Image_Height(img));
+    if (from == to)
+    {
+        return 0;
+    }
 
-    int baseIndex = (y * Image_Width(img) + x) * 4;
-    assert((size_t)baseIndex + 4 <= img->bufferLen);
+    // nothing is stored to change, so this only has to check the image doesn't use to already
+    if (Image_ForEachBand(img, Image_findColour, &to) != 0)
+    {
+        return 1;
+    }
 
-    struct Colour colour = {
-        .r = img->buffer[baseIndex],
-        .g = img->buffer[baseIndex + 1],
-        .b = img->buffer[baseIndex + 2],
-        .a = img->buffer[baseIndex + 3]};
+    img->replacing = true;
+    img->replaceFrom = from;
+    img->replaceTo = to;
 
-    return colour;
-}
\ No newline at end of file
+    return 0;
+}
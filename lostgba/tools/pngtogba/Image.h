@@ -3,6 +3,7 @@
 #include <stdint.h>
 
 struct Image;
+struct Aseprite;
 
 struct Colour
 {
@@ -12,14 +13,39 @@ struct Colour
     uint8_t a;
 };
 
-struct Image *Image_New(const char *filename);
+// Images are decoded a row of tiles at a time rather than kept in memory, so that converting a 4096x4096 sheet needs
+// one 4096xTILESIZE band of colours rather than 64MB of RGBA8. Anything which needs every tile, like palette
+// optimisation followed by indexing, decodes the image once per pass with Image_ForEachBand.
+
+// Called by Image_ForEachBand for each row of tiles from the top. tiles holds the width / tileSize tiles of row
+// tileY one after the other, each tileSize * tileSize colours row by row and already converted with rgb15. It is
+// only valid until bandFn returns. Returning non-zero stops the decode
+typedef int Image_BandFn(struct Image *img, void *user, const uint16_t *tiles, int tileY);
+
+// Only reads the PNG header. The width and height of the image must be multiples of tileSize. Interlaced PNGs are
+// the exception to decoding a band at a time, since their rows aren't complete until the last pass, so spng decodes
+// them in full as RGBA8 on every Image_ForEachBand
+struct Image *Image_New(const char *filename, int tileSize);
+// Every frame of the aseprite file with the visible layers flattened, one under the other. Pixels which are
+// less than half opaque become transparentColour. The frame width and height must be multiples of tileSize.
+// The aseprite file stays in memory, and Image_ForEachBand renders one frame of RGBA8 at a time
+struct Image *Image_NewAseprite(const char *filename, int tileSize, uint16_t transparentColour);
 char *Image_Error(struct Image *img);
 void Image_Free(struct Image *img);
 
 int Image_Width(struct Image *img);
 int Image_Height(struct Image *img);
+int Image_TileSize(struct Image *img);
 
-struct Colour Image_Colour(struct Image *img, int x, int y);
+// Decodes the image from the start, calling bandFn with each row of tiles in turn. Returns whatever bandFn returned
+// if it stopped early, or non-zero with the reason in Image_Error if the image couldn't be decoded
+int Image_ForEachBand(struct Image *img, Image_BandFn *bandFn, void *user);
+// The file the image was read from, or NULL if it was a PNG
+struct Aseprite *Image_Aseprite(struct Image *img);
+// Changes every pixel of colour from to colour to from the next Image_ForEachBand on. Returns non-zero without
+// changing anything if the image already uses to, since the two could no longer be told apart, or if it couldn't be
+// decoded to check, in which case Image_Error says why
+int Image_ReplaceColour(struct Image *img, uint16_t from, uint16_t to);
 
 inline uint16_t rgb15(struct Colour c)
 {
@@ -0,0 +1,517 @@
+#include "Output.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <ctype.h>
+
+struct OutputSymbol
+{
+    char *name;
+    enum OutputType type;
+    bool isArray;
+
+    uint8_t *data;
+    int length;
+    int elementsPerLine;
+};
+
+struct Output
+{
+    char *prefix;
+    enum OutputSection section;
+
+    struct OutputSymbol *symbols;
+    int nSymbols;
+};
+
+static int Output_typeSize(enum OutputType type)
+{
+    switch (type)
+    {
+    case OutputType_U8:
+        return 1;
+    case OutputType_U16:
+        return 2;
+    case OutputType_U32:
+    case OutputType_Int:
+        return 4;
+    }
+
+    assert(0 && "Unknown output type");
+}
+
+static const char *Output_typeName(enum OutputType type)
+{
+    switch (type)
+    {
+    case OutputType_U8:
+        return "uint8_t";
+    case OutputType_U16:
+        return "uint16_t";
+    case OutputType_U32:
+        return "uint32_t";
+    case OutputType_Int:
+        return "int";
+    }
+
+    assert(0 && "Unknown output type");
+}
+
+// The name of the section in both the C and ELF output, matching the sections the devkitARM linker script copies
+// into RAM at boot
+static const char *Output_sectionName(enum OutputSection section)
+{
+    switch (section)
+    {
+    case OutputSection_Rom:
+        return ".rodata";
+    case OutputSection_Iwram:
+        return ".iwram";
+    case OutputSection_Ewram:
+        return ".ewram";
+    }
+
+    assert(0 && "Unknown output section");
+}
+
+struct Output *Output_New(const char *prefix)
+{
+    struct Output *output = calloc(1, sizeof(struct Output));
+    assert(output);
+
+    output->prefix = strdup(prefix);
+    assert(output->prefix);
+
+    return output;
+}
+
+void Output_Free(struct Output *output)
+{
+    if (output == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < output->nSymbols; i++)
+    {
+        free(output->symbols[i].name);
+        free(output->symbols[i].data);
+    }
+
+    free(output->symbols);
+    free(output->prefix);
+    free(output);
+}
+
+void Output_SetSection(struct Output *output, enum OutputSection section)
+{
+    output->section = section;
+}
+
+static struct OutputSymbol *Output_addSymbol(struct Output *output, const char *name, enum OutputType type, const void *data, int length)
+{
+    output->symbols = realloc(output->symbols, (output->nSymbols + 1) * sizeof(struct OutputSymbol));
+    assert(output->symbols);
+
+    struct OutputSymbol *symbol = &output->symbols[output->nSymbols++];
+
+    size_t nameLength = strlen(output->prefix) + strlen(name);
+    symbol->name = malloc(nameLength + 1);
+    assert(symbol->name);
+    strcpy(symbol->name, output->prefix);
+    strcat(symbol->name, name);
+
+    symbol->type = type;
+    symbol->length = length;
+
+    size_t dataSize = (size_t)length * Output_typeSize(type);
+    symbol->data = malloc(dataSize > 0 ? dataSize : 1);
+    assert(symbol->data);
+    memcpy(symbol->data, data, dataSize);
+
+    return symbol;
+}
+
+void Output_AddArray(struct Output *output, const char *name, enum OutputType type, const void *data, int length, int elementsPerLine)
+{
+    struct OutputSymbol *symbol = Output_addSymbol(output, name, type, data, length);
+    symbol->isArray = true;
+    symbol->elementsPerLine = elementsPerLine > 0 ? elementsPerLine : 16;
+}
+
+void Output_AddValue(struct Output *output, const char *name, enum OutputType type, uint32_t value)
+{
+    uint8_t data[4];
+    memcpy(data, &value, sizeof(data)); // the host and the GBA are both little endian
+
+    struct OutputSymbol *symbol = Output_addSymbol(output, name, type, data, 1);
+    symbol->isArray = false;
+}
+
+static uint32_t Output_element(struct OutputSymbol *symbol, int i)
+{
+    switch (Output_typeSize(symbol->type))
+    {
+    case 1:
+        return symbol->data[i];
+    case 2:
+    {
+        uint16_t value;
+        memcpy(&value, symbol->data + i * 2, sizeof(value));
+        return value;
+    }
+    default:
+    {
+        uint32_t value;
+        memcpy(&value, symbol->data + i * 4, sizeof(value));
+        return value;
+    }
+    }
+}
+
+static void Output_printElement(FILE *file, struct OutputSymbol *symbol, int i)
+{
+    uint32_t value = Output_element(symbol, i);
+
+    switch (symbol->type)
+    {
+    case OutputType_U8:
+        fprintf(file, "0x%02x", value);
+        break;
+    case OutputType_U16:
+        fprintf(file, "0x%04x", value);
+        break;
+    case OutputType_U32:
+        fprintf(file, "0x%08x", value);
+        break;
+    case OutputType_Int:
+        fprintf(file, "%d", (int32_t)value);
+        break;
+    }
+}
+
+int Output_WriteC(struct Output *output, FILE *file)
+{
+    fprintf(file, "#include <stdint.h>\n");
+
+    // const data goes in .rodata anyway
+    char attribute[64] = "";
+    if (output->section != OutputSection_Rom)
+    {
+        snprintf(attribute, sizeof(attribute), "__attribute__((section(\"%s\"))) ", Output_sectionName(output->section));
+    }
+
+    for (int i = 0; i < output->nSymbols; i++)
+    {
+        struct OutputSymbol *symbol = &output->symbols[i];
+
+        if (!symbol->isArray)
+        {
+            fprintf(file, "\n%sconst %s %s = ", attribute, Output_typeName(symbol->type), symbol->name);
+            Output_printElement(file, symbol, 0);
+            fprintf(file, ";\n");
+            continue;
+        }
+
+        // word aligned like the ELF output, so arrays of any type can be copied with DMA
+        fprintf(file, "\n%s__attribute__((aligned(4))) const %s %s[%d] = {", attribute, Output_typeName(symbol->type), symbol->name, symbol->length);
+
+        for (int j = 0; j < symbol->length; j++)
+        {
+            if (j % symbol->elementsPerLine == 0)
+            {
+                fprintf(file, "\n    ");
+            }
+
+            Output_printElement(file, symbol, j);
+            fprintf(file, ", ");
+        }
+
+        fprintf(file, "\n};\n");
+    }
+
+    return ferror(file);
+}
+
+// --- ELF output --------------------------------------------------------------
+//
+// A minimal ELF32 relocatable object with a single section holding every symbol,
+// .rodata unless the output is placed in RAM. Nothing in the data refers to
+// anything else, so no relocations are needed.
+
+#define ELF_HEADER_SIZE 52
+#define ELF_SECTION_HEADER_SIZE 40
+#define ELF_SYMBOL_SIZE 16
+
+#define ELF_SECTION_DATA 1
+#define ELF_SECTION_SYMTAB 2
+#define ELF_SECTION_STRTAB 3
+#define ELF_SECTION_SHSTRTAB 4
+#define ELF_NUM_SECTIONS 5
+
+#define EM_ARM 40
+#define EF_ARM_EABI_VER5 0x05000000
+
+#define SHT_PROGBITS 1
+#define SHT_SYMTAB 2
+#define SHT_STRTAB 3
+
+#define SHF_WRITE 0x1
+#define SHF_ALLOC 0x2
+
+#define STB_GLOBAL 1
+#define STT_OBJECT 1
+
+struct ByteBuffer
+{
+    uint8_t *data;
+    size_t length;
+};
+
+static void ByteBuffer_append(struct ByteBuffer *buffer, const void *data, size_t length)
+{
+    buffer->data = realloc(buffer->data, buffer->length + length);
+    assert(buffer->data);
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+}
+
+static void ByteBuffer_align(struct ByteBuffer *buffer, size_t alignment)
+{
+    static const uint8_t zeros[8] = {0};
+    if (buffer->length % alignment != 0)
+    {
+        ByteBuffer_append(buffer, zeros, alignment - buffer->length % alignment);
+    }
+}
+
+static void ByteBuffer_append16(struct ByteBuffer *buffer, uint16_t value)
+{
+    uint8_t bytes[2] = {value & 0xff, value >> 8};
+    ByteBuffer_append(buffer, bytes, sizeof(bytes));
+}
+
+static void ByteBuffer_append32(struct ByteBuffer *buffer, uint32_t value)
+{
+    uint8_t bytes[4] = {value & 0xff, (value >> 8) & 0xff, (value >> 16) & 0xff, value >> 24};
+    ByteBuffer_append(buffer, bytes, sizeof(bytes));
+}
+
+static uint32_t ByteBuffer_appendString(struct ByteBuffer *buffer, const char *string)
+{
+    uint32_t offset = buffer->length;
+    ByteBuffer_append(buffer, string, strlen(string) + 1);
+    return offset;
+}
+
+static void Output_elfSectionHeader(struct ByteBuffer *elf, uint32_t name, uint32_t type, uint32_t flags, uint32_t offset,
+                                    uint32_t size, uint32_t link, uint32_t info, uint32_t align, uint32_t entsize)
+{
+    ByteBuffer_append32(elf, name);
+    ByteBuffer_append32(elf, type);
+    ByteBuffer_append32(elf, flags);
+    ByteBuffer_append32(elf, 0); // sh_addr
+    ByteBuffer_append32(elf, offset);
+    ByteBuffer_append32(elf, size);
+    ByteBuffer_append32(elf, link);
+    ByteBuffer_append32(elf, info);
+    ByteBuffer_append32(elf, align);
+    ByteBuffer_append32(elf, entsize);
+}
+
+int Output_WriteElf(struct Output *output, FILE *file)
+{
+    struct ByteBuffer data = {0};
+    struct ByteBuffer symtab = {0};
+    struct ByteBuffer strtab = {0};
+    struct ByteBuffer shstrtab = {0};
+    struct ByteBuffer elf = {0};
+
+    ByteBuffer_appendString(&strtab, "");
+
+    // the first symbol is always the null symbol
+    static const uint8_t nullSymbol[ELF_SYMBOL_SIZE] = {0};
+    ByteBuffer_append(&symtab, nullSymbol, sizeof(nullSymbol));
+
+    for (int i = 0; i < output->nSymbols; i++)
+    {
+        struct OutputSymbol *symbol = &output->symbols[i];
+        uint32_t size = symbol->length * Output_typeSize(symbol->type);
+
+        ByteBuffer_align(&data, 4);
+        uint32_t value = data.length;
+        ByteBuffer_append(&data, symbol->data, size);
+
+        ByteBuffer_append32(&symtab, ByteBuffer_appendString(&strtab, symbol->name));
+        ByteBuffer_append32(&symtab, value);
+        ByteBuffer_append32(&symtab, size);
+        uint8_t info[2] = {(STB_GLOBAL << 4) | STT_OBJECT, 0};
+        ByteBuffer_append(&symtab, info, sizeof(info));
+        ByteBuffer_append16(&symtab, ELF_SECTION_DATA);
+    }
+
+    ByteBuffer_appendString(&shstrtab, "");
+    uint32_t dataName = ByteBuffer_appendString(&shstrtab, Output_sectionName(output->section));
+    uint32_t symtabName = ByteBuffer_appendString(&shstrtab, ".symtab");
+    uint32_t strtabName = ByteBuffer_appendString(&shstrtab, ".strtab");
+    uint32_t shstrtabName = ByteBuffer_appendString(&shstrtab, ".shstrtab");
+
+    uint32_t dataOffset = ELF_HEADER_SIZE;
+    uint32_t symtabOffset = dataOffset + data.length + (4 - data.length % 4) % 4;
+    uint32_t strtabOffset = symtabOffset + symtab.length;
+    uint32_t shstrtabOffset = strtabOffset + strtab.length;
+    uint32_t sectionHeaderOffset = shstrtabOffset + shstrtab.length + (4 - (shstrtabOffset + shstrtab.length) % 4) % 4;
+
+    // ELF header
+    static const uint8_t ident[16] = {0x7f, 'E', 'L', 'F', 1 /* 32 bit */, 1 /* little endian */, 1 /* version */};
+    ByteBuffer_append(&elf, ident, sizeof(ident));
+    ByteBuffer_append16(&elf, 1); // ET_REL
+    ByteBuffer_append16(&elf, EM_ARM);
+    ByteBuffer_append32(&elf, 1); // EV_CURRENT
+    ByteBuffer_append32(&elf, 0); // e_entry
+    ByteBuffer_append32(&elf, 0); // e_phoff
+    ByteBuffer_append32(&elf, sectionHeaderOffset);
+    ByteBuffer_append32(&elf, EF_ARM_EABI_VER5);
+    ByteBuffer_append16(&elf, ELF_HEADER_SIZE);
+    ByteBuffer_append16(&elf, 0); // e_phentsize
+    ByteBuffer_append16(&elf, 0); // e_phnum
+    ByteBuffer_append16(&elf, ELF_SECTION_HEADER_SIZE);
+    ByteBuffer_append16(&elf, ELF_NUM_SECTIONS);
+    ByteBuffer_append16(&elf, ELF_SECTION_SHSTRTAB);
+
+    ByteBuffer_append(&elf, data.data, data.length);
+    ByteBuffer_align(&elf, 4);
+    ByteBuffer_append(&elf, symtab.data, symtab.length);
+    ByteBuffer_append(&elf, strtab.data, strtab.length);
+    ByteBuffer_append(&elf, shstrtab.data, shstrtab.length);
+    ByteBuffer_align(&elf, 4);
+
+    assert(elf.length == sectionHeaderOffset);
+
+    Output_elfSectionHeader(&elf, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    uint32_t dataFlags = output->section == OutputSection_Rom ? SHF_ALLOC : SHF_WRITE | SHF_ALLOC;
+    Output_elfSectionHeader(&elf, dataName, SHT_PROGBITS, dataFlags, dataOffset, data.length, 0, 0, 4, 0);
+    // sh_info for the symbol table is the index of the first global symbol
+    Output_elfSectionHeader(&elf, symtabName, SHT_SYMTAB, 0, symtabOffset, symtab.length, ELF_SECTION_STRTAB, 1, 4, ELF_SYMBOL_SIZE);
+    Output_elfSectionHeader(&elf, strtabName, SHT_STRTAB, 0, strtabOffset, strtab.length, 0, 0, 1, 0);
+    Output_elfSectionHeader(&elf, shstrtabName, SHT_STRTAB, 0, shstrtabOffset, shstrtab.length, 0, 0, 1, 0);
+
+    int error = fwrite(elf.data, elf.length, 1, file) != 1;
+
+    free(data.data);
+    free(symtab.data);
+    free(strtab.data);
+    free(shstrtab.data);
+    free(elf.data);
+
+    return error;
+}
+
+static uint32_t Output_read32(const uint8_t *bytes)
+{
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+uint8_t *Output_ReadElfSymbol(const char *fileName, const char *name, int *length)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long fileLength = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t *elf = fileLength > ELF_HEADER_SIZE ? malloc(fileLength) : NULL;
+    bool ok = elf != NULL && fread(elf, fileLength, 1, file) == 1;
+    fclose(file);
+
+    uint8_t *result = NULL;
+
+    // only objects laid out the way Output_WriteElf writes them are understood
+    if (!ok || memcmp(elf, "\x7f" "ELF", 4) != 0 || elf[44] + (elf[45] << 8) != 0 ||
+        elf[48] + (elf[49] << 8) != ELF_NUM_SECTIONS)
+    {
+        free(elf);
+        return NULL;
+    }
+
+    uint32_t sectionHeaderOffset = Output_read32(elf + 32);
+    if (sectionHeaderOffset + ELF_NUM_SECTIONS * ELF_SECTION_HEADER_SIZE > (uint32_t)fileLength)
+    {
+        free(elf);
+        return NULL;
+    }
+
+    const uint8_t *dataSection = elf + sectionHeaderOffset + ELF_SECTION_DATA * ELF_SECTION_HEADER_SIZE;
+    const uint8_t *symtabSection = elf + sectionHeaderOffset + ELF_SECTION_SYMTAB * ELF_SECTION_HEADER_SIZE;
+    const uint8_t *strtabSection = elf + sectionHeaderOffset + ELF_SECTION_STRTAB * ELF_SECTION_HEADER_SIZE;
+
+    uint32_t dataOffset = Output_read32(dataSection + 16);
+    uint32_t dataLength = Output_read32(dataSection + 20);
+    uint32_t symtabOffset = Output_read32(symtabSection + 16);
+    uint32_t symtabLength = Output_read32(symtabSection + 20);
+    uint32_t strtabOffset = Output_read32(strtabSection + 16);
+    uint32_t strtabLength = Output_read32(strtabSection + 20);
+
+    if (dataOffset + dataLength > (uint32_t)fileLength || symtabOffset + symtabLength > (uint32_t)fileLength ||
+        strtabOffset + strtabLength > (uint32_t)fileLength || strtabLength == 0 || elf[strtabOffset + strtabLength - 1] != '\0')
+    {
+        free(elf);
+        return NULL;
+    }
+
+    for (uint32_t symbol = symtabOffset + ELF_SYMBOL_SIZE; symbol + ELF_SYMBOL_SIZE <= symtabOffset + symtabLength; symbol += ELF_SYMBOL_SIZE)
+    {
+        uint32_t nameOffset = Output_read32(elf + symbol);
+        uint32_t value = Output_read32(elf + symbol + 4);
+        uint32_t size = Output_read32(elf + symbol + 8);
+
+        if (nameOffset >= strtabLength || strcmp((const char *)elf + strtabOffset + nameOffset, name) != 0)
+        {
+            continue;
+        }
+
+        if (value + size <= dataLength)
+        {
+            result = malloc(size > 0 ? size : 1);
+            assert(result);
+            memcpy(result, elf + dataOffset + value, size);
+            *length = size;
+        }
+
+        break;
+    }
+
+    free(elf);
+    return result;
+}
+
+char *Output_SymbolName(const char *name, const char *suffix)
+{
+    char *symbolName = malloc(strlen(name) + strlen(suffix) + 1);
+    assert(symbolName);
+
+    int length = 0;
+    bool startOfWord = true;
+
+    for (const char *c = name; *c != '\0'; c++)
+    {
+        if (!isalnum((unsigned char)*c))
+        {
+            startOfWord = true;
+            continue;
+        }
+
+        symbolName[length++] = startOfWord ? toupper((unsigned char)*c) : *c;
+        startOfWord = false;
+    }
+
+    strcpy(symbolName + length, suffix);
+    return symbolName;
+}
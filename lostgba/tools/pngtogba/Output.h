@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+
+// The C type used for every element of an output symbol
+enum OutputType
+{
+    OutputType_U8,
+    OutputType_U16,
+    OutputType_U32,
+    OutputType_Int
+};
+
+// Where the symbols end up on the GBA. Every symbol is const
+enum OutputSection
+{
+    // Read straight from the cartridge, which is slower than RAM but doesn't use any
+    OutputSection_Rom,
+    // Copied into the 32KB of fast internal work RAM at boot, for small tables read every frame
+    OutputSection_Iwram,
+    // Copied into the 256KB of external work RAM at boot
+    OutputSection_Ewram
+};
+
+struct Output;
+
+// All symbols added to this output will be called <prefix><name>
+struct Output *Output_New(const char *prefix);
+void Output_Free(struct Output *output);
+
+// Applies to every symbol in the output. OutputSection_Rom by default
+void Output_SetSection(struct Output *output, enum OutputSection section);
+
+// Adds an array symbol. The data is copied and each element is read as the size of type
+void Output_AddArray(struct Output *output, const char *name, enum OutputType type, const void *data, int length, int elementsPerLine);
+// Adds a symbol containing a single value
+void Output_AddValue(struct Output *output, const char *name, enum OutputType type, uint32_t value);
+
+// Writes the symbols as C source. Returns non-zero on failure
+int Output_WriteC(struct Output *output, FILE *file);
+// Writes the symbols as an ARM ELF relocatable object which can be linked directly. Returns non-zero on failure
+int Output_WriteElf(struct Output *output, FILE *file);
+
+// Reads back the data of one symbol from an object written by Output_WriteElf, so that other tools can build on
+// pngtogba's output. Returns a malloc'd copy with its length in bytes in length, or NULL if the symbol isn't there
+uint8_t *Output_ReadElfSymbol(const char *fileName, const char *name, int *length);
+
+// Turns a name from an asset, like "Walk down", into part of a symbol name, like WalkDown, followed by suffix.
+// Returns a malloc'd string
+char *Output_SymbolName(const char *name, const char *suffix);
@@ -5,16 +5,36 @@
 
 #include <assert.h>
 
+// Compile with -mavx2 to use AVX2, or define PALETTE16_SCALAR to force the plain C version
+#if defined(__AVX2__) && !defined(PALETTE16_SCALAR)
+#define PALETTE16_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) && !defined(PALETTE16_SCALAR)
+#define PALETTE16_SSE2
+#include <emmintrin.h>
+#endif
+
 struct Palette16
 {
-    int numColours;
-    // these are stored in numerical order to speed up comparisons
+    // these are stored in numerical order to speed up comparisons. Unused entries are INVALID_COLOUR, which
+    // can never be added, so all 16 entries can be compared at once without matching anything by mistake
     uint16_t colours[PALETTE16_NUM_COLOURS];
+    int numColours;
 };
 
 struct Palette16 *Palette16_New(void)
 {
     struct Palette16 *p = malloc(sizeof(struct Palette16));
+    if (p == NULL)
+    {
+        return NULL;
+    }
+
+    for (int i = 0; i < PALETTE16_NUM_COLOURS; i++)
+    {
+        p->colours[i] = INVALID_COLOUR;
+    }
+
     p->numColours = 0;
 
     return p;
@@ -25,6 +45,77 @@ void Palette16_Free(struct Palette16 *palette)
     free(palette);
 }
 
+// Returns a bitmask with bit i set if colours[i] == colour
+static uint32_t Palette16_matchMask(struct Palette16 *palette, uint16_t colour)
+{
+#if defined(PALETTE16_AVX2)
+    __m256i colours = _mm256_loadu_si256((const __m256i *)palette->colours);
+    __m256i matches = _mm256_cmpeq_epi16(colours, _mm256_set1_epi16(colour));
+    // packing the 16 bit lanes down to 8 bits gives one movemask bit per colour
+    return _mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(matches), _mm256_extracti128_si256(matches, 1)));
+#elif defined(PALETTE16_SSE2)
+    __m128i needle = _mm_set1_epi16(colour);
+    __m128i low = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)palette->colours), needle);
+    __m128i high = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(palette->colours + 8)), needle);
+    // packing the 16 bit lanes down to 8 bits gives one movemask bit per colour
+    return _mm_movemask_epi8(_mm_packs_epi16(low, high));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < PALETTE16_NUM_COLOURS; i++)
+    {
+        mask |= (uint32_t)(palette->colours[i] == colour) << i;
+    }
+
+    return mask;
+#endif
+}
+
+// The number of colours which are in both palettes
+static int Palette16_intersectionLength(struct Palette16 *first, struct Palette16 *second)
+{
+#if defined(PALETTE16_AVX2)
+    __m256i colours = _mm256_loadu_si256((const __m256i *)first->colours);
+    __m256i matches = _mm256_setzero_si256();
+
+    for (int i = 0; i < second->numColours; i++)
+    {
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi16(colours, _mm256_set1_epi16(second->colours[i])));
+    }
+
+    // 2 mask bits per matching colour
+    return __builtin_popcount(_mm256_movemask_epi8(matches)) / 2;
+#elif defined(PALETTE16_SSE2)
+    __m128i low = _mm_loadu_si128((const __m128i *)first->colours);
+    __m128i high = _mm_loadu_si128((const __m128i *)(first->colours + 8));
+    __m128i lowMatches = _mm_setzero_si128();
+    __m128i highMatches = _mm_setzero_si128();
+
+    for (int i = 0; i < second->numColours; i++)
+    {
+        __m128i needle = _mm_set1_epi16(second->colours[i]);
+        lowMatches = _mm_or_si128(lowMatches, _mm_cmpeq_epi16(low, needle));
+        highMatches = _mm_or_si128(highMatches, _mm_cmpeq_epi16(high, needle));
+    }
+
+    return __builtin_popcount(_mm_movemask_epi8(_mm_packs_epi16(lowMatches, highMatches)));
+#else
+    int length = 0;
+    int i = 0, j = 0;
+
+    while (i < first->numColours && j < second->numColours)
+    {
+        uint16_t firstColour = first->colours[i];
+        uint16_t secondColour = second->colours[j];
+
+        length += firstColour == secondColour;
+        i += firstColour <= secondColour;
+        j += secondColour <= firstColour;
+    }
+
+    return length;
+#endif
+}
+
 int Palette16_AddColour(struct Palette16 *palette, uint16_t colour)
 {
     if (colour == INVALID_COLOUR)
@@ -32,41 +123,26 @@ int Palette16_AddColour(struct Palette16 *palette, uint16_t colour)
         return Palette16_GetNumColours(palette);
     }
 
-    for (int i = 0; i < palette->numColours; i++)
+    int i = 0;
+    while (i < palette->numColours && palette->colours[i] < colour)
+    {
+        i++;
+    }
+
+    // already contains this colour
+    if (i < palette->numColours && palette->colours[i] == colour)
     {
-        // already contains this colour
-        if (palette->colours[i] == colour)
-        {
-            return palette->numColours;
-        }
-
-        if (palette->colours[i] > colour)
-        {
-            // need to insert colour here
-            if (palette->numColours == PALETTE16_NUM_COLOURS)
-            {
-                return -1;
-            }
-
-            for (int j = palette->numColours; j > i; j--)
-            {
-                palette->colours[j] = palette->colours[j - 1];
-            }
-
-            palette->colours[i] = colour;
-            palette->numColours++;
-            return palette->numColours;
-        }
+        return palette->numColours;
     }
 
-    // need to add this colour to the end
     if (palette->numColours == PALETTE16_NUM_COLOURS)
     {
         // no space
         return -1;
     }
 
-    palette->colours[palette->numColours] = colour;
+    memmove(palette->colours + i + 1, palette->colours + i, (palette->numColours - i) * sizeof(uint16_t));
+    palette->colours[i] = colour;
     palette->numColours++;
 
     return palette->numColours;
@@ -78,6 +154,11 @@ uint16_t Palette16_GetColour(struct Palette16 *palette, int i)
     return palette->colours[i];
 }
 
+const uint16_t *Palette16_GetColours(struct Palette16 *palette)
+{
+    return palette->colours;
+}
+
 int Palette16_GetNumColours(struct Palette16 *palette)
 {
     return palette->numColours;
@@ -85,32 +166,10 @@ int Palette16_GetNumColours(struct Palette16 *palette)
 
 int Palette16_Contains(struct Palette16 *first, struct Palette16 *second)
 {
-    int retIfContains = Palette16_GetNumColours(first) < Palette16_GetNumColours(second) ? 1 : -1;
-    struct Palette16 *longer = Palette16_GetNumColours(first) < Palette16_GetNumColours(second) ? second : first;
-    struct Palette16 *shorter = Palette16_GetNumColours(first) < Palette16_GetNumColours(second) ? first : second;
+    int retIfContains = first->numColours < second->numColours ? 1 : -1;
+    struct Palette16 *shorter = first->numColours < second->numColours ? first : second;
 
-    int i = 0, j = 0;
-    while (1)
-    {
-        if (Palette16_GetNumColours(shorter) == i)
-        {
-            return retIfContains;
-        }
-
-        if (Palette16_GetNumColours(longer) == j)
-        {
-            return 0;
-        }
-
-        if (Palette16_GetColour(shorter, i) == Palette16_GetColour(longer, j))
-        {
-            i++;
-            j++;
-            continue;
-        }
-
-        j++;
-    }
+    return Palette16_intersectionLength(first, second) == shorter->numColours ? retIfContains : 0;
 }
 
 bool Palette16_HasColour(struct Palette16 *palette, uint16_t colour)
@@ -120,56 +179,18 @@ bool Palette16_HasColour(struct Palette16 *palette, uint16_t colour)
 
 int Palette16_GetIndex(struct Palette16 *palette, uint16_t colour)
 {
-    for (int i = 0; i < Palette16_GetNumColours(palette); i++)
+    if (colour == INVALID_COLOUR)
     {
-        if (Palette16_GetColour(palette, i) == colour)
-        {
-            return i;
-        }
+        return -1;
     }
 
-    return -1;
-}
-
-int min(int a, int b)
-{
-    return a < b ? a : b;
+    uint32_t mask = Palette16_matchMask(palette, colour);
+    return mask == 0 ? -1 : __builtin_ctz(mask);
 }
 
 int Palette16_UnionLength(struct Palette16 *first, struct Palette16 *second)
 {
-    int unionLength = 0;
-
-    int i = 0, j = 0;
-    int firstLength = Palette16_GetNumColours(first);
-    int secondLength = Palette16_GetNumColours(second);
-
-    while (i < firstLength && j < secondLength)
-    {
-        uint16_t firstColour = Palette16_GetColour(first, min(i, firstLength - 1));
-        uint16_t secondColour = Palette16_GetColour(second, min(j, secondLength - 1));
-
-        if (firstColour == secondColour)
-        {
-            i++;
-            j++;
-            unionLength += 1;
-        }
-
-        if (firstColour < secondColour)
-        {
-            i++;
-            unionLength += 1;
-        }
-
-        if (firstColour > secondColour)
-        {
-            j++;
-            unionLength += 1;
-        }
-    }
-
-    return unionLength;
+    return first->numColours + second->numColours - Palette16_intersectionLength(first, second);
 }
 
 #ifdef TEST
@@ -258,6 +279,37 @@ int main()
 
     assert(Palette16_Contains(p1, p2) == 1);
     ENDTEST
+
+    DOTEST
+    Palette16_AddColour(p1, 1);
+    Palette16_AddColour(p1, 5);
+    Palette16_AddColour(p1, 6);
+    Palette16_AddColour(p2, 2);
+    Palette16_AddColour(p2, 5);
+
+    assert(Palette16_UnionLength(p1, p2) == 4);
+    assert(Palette16_UnionLength(p2, p1) == 4);
+    assert(Palette16_Contains(p1, p2) == 0);
+    ENDTEST
+
+    DOTEST
+    for (int i = 0; i < PALETTE16_NUM_COLOURS; i++)
+    {
+        assert(Palette16_AddColour(p1, 100 - i * 3) == i + 1);
+        assert(Palette16_AddColour(p2, 100 - i * 3) == i + 1);
+    }
+
+    assert(Palette16_AddColour(p1, 0) == -1);
+    assert(Palette16_AddColour(p1, 100) == PALETTE16_NUM_COLOURS);
+
+    assert(Palette16_GetIndex(p1, 100) == PALETTE16_NUM_COLOURS - 1);
+    assert(Palette16_GetIndex(p1, 55) == 0);
+    assert(Palette16_GetIndex(p1, 56) == -1);
+    assert(!Palette16_HasColour(p1, INVALID_COLOUR));
+
+    assert(Palette16_UnionLength(p1, p2) == PALETTE16_NUM_COLOURS);
+    assert(Palette16_Contains(p1, p2) == -1);
+    ENDTEST
 }
 
 #endif
\ No newline at end of file
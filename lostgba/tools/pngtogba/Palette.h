@@ -13,11 +13,13 @@ void Palette16_Free(struct Palette16 *palette);
 
 int Palette16_GetNumColours(struct Palette16 *palette);
 uint16_t Palette16_GetColour(struct Palette16 *palette, int i);
+// All the colours in numerical order, for loops which would otherwise call GetColour for each one
+const uint16_t *Palette16_GetColours(struct Palette16 *palette);
 
 // returns the number of colours in the palette or -1 if it is full
 int Palette16_AddColour(struct Palette16 *palette, uint16_t colour);
 
-// Returns -1 if first contains second, 1 if second contains first and 0 if the palettes are disjoint. Will return -1 if equal
+// Returns -1 if first contains second, 1 if second contains first and 0 if neither contains the other. Will return -1 if equal
 int Palette16_Contains(struct Palette16 *first, struct Palette16 *second);
 
 bool Palette16_HasColour(struct Palette16 *palette, uint16_t colour);
@@ -1,6 +1,7 @@
 #include "PaletteOptimiser.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <stdbool.h>
 
@@ -18,6 +19,9 @@ struct PaletteOptimiser
 
     uint16_t colours[MAX_COLOURS];
     int nColours;
+
+    // index into colours for every 15-bit colour, -1 if it isn't there
+    int16_t colourIndices[INVALID_COLOUR];
 };
 
 struct PaletteOptimiser *PaletteOptimiser_New(int nMaxPalettes)
@@ -36,6 +40,8 @@ struct PaletteOptimiser *PaletteOptimiser_New(int nMaxPalettes)
         goto error;
     }
 
+    memset(optimiser->colourIndices, -1, sizeof(optimiser->colourIndices));
+
     optimiser->nMaxPalettes = nMaxPalettes;
     return optimiser;
 
@@ -73,14 +79,24 @@ int PaletteOptimiser_AddPalette(struct PaletteOptimiser *optimiser, struct Palet
     return PaletteOptimiser_addColours(optimiser, palette);
 }
 
+int PaletteOptimiser_GetNumPalettes(struct PaletteOptimiser *optimiser)
+{
+    return optimiser->nUsedPalettes;
+}
+
+struct Palette16 *PaletteOptimiser_GetPalette(struct PaletteOptimiser *optimiser, int i)
+{
+    assert(0 <= i && i < optimiser->nUsedPalettes);
+    return optimiser->palettes[i];
+}
+
 static int PaletteOptimiser_addColour(struct PaletteOptimiser *optimiser, uint16_t colour)
 {
-    for (int i = 0; i < optimiser->nColours; i++)
+    assert(colour < INVALID_COLOUR);
+
+    if (optimiser->colourIndices[colour] != -1)
     {
-        if (optimiser->colours[i] == colour)
-        {
-            return 0; // we already have this colour
-        }
+        return 0; // we already have this colour
     }
 
     if (optimiser->nColours == MAX_COLOURS)
@@ -88,6 +104,7 @@ static int PaletteOptimiser_addColour(struct PaletteOptimiser *optimiser, uint16
         return 1;
     }
 
+    optimiser->colourIndices[colour] = optimiser->nColours;
     optimiser->colours[optimiser->nColours++] = colour;
     return 0;
 }
@@ -95,10 +112,11 @@ static int PaletteOptimiser_addColour(struct PaletteOptimiser *optimiser, uint16
 static int PaletteOptimiser_addColours(struct PaletteOptimiser *optimiser, struct Palette16 *palette)
 {
     int nPaletteColours = Palette16_GetNumColours(palette);
+    const uint16_t *colours = Palette16_GetColours(palette);
 
     for (int i = 0; i < nPaletteColours; i++)
     {
-        uint16_t colour = Palette16_GetColour(palette, i);
+        uint16_t colour = colours[i];
         int error = PaletteOptimiser_addColour(optimiser, colour);
 
         if (error)
@@ -112,15 +130,10 @@ static int PaletteOptimiser_addColours(struct PaletteOptimiser *optimiser, struc
 
 static int PaletteOptimiser_getColourIndex(struct PaletteOptimiser *optimiser, uint16_t colour)
 {
-    for (int i = 0; i < optimiser->nColours; i++)
-    {
-        if (optimiser->colours[i] == colour)
-        {
-            return i;
-        }
-    }
+    int index = optimiser->colourIndices[colour];
+    assert(index != -1 && "Colour does not exist in colour bank");
 
-    assert(0 && "Colour does not exist in colour bank");
+    return index;
 }
 
 // Array can contain null values which will be skipped
@@ -148,9 +161,10 @@ static struct Palette16 *PaletteOptimiser_findMaximalPaletteFor(struct PaletteOp
                 continue;
             }
 
+            const uint16_t *colours = Palette16_GetColours(currentPalette);
             for (int j = 0; j < Palette16_GetNumColours(currentPalette); j++)
             {
-                uint16_t colour = Palette16_GetColour(currentPalette, j);
+                uint16_t colour = colours[j];
                 if (Palette16_HasColour(palette, colour))
                 {
                     continue;
@@ -229,13 +243,17 @@ struct PaletteOptimisationResults PaletteOptimiser_OptimisePalettes(struct Palet
 
         palettes[currentPaletteNumber++] = palette;
 
-        if (currentPaletteNumber == MAX_COLOURS / PALETTE16_NUM_COLOURS)
+        if (currentPaletteNumber == MAX_COLOURS / PALETTE16_NUM_COLOURS && satisfiedPalettes < optimiser->nUsedPalettes)
         {
-            printf("Failed to find covering palettes");
-
             struct PaletteOptimisationResults ret = {
-                .nPalettes = 0};
-
+                .nPalettes = currentPaletteNumber,
+                .palettes = palettes,
+                .paletteAssignment = assignments};
+            PaletteOptimiser_FreeResults(ret);
+
+            ret.nPalettes = 0;
+            ret.palettes = NULL;
+            ret.paletteAssignment = NULL;
             return ret;
         }
     }
@@ -246,4 +264,66 @@ struct PaletteOptimisationResults PaletteOptimiser_OptimisePalettes(struct Palet
         .paletteAssignment = assignments};
 
     return ret;
-}
\ No newline at end of file
+}
+
+void PaletteOptimiser_FreeResults(struct PaletteOptimisationResults results)
+{
+    for (int i = 0; i < results.nPalettes; i++)
+    {
+        Palette16_Free(results.palettes[i]);
+    }
+
+    free(results.palettes);
+    free(results.paletteAssignment);
+}
+
+#ifdef BENCHMARK
+
+#include "benchmark/Synthetic.h"
+
+// Builds a synthetic 1024 tile sheet where each tile uses a run of colours from one of 6 hidden banks, see
+// benchmark/Synthetic.h, and times how long the optimiser takes to recover the banks. With many more banks greedy
+// can't fit the tiles into 16 palettes, which would only time it giving up.
+//
+// gcc -O3 -DBENCHMARK PaletteOptimiser.c Palette.c benchmark/Synthetic.c -o PaletteOptimiserBenchmark
+
+#define BENCHMARK_TILES 1024
+#define BENCHMARK_BANKS 6
+#define BENCHMARK_RUNS 10
+
+int main(void)
+{
+    double best = 0;
+
+    for (int run = 0; run < BENCHMARK_RUNS; run++)
+    {
+        struct PaletteOptimiser *optimiser = PaletteOptimiser_New(BENCHMARK_TILES);
+
+        for (int i = 0; i < BENCHMARK_TILES; i++)
+        {
+            PaletteOptimiser_AddPalette(optimiser, Synthetic_NewTilePalette(BENCHMARK_BANKS));
+        }
+
+        double start = Synthetic_Seconds();
+        struct PaletteOptimisationResults results = PaletteOptimiser_OptimisePalettes(optimiser, SYNTHETIC_TRANSPARENT_COLOUR);
+        double elapsed = Synthetic_Seconds() - start;
+        assert(results.nPalettes > 0);
+
+        if (run == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+
+        if (run == 0)
+        {
+            printf("%d tiles packed into %d palettes\n", BENCHMARK_TILES, results.nPalettes);
+        }
+
+        PaletteOptimiser_FreeResults(results);
+        PaletteOptimiser_Free(optimiser);
+    }
+
+    printf("PaletteOptimiser_OptimisePalettes: best of %d runs %.3f ms\n", BENCHMARK_RUNS, best * 1000);
+}
+
+#endif
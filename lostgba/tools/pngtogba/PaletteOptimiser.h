@@ -10,6 +10,9 @@ void PaletteOptimiser_Free(struct PaletteOptimiser *optimiser);
 // Returns non-zero if there are now too many colours
 int PaletteOptimiser_AddPalette(struct PaletteOptimiser *optimiser, struct Palette16 *palette);
 
+int PaletteOptimiser_GetNumPalettes(struct PaletteOptimiser *optimiser);
+struct Palette16 *PaletteOptimiser_GetPalette(struct PaletteOptimiser *optimiser, int i);
+
 struct PaletteOptimisationResults
 {
     int nPalettes;
@@ -17,4 +20,6 @@ struct PaletteOptimisationResults
     int *paletteAssignment;
 };
 
-struct PaletteOptimisationResults PaletteOptimiser_OptimisePalettes(struct PaletteOptimiser *optimiser, uint16_t transparentColour);
\ No newline at end of file
+// Greedily picks palettes. nPalettes will be 0 if it couldn't find a set of covering palettes
+struct PaletteOptimisationResults PaletteOptimiser_OptimisePalettes(struct PaletteOptimiser *optimiser, uint16_t transparentColour);
+void PaletteOptimiser_FreeResults(struct PaletteOptimisationResults results);
\ No newline at end of file
@@ -0,0 +1,575 @@
+#include "PaletteSolver.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <limits.h>
+#include <assert.h>
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+// The search is a branch and bound over the tile colour sets (largest first), placing each one into an existing bank
+// or opening a new one. It is run for one fewer bank than the best covering found so far until either there is no
+// covering with that many banks or the time runs out.
+//
+// To use every core while keeping the results deterministic, the top of the search tree is expanded into a list of
+// jobs which the threads take in order. The solution kept is always the one from the earliest job, which is the same
+// one a single threaded depth first search would have found.
+
+#define MAX_COLOURS 256
+#define MAX_BANKS (MAX_COLOURS / PALETTE16_NUM_COLOURS)
+#define COLOURSET_WORDS (MAX_COLOURS / 64)
+#define JOBS_PER_THREAD 16
+#define NODES_PER_TIME_CHECK 4096
+
+struct ColourSet
+{
+    uint64_t bits[COLOURSET_WORDS];
+};
+
+static int ColourSet_count(const struct ColourSet *set)
+{
+    int count = 0;
+    for (int i = 0; i < COLOURSET_WORDS; i++)
+    {
+        count += __builtin_popcountll(set->bits[i]);
+    }
+
+    return count;
+}
+
+static int ColourSet_unionCount(const struct ColourSet *a, const struct ColourSet *b)
+{
+    int count = 0;
+    for (int i = 0; i < COLOURSET_WORDS; i++)
+    {
+        count += __builtin_popcountll(a->bits[i] | b->bits[i]);
+    }
+
+    return count;
+}
+
+static int ColourSet_countWithout(const struct ColourSet *a, const struct ColourSet *without)
+{
+    int count = 0;
+    for (int i = 0; i < COLOURSET_WORDS; i++)
+    {
+        count += __builtin_popcountll(a->bits[i] & ~without->bits[i]);
+    }
+
+    return count;
+}
+
+static void ColourSet_addAll(struct ColourSet *target, const struct ColourSet *source)
+{
+    for (int i = 0; i < COLOURSET_WORDS; i++)
+    {
+        target->bits[i] |= source->bits[i];
+    }
+}
+
+static bool ColourSet_isSubset(const struct ColourSet *subset, const struct ColourSet *set)
+{
+    for (int i = 0; i < COLOURSET_WORDS; i++)
+    {
+        if (subset->bits[i] & ~set->bits[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct SolverNode
+{
+    int depth;
+    int nBanks;
+    struct ColourSet banks[MAX_BANKS];
+};
+
+struct Solver
+{
+    // the colour sets which need covering, largest first. None of these is a subset of another
+    struct ColourSet *sets;
+    int nSets;
+    // remaining[i] is the union of sets[i..nSets]
+    struct ColourSet *remaining;
+
+    // number of colours available in each bank once the transparent colour is taken out
+    int capacity;
+    double deadline;
+
+    // the state for searching for a specific number of banks
+    int targetBanks;
+    struct SolverNode *jobs;
+    int nJobs;
+    atomic_int nextJob;
+    atomic_int solutionJob;
+    atomic_bool timedOut;
+    pthread_mutex_t solutionLock;
+    struct SolverNode solution;
+};
+
+static double PaletteSolver_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Whether the colours still to be placed could possibly fit in the space left
+static bool PaletteSolver_canComplete(struct Solver *solver, struct SolverNode *node)
+{
+    struct ColourSet used = {0};
+    int usedSlots = 0;
+
+    for (int i = 0; i < node->nBanks; i++)
+    {
+        ColourSet_addAll(&used, &node->banks[i]);
+        usedSlots += ColourSet_count(&node->banks[i]);
+    }
+
+    int freeSlots = solver->targetBanks * solver->capacity - usedSlots;
+    return ColourSet_countWithout(&solver->remaining[node->depth], &used) <= freeSlots;
+}
+
+// Fills order with the banks the next set could go in, in the order they should be tried. A value of
+// node->nBanks means opening a new bank. Returns how many there are.
+static int PaletteSolver_candidates(struct Solver *solver, struct SolverNode *node, int order[MAX_BANKS + 1])
+{
+    const struct ColourSet *set = &solver->sets[node->depth];
+    int growth[MAX_BANKS + 1];
+    int nCandidates = 0;
+
+    for (int i = 0; i < node->nBanks; i++)
+    {
+        int unionCount = ColourSet_unionCount(&node->banks[i], set);
+        if (unionCount > solver->capacity)
+        {
+            continue;
+        }
+
+        int bankGrowth = unionCount - ColourSet_count(&node->banks[i]);
+        if (bankGrowth == 0)
+        {
+            // already covered, nothing else can do better than this
+            order[0] = i;
+            return 1;
+        }
+
+        // insertion sort by growth (best fit first), ties keep bank order
+        int j = nCandidates++;
+        while (j > 0 && growth[j - 1] > bankGrowth)
+        {
+            growth[j] = growth[j - 1];
+            order[j] = order[j - 1];
+            j--;
+        }
+
+        growth[j] = bankGrowth;
+        order[j] = i;
+    }
+
+    if (node->nBanks < solver->targetBanks)
+    {
+        order[nCandidates++] = node->nBanks;
+    }
+
+    return nCandidates;
+}
+
+static void PaletteSolver_place(struct Solver *solver, struct SolverNode *node, int bank)
+{
+    if (bank == node->nBanks)
+    {
+        memset(&node->banks[bank], 0, sizeof(struct ColourSet));
+        node->nBanks++;
+    }
+
+    ColourSet_addAll(&node->banks[bank], &solver->sets[node->depth]);
+    node->depth++;
+}
+
+// Returns 1 if a solution was found (and is left in node), 0 if there is no solution below this node and -1 if
+// the search was abandoned
+static int PaletteSolver_search(struct Solver *solver, struct SolverNode *node, int job, long *nodeCount)
+{
+    if (node->depth == solver->nSets)
+    {
+        return 1;
+    }
+
+    if (++*nodeCount % NODES_PER_TIME_CHECK == 0 && PaletteSolver_now() > solver->deadline)
+    {
+        atomic_store(&solver->timedOut, true);
+    }
+
+    if (atomic_load(&solver->timedOut) || atomic_load(&solver->solutionJob) < job)
+    {
+        return -1;
+    }
+
+    if (!PaletteSolver_canComplete(solver, node))
+    {
+        return 0;
+    }
+
+    int order[MAX_BANKS + 1];
+    int nCandidates = PaletteSolver_candidates(solver, node, order);
+
+    for (int i = 0; i < nCandidates; i++)
+    {
+        int bank = order[i];
+        struct ColourSet previous = node->banks[bank];
+        int previousBanks = node->nBanks;
+
+        PaletteSolver_place(solver, node, bank);
+
+        int result = PaletteSolver_search(solver, node, job, nodeCount);
+        if (result != 0)
+        {
+            return result;
+        }
+
+        node->depth--;
+        node->nBanks = previousBanks;
+        node->banks[bank] = previous;
+    }
+
+    return 0;
+}
+
+static void *PaletteSolver_worker(void *arg)
+{
+    struct Solver *solver = arg;
+    long nodeCount = 0;
+
+    while (true)
+    {
+        int job = atomic_fetch_add(&solver->nextJob, 1);
+        if (job >= solver->nJobs || job > atomic_load(&solver->solutionJob) || atomic_load(&solver->timedOut))
+        {
+            break;
+        }
+
+        struct SolverNode node = solver->jobs[job];
+        if (PaletteSolver_search(solver, &node, job, &nodeCount) == 1)
+        {
+            pthread_mutex_lock(&solver->solutionLock);
+            if (job < atomic_load(&solver->solutionJob))
+            {
+                solver->solution = node;
+                atomic_store(&solver->solutionJob, job);
+            }
+            pthread_mutex_unlock(&solver->solutionLock);
+        }
+    }
+
+    return NULL;
+}
+
+// Expands the top of the search tree breadth first (keeping depth first order) until there are enough jobs
+static void PaletteSolver_buildJobs(struct Solver *solver, int nWantedJobs)
+{
+    struct SolverNode *jobs = malloc(sizeof(struct SolverNode));
+    assert(jobs);
+
+    memset(&jobs[0], 0, sizeof(struct SolverNode));
+    int nJobs = 1;
+
+    while (nJobs > 0 && nJobs < nWantedJobs && jobs[0].depth < solver->nSets)
+    {
+        struct SolverNode *nextJobs = malloc(nJobs * (MAX_BANKS + 1) * sizeof(struct SolverNode));
+        assert(nextJobs);
+        int nNextJobs = 0;
+
+        for (int i = 0; i < nJobs; i++)
+        {
+            if (!PaletteSolver_canComplete(solver, &jobs[i]))
+            {
+                continue;
+            }
+
+            int order[MAX_BANKS + 1];
+            int nCandidates = PaletteSolver_candidates(solver, &jobs[i], order);
+
+            for (int j = 0; j < nCandidates; j++)
+            {
+                nextJobs[nNextJobs] = jobs[i];
+                PaletteSolver_place(solver, &nextJobs[nNextJobs], order[j]);
+                nNextJobs++;
+            }
+        }
+
+        free(jobs);
+        jobs = nextJobs;
+        nJobs = nNextJobs;
+    }
+
+    solver->jobs = jobs;
+    solver->nJobs = nJobs;
+}
+
+// Returns 1 if a covering with at most targetBanks banks was found, 0 if there isn't one and -1 on timeout
+static int PaletteSolver_searchFor(struct Solver *solver, int targetBanks, int nThreads)
+{
+    solver->targetBanks = targetBanks;
+    PaletteSolver_buildJobs(solver, nThreads * JOBS_PER_THREAD);
+
+    atomic_store(&solver->nextJob, 0);
+    atomic_store(&solver->solutionJob, INT_MAX);
+
+    // a zero length array isn't allowed, even when there are no other threads
+    pthread_t threads[nThreads > 0 ? nThreads : 1];
+    for (int i = 0; i < nThreads; i++)
+    {
+        if (pthread_create(&threads[i], NULL, PaletteSolver_worker, solver) != 0)
+        {
+            // run whatever is left on this thread instead
+            nThreads = i;
+            break;
+        }
+    }
+
+    PaletteSolver_worker(solver);
+
+    for (int i = 0; i < nThreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(solver->jobs);
+    solver->jobs = NULL;
+
+    if (atomic_load(&solver->solutionJob) != INT_MAX)
+    {
+        return 1;
+    }
+
+    return atomic_load(&solver->timedOut) ? -1 : 0;
+}
+
+static int PaletteSolver_compareSets(const void *a, const void *b)
+{
+    int countA = ColourSet_count(a);
+    int countB = ColourSet_count(b);
+    if (countA != countB)
+    {
+        return countB - countA;
+    }
+
+    return memcmp(a, b, sizeof(struct ColourSet));
+}
+
+struct PaletteOptimisationResults PaletteSolver_Improve(struct PaletteOptimiser *optimiser, struct PaletteOptimisationResults greedy,
+                                                        uint16_t transparentColour, int timeBudgetMs, bool *timedOut)
+{
+    double start = PaletteSolver_now();
+    int nPalettes = PaletteOptimiser_GetNumPalettes(optimiser);
+    *timedOut = false;
+
+    if (timeBudgetMs <= 0 || nPalettes <= 0)
+    {
+        return greedy;
+    }
+
+    // give every colour other than the transparent one a bit
+    int16_t *colourBits = malloc(INVALID_COLOUR * sizeof(int16_t));
+    uint16_t colours[MAX_COLOURS];
+    int nColours = 0;
+    struct ColourSet *tileSets = calloc(nPalettes, sizeof(struct ColourSet));
+    struct Solver solver = {.capacity = PALETTE16_NUM_COLOURS - (transparentColour != INVALID_COLOUR ? 1 : 0)};
+    struct PaletteOptimisationResults results = greedy;
+    assert(colourBits && tileSets);
+    memset(colourBits, -1, INVALID_COLOUR * sizeof(int16_t));
+
+    for (int i = 0; i < nPalettes; i++)
+    {
+        struct Palette16 *palette = PaletteOptimiser_GetPalette(optimiser, i);
+
+        for (int j = 0; j < Palette16_GetNumColours(palette); j++)
+        {
+            uint16_t colour = Palette16_GetColour(palette, j);
+            if (colour == transparentColour)
+            {
+                continue;
+            }
+
+            if (colourBits[colour] == -1)
+            {
+                if (nColours == MAX_COLOURS)
+                {
+                    goto exit;
+                }
+
+                colours[nColours] = colour;
+                colourBits[colour] = nColours++;
+            }
+
+            int bit = colourBits[colour];
+            tileSets[i].bits[bit / 64] |= 1ull << (bit % 64);
+        }
+
+        if (ColourSet_count(&tileSets[i]) > solver.capacity)
+        {
+            goto exit;
+        }
+    }
+
+    // only the sets which aren't contained in another one need placing
+    solver.sets = malloc((size_t)nPalettes * sizeof(struct ColourSet));
+    assert(solver.sets);
+    memcpy(solver.sets, tileSets, (size_t)nPalettes * sizeof(struct ColourSet));
+    qsort(solver.sets, nPalettes, sizeof(struct ColourSet), PaletteSolver_compareSets);
+
+    for (int i = 0; i < nPalettes; i++)
+    {
+        bool covered = false;
+        for (int j = 0; j < solver.nSets && !covered; j++)
+        {
+            covered = ColourSet_isSubset(&solver.sets[i], &solver.sets[j]);
+        }
+
+        if (!covered)
+        {
+            solver.sets[solver.nSets++] = solver.sets[i];
+        }
+    }
+
+    solver.remaining = calloc(solver.nSets + 1, sizeof(struct ColourSet));
+    assert(solver.remaining);
+    for (int i = solver.nSets - 1; i >= 0; i--)
+    {
+        solver.remaining[i] = solver.remaining[i + 1];
+        ColourSet_addAll(&solver.remaining[i], &solver.sets[i]);
+    }
+
+    solver.deadline = start + timeBudgetMs / 1000.0;
+    pthread_mutex_init(&solver.solutionLock, NULL);
+
+    int nThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    nThreads = nThreads < 1 ? 1 : nThreads;
+
+    int lowerBound = (nColours + solver.capacity - 1) / solver.capacity;
+    lowerBound = lowerBound < 1 ? 1 : lowerBound;
+
+    int bestBanks = greedy.nPalettes > 0 ? greedy.nPalettes : MAX_BANKS + 1;
+    struct SolverNode best = {0};
+    bool improved = false;
+
+    // the calling thread takes part in the search too
+    while (bestBanks - 1 >= lowerBound && PaletteSolver_searchFor(&solver, bestBanks - 1, nThreads - 1) == 1)
+    {
+        best = solver.solution;
+        bestBanks = best.nBanks;
+        improved = true;
+    }
+
+    pthread_mutex_destroy(&solver.solutionLock);
+    *timedOut = atomic_load(&solver.timedOut);
+
+    if (!improved)
+    {
+        goto exit;
+    }
+
+    results.nPalettes = best.nBanks;
+    results.palettes = calloc(MAX_BANKS, sizeof(struct Palette16 *));
+    results.paletteAssignment = calloc(nPalettes, sizeof(int));
+    assert(results.palettes && results.paletteAssignment);
+
+    for (int i = 0; i < best.nBanks; i++)
+    {
+        results.palettes[i] = Palette16_New();
+        assert(results.palettes[i]);
+
+        if (transparentColour != INVALID_COLOUR)
+        {
+            Palette16_AddColour(results.palettes[i], transparentColour);
+        }
+
+        for (int bit = 0; bit < nColours; bit++)
+        {
+            if (best.banks[i].bits[bit / 64] & (1ull << (bit % 64)))
+            {
+                Palette16_AddColour(results.palettes[i], colours[bit]);
+            }
+        }
+    }
+
+    for (int i = 0; i < nPalettes; i++)
+    {
+        int bank = 0;
+        while (!ColourSet_isSubset(&tileSets[i], &best.banks[bank]))
+        {
+            bank++;
+            assert(bank < best.nBanks);
+        }
+
+        results.paletteAssignment[i] = bank;
+    }
+
+    PaletteOptimiser_FreeResults(greedy);
+
+exit:
+    free(colourBits);
+    free(tileSets);
+    free(solver.sets);
+    free(solver.remaining);
+
+    return results;
+}
+
+
+#ifdef TEST
+
+#include "benchmark/Synthetic.h"
+
+#include <stdio.h>
+
+// gcc -c -DTEST PaletteSolver.c && gcc -pthread PaletteSolver.o PaletteOptimiser.c Palette.c benchmark/Synthetic.c
+
+// Every tile uses colours from one of nBanks hidden banks, so there is always a covering with nBanks palettes
+static void testHiddenBanks(int nTiles, int nBanks)
+{
+    uint16_t transparent = SYNTHETIC_TRANSPARENT_COLOUR;
+    struct PaletteOptimiser *optimiser = PaletteOptimiser_New(nTiles);
+
+    for (int i = 0; i < nTiles; i++)
+    {
+        PaletteOptimiser_AddPalette(optimiser, Synthetic_NewTilePalette(nBanks));
+    }
+
+    struct PaletteOptimisationResults greedy = PaletteOptimiser_OptimisePalettes(optimiser, transparent);
+    int greedyPalettes = greedy.nPalettes;
+    bool timedOut;
+    struct PaletteOptimisationResults results = PaletteSolver_Improve(optimiser, greedy, transparent, 5000, &timedOut);
+
+    printf("%d tiles from %d banks: greedy %d palettes, solver %d palettes\n", nTiles, nBanks, greedyPalettes, results.nPalettes);
+
+    assert(results.nPalettes != 0 && results.nPalettes <= nBanks);
+
+    for (int i = 0; i < nTiles; i++)
+    {
+        assert(0 <= results.paletteAssignment[i] && results.paletteAssignment[i] < results.nPalettes);
+        struct Palette16 *palette = results.palettes[results.paletteAssignment[i]];
+        assert(Palette16_GetNumColours(palette) <= PALETTE16_NUM_COLOURS);
+        assert(Palette16_Contains(palette, PaletteOptimiser_GetPalette(optimiser, i)) == -1);
+    }
+
+    PaletteOptimiser_FreeResults(results);
+    PaletteOptimiser_Free(optimiser);
+}
+
+int main(void)
+{
+    testHiddenBanks(64, 2);
+    testHiddenBanks(256, 4);
+    testHiddenBanks(1024, 12);
+}
+
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "PaletteOptimiser.h"
+
+// Searches for a covering which uses fewer palettes than the greedy results, using every core of the host.
+//
+// Returns the best results found within timeBudgetMs milliseconds. If nothing better than greedy is found,
+// greedy is returned unchanged, otherwise greedy is freed. Works even if the greedy optimiser failed to
+// find a covering (greedy.nPalettes == 0).
+//
+// As long as the search finishes inside the time budget, the results are the same on every run. Otherwise timedOut
+// is set, and the results depend on how fast the host is, so they shouldn't be cached.
+struct PaletteOptimisationResults PaletteSolver_Improve(struct PaletteOptimiser *optimiser, struct PaletteOptimisationResults greedy,
+                                                        uint16_t transparentColour, int timeBudgetMs, bool *timedOut);
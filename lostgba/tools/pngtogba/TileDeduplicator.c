@@ -0,0 +1,216 @@
+#include "TileDeduplicator.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+
+// Writes tile flipped according to flip into target
+static void TileDeduplicator_flip(uint8_t *target, const uint8_t *tile, int tileSize, int flip)
+{
+    for (int y = 0; y < tileSize; y++)
+    {
+        int sourceY = (flip & TILEDEDUPLICATOR_VFLIP) ? tileSize - 1 - y : y;
+
+        for (int x = 0; x < tileSize; x++)
+        {
+            int sourceX = (flip & TILEDEDUPLICATOR_HFLIP) ? tileSize - 1 - x : x;
+            target[y * tileSize + x] = tile[sourceY * tileSize + sourceX];
+        }
+    }
+}
+
+// FNV-1a
+static uint32_t TileDeduplicator_hash(const uint8_t *tile, int tileLength, int paletteNumber)
+{
+    uint32_t hash = 2166136261u ^ (uint32_t)paletteNumber;
+
+    for (int i = 0; i < tileLength; i++)
+    {
+        hash = (hash ^ tile[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+struct TileDeduplicationResults TileDeduplicator_Deduplicate(const uint8_t *tiles, const int *paletteNumbers, int nTiles, int tileSize)
+{
+    int tileLength = tileSize * tileSize;
+
+    struct TileDeduplicationResults results = {
+        .nUniqueTiles = 0,
+        .uniqueTiles = malloc(nTiles * sizeof(int)),
+        .remapTile = malloc(nTiles * sizeof(int)),
+        .remapFlip = malloc(nTiles * sizeof(uint8_t))};
+    assert(results.uniqueTiles && results.remapTile && results.remapFlip);
+
+    // open addressed hash table of unique tile indices, -1 for an empty slot
+    int tableSize = 1;
+    while (tableSize < nTiles * 2)
+    {
+        tableSize *= 2;
+    }
+
+    int *table = malloc(tableSize * sizeof(int));
+    uint8_t *flipped = malloc(tileLength);
+    assert(table && flipped);
+    memset(table, -1, tableSize * sizeof(int));
+
+    for (int i = 0; i < nTiles; i++)
+    {
+        const uint8_t *tile = tiles + (size_t)i * tileLength;
+        bool found = false;
+
+        // flipping is its own inverse, so if the flipped tile is already known then this tile is that one flipped
+        for (int flip = 0; flip < 4 && !found; flip++)
+        {
+            TileDeduplicator_flip(flipped, tile, tileSize, flip);
+
+            uint32_t hash = TileDeduplicator_hash(flipped, tileLength, paletteNumbers[i]);
+            for (int slot = hash & (tableSize - 1); table[slot] != -1; slot = (slot + 1) & (tableSize - 1))
+            {
+                int candidate = results.uniqueTiles[table[slot]];
+                if (paletteNumbers[candidate] == paletteNumbers[i] &&
+                    memcmp(tiles + (size_t)candidate * tileLength, flipped, tileLength) == 0)
+                {
+                    results.remapTile[i] = table[slot];
+                    results.remapFlip[i] = flip;
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        if (found)
+        {
+            continue;
+        }
+
+        // only the unflipped version is stored, the flipped lookups above find the others
+        int slot = TileDeduplicator_hash(tile, tileLength, paletteNumbers[i]) & (tableSize - 1);
+        while (table[slot] != -1)
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        table[slot] = results.nUniqueTiles;
+        results.uniqueTiles[results.nUniqueTiles] = i;
+        results.remapTile[i] = results.nUniqueTiles;
+        results.remapFlip[i] = 0;
+        results.nUniqueTiles++;
+    }
+
+    free(table);
+    free(flipped);
+
+    return results;
+}
+
+void TileDeduplicator_FreeResults(struct TileDeduplicationResults results)
+{
+    free(results.uniqueTiles);
+    free(results.remapTile);
+    free(results.remapFlip);
+}
+
+#ifdef TEST
+
+#include <stdio.h>
+
+// gcc -DTEST TileDeduplicator.c
+
+#define TEST_TILE_SIZE 8
+#define TEST_TILE_LENGTH (TEST_TILE_SIZE * TEST_TILE_SIZE)
+
+// A tile with no symmetry, so each flip of it is different
+static void testAsymmetricTile(uint8_t *tile)
+{
+    for (int i = 0; i < TEST_TILE_LENGTH; i++)
+    {
+        tile[i] = (i * 7 + i / TEST_TILE_SIZE) % 16;
+    }
+    tile[0] = 15;
+}
+
+static void testFlips(void)
+{
+    uint8_t tiles[4 * TEST_TILE_LENGTH];
+    int paletteNumbers[4] = {0};
+
+    testAsymmetricTile(tiles);
+    for (int flip = 1; flip < 4; flip++)
+    {
+        TileDeduplicator_flip(tiles + flip * TEST_TILE_LENGTH, tiles, TEST_TILE_SIZE, flip);
+        assert(memcmp(tiles + flip * TEST_TILE_LENGTH, tiles, TEST_TILE_LENGTH) != 0);
+    }
+
+    struct TileDeduplicationResults results = TileDeduplicator_Deduplicate(tiles, paletteNumbers, 4, TEST_TILE_SIZE);
+
+    assert(results.nUniqueTiles == 1);
+    assert(results.uniqueTiles[0] == 0);
+    for (int i = 0; i < 4; i++)
+    {
+        assert(results.remapTile[i] == 0);
+        assert(results.remapFlip[i] == i);
+    }
+
+    TileDeduplicator_FreeResults(results);
+}
+
+static void testPalettes(void)
+{
+    uint8_t tiles[3 * TEST_TILE_LENGTH];
+    int paletteNumbers[3] = {0, 1, 0};
+
+    for (int i = 0; i < 3; i++)
+    {
+        testAsymmetricTile(tiles + i * TEST_TILE_LENGTH);
+    }
+
+    struct TileDeduplicationResults results = TileDeduplicator_Deduplicate(tiles, paletteNumbers, 3, TEST_TILE_SIZE);
+
+    // the same pixels are a different tile with another palette
+    assert(results.nUniqueTiles == 2);
+    assert(results.uniqueTiles[0] == 0 && results.uniqueTiles[1] == 1);
+    assert(results.remapTile[1] == 1);
+    assert(results.remapTile[2] == 0 && results.remapFlip[2] == 0);
+
+    TileDeduplicator_FreeResults(results);
+}
+
+static void testHashCollisions(void)
+{
+    // two tiles with the same hash, found by searching random rows. The rest of both tiles is 0
+    static const uint8_t firstRow[TEST_TILE_SIZE] = {2, 8, 9, 0, 8, 12, 11, 11};
+    static const uint8_t secondRow[TEST_TILE_SIZE] = {9, 14, 13, 3, 14, 12, 11, 5};
+
+    uint8_t tiles[4 * TEST_TILE_LENGTH] = {0};
+    int paletteNumbers[4] = {0};
+
+    memcpy(tiles, firstRow, TEST_TILE_SIZE);
+    memcpy(tiles + TEST_TILE_LENGTH, secondRow, TEST_TILE_SIZE);
+    memcpy(tiles + 2 * TEST_TILE_LENGTH, secondRow, TEST_TILE_SIZE);
+    memcpy(tiles + 3 * TEST_TILE_LENGTH, firstRow, TEST_TILE_SIZE);
+    assert(TileDeduplicator_hash(tiles, TEST_TILE_LENGTH, 0) == TileDeduplicator_hash(tiles + TEST_TILE_LENGTH, TEST_TILE_LENGTH, 0));
+
+    struct TileDeduplicationResults results = TileDeduplicator_Deduplicate(tiles, paletteNumbers, 4, TEST_TILE_SIZE);
+
+    assert(results.nUniqueTiles == 2);
+    assert(results.remapTile[0] == 0 && results.remapTile[1] == 1);
+    assert(results.remapTile[2] == 1 && results.remapFlip[2] == 0);
+    assert(results.remapTile[3] == 0 && results.remapFlip[3] == 0);
+
+    TileDeduplicator_FreeResults(results);
+}
+
+int main(void)
+{
+    testFlips();
+    testPalettes();
+    testHashCollisions();
+
+    printf("TileDeduplicator tests passed\n");
+    return 0;
+}
+
+#endif
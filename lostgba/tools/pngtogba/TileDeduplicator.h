@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#define TILEDEDUPLICATOR_HFLIP 1
+#define TILEDEDUPLICATOR_VFLIP 2
+
+struct TileDeduplicationResults
+{
+    int nUniqueTiles;
+    // The source tile which each unique tile was taken from
+    int *uniqueTiles;
+
+    // For each source tile, which unique tile it is and how that unique tile needs flipping to recreate it
+    int *remapTile;
+    uint8_t *remapFlip;
+};
+
+// tiles contains nTiles tiles of tileSize * tileSize colour indices each, stored row by row.
+// Tiles only match if they have the same palette number.
+struct TileDeduplicationResults TileDeduplicator_Deduplicate(const uint8_t *tiles, const int *paletteNumbers, int nTiles, int tileSize);
+void TileDeduplicator_FreeResults(struct TileDeduplicationResults results);
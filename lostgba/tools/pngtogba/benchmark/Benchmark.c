@@ -0,0 +1,428 @@
+// Times each stage of pngtogba on synthetic sprite sheets and reports the results as JSON on stdout.
+//
+// Every sheet is built from the hidden bank tiles of Synthetic.h, with some tiles repeated so that deduplication
+// has something to do. Sheets go from 128x128 up to --max-size pixels square,
+// for 8x8 and 16x16 tiles and 1, 4 and 16 banks. Only sheets of 8x8 tiles small enough for a background are
+// deduplicated, since those are the only ones pngtogba accepts DEDUPE=1 for.
+//
+// make benchmark
+// lostgba/tools/pngtogba/benchmark/Benchmark [--runs N] [--max-size N] [--solver-ms N] > results.json
+
+#include "Synthetic.h"
+#include "../Converter.h"
+#include "../PaletteSolver.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <zlib.h>
+
+#define DEFAULT_RUNS 5
+#define DEFAULT_MAX_SIZE 4096
+#define DEFAULT_SOLVER_MS 100
+#define MIN_SIZE 128
+
+// One in this many tiles is a copy of an earlier one
+#define REPEAT_EVERY 4
+// Screen entries can only refer to this many tiles
+#define MAX_DEDUPE_TILES 1024
+
+// The image is decoded a band at a time during optimiserForImage and again during emit, so open only reads the header
+enum Stage
+{
+    Stage_Open,
+    Stage_OptimiserForImage,
+    Stage_OptimisePalettes,
+    Stage_Solve,
+    Stage_Emit,
+    Stage_Count
+};
+
+static const char *stageNames[Stage_Count] = {
+    "open",
+    "optimiserForImage",
+    "optimisePalettes",
+    "solve",
+    "emit"};
+
+struct StageTimes
+{
+    double *seconds;
+    long peakRssKb;
+    bool ran;
+};
+
+// Resets the peak RSS of this process so the next reading covers only what follows.
+// Returns false if the kernel doesn't allow it, in which case readings are the peak since the process started
+static bool Benchmark_resetPeakRss(void)
+{
+    FILE *clearRefs = fopen("/proc/self/clear_refs", "w");
+    if (clearRefs == NULL)
+    {
+        return false;
+    }
+
+    bool ok = fputs("5", clearRefs) >= 0;
+    ok &= fclose(clearRefs) == 0;
+
+    return ok;
+}
+
+static long Benchmark_peakRssKb(void)
+{
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status != NULL)
+    {
+        char line[256];
+        long peak = -1;
+
+        while (fgets(line, sizeof(line), status) != NULL)
+        {
+            if (sscanf(line, "VmHWM: %ld kB", &peak) == 1)
+            {
+                break;
+            }
+        }
+
+        fclose(status);
+
+        if (peak >= 0)
+        {
+            return peak;
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static void Benchmark_writeChunk(FILE *file, const char *type, const uint8_t *data, uint32_t length)
+{
+    uint8_t header[8] = {length >> 24, length >> 16, length >> 8, length, type[0], type[1], type[2], type[3]};
+    fwrite(header, 1, 8, file);
+    fwrite(data, 1, length, file);
+
+    uint32_t crc = crc32(0, header + 4, 4);
+    crc = crc32(crc, data, length);
+
+    uint8_t crcBytes[4] = {crc >> 24, crc >> 16, crc >> 8, crc};
+    fwrite(crcBytes, 1, 4, file);
+}
+
+// Writes an 8 bit RGBA PNG. Returns non-zero on failure
+static int Benchmark_writePng(const char *fileName, const uint8_t *rgba, int width, int height)
+{
+    size_t rowLength = (size_t)width * 4 + 1;
+    size_t rawLength = rowLength * height;
+    uint8_t *raw = malloc(rawLength);
+    uLongf compressedLength = compressBound(rawLength);
+    uint8_t *compressed = malloc(compressedLength);
+    assert(raw && compressed);
+
+    for (int y = 0; y < height; y++)
+    {
+        raw[y * rowLength] = 0;
+        memcpy(raw + y * rowLength + 1, rgba + (size_t)y * width * 4, (size_t)width * 4);
+    }
+
+    int err = compress2(compressed, &compressedLength, raw, rawLength, 1) != Z_OK;
+    free(raw);
+
+    FILE *file = err ? NULL : fopen(fileName, "wb");
+    if (file == NULL)
+    {
+        free(compressed);
+        return 1;
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    fwrite(signature, 1, 8, file);
+
+    uint8_t ihdr[13] = {width >> 24, width >> 16, width >> 8, width, height >> 24, height >> 16, height >> 8, height, 8, 6, 0, 0, 0};
+    Benchmark_writeChunk(file, "IHDR", ihdr, sizeof(ihdr));
+    Benchmark_writeChunk(file, "IDAT", compressed, compressedLength);
+    Benchmark_writeChunk(file, "IEND", NULL, 0);
+
+    free(compressed);
+    err = ferror(file);
+    err |= fclose(file) != 0;
+
+    return err;
+}
+
+// The inverse of rgb15, so the sheet survives conversion exactly
+static void Benchmark_setColour(uint8_t *pixel, uint16_t colour)
+{
+    pixel[0] = (colour & 31) << 3;
+    pixel[1] = ((colour >> 5) & 31) << 3;
+    pixel[2] = ((colour >> 10) & 31) << 3;
+    pixel[3] = 255;
+}
+
+static int Benchmark_generateSheet(const char *fileName, int size, int tileSize, int nBanks)
+{
+    uint8_t *rgba = malloc((size_t)size * size * 4);
+    assert(rgba);
+
+    int tilesPerRow = size / tileSize;
+    int nTiles = tilesPerRow * tilesPerRow;
+
+    for (int t = 0; t < nTiles; t++)
+    {
+        int tileX = (t % tilesPerRow) * tileSize;
+        int tileY = (t / tilesPerRow) * tileSize;
+
+        if (t > 0 && Synthetic_Random() % REPEAT_EVERY == 0)
+        {
+            int source = Synthetic_Random() % t;
+            int sourceX = (source % tilesPerRow) * tileSize;
+            int sourceY = (source / tilesPerRow) * tileSize;
+
+            for (int y = 0; y < tileSize; y++)
+            {
+                memcpy(rgba + ((size_t)(tileY + y) * size + tileX) * 4, rgba + ((size_t)(sourceY + y) * size + sourceX) * 4, tileSize * 4);
+            }
+
+            continue;
+        }
+
+        struct SyntheticTile tile = Synthetic_NewTile(nBanks);
+
+        // short horizontal runs of the same colour, roughly like drawn sprites
+        int run = 0;
+        uint16_t colour = SYNTHETIC_TRANSPARENT_COLOUR;
+
+        for (int y = 0; y < tileSize; y++)
+        {
+            for (int x = 0; x < tileSize; x++)
+            {
+                if (run-- <= 0)
+                {
+                    int choice = Synthetic_Random() % (tile.nColours + 1);
+                    colour = choice == tile.nColours ? SYNTHETIC_TRANSPARENT_COLOUR : Synthetic_TileColour(tile, choice);
+                    run = Synthetic_Random() % 4;
+                }
+
+                Benchmark_setColour(rgba + ((size_t)(tileY + y) * size + tileX + x) * 4, colour);
+            }
+        }
+    }
+
+    int err = Benchmark_writePng(fileName, rgba, size, size);
+    free(rgba);
+
+    return err;
+}
+
+static int Benchmark_compareSeconds(const void *a, const void *b)
+{
+    double left = *(const double *)a;
+    double right = *(const double *)b;
+
+    return (left > right) - (left < right);
+}
+
+// Runs the whole conversion once, adding the time and peak memory of each stage to times. Returns the number of palettes
+static int Benchmark_run(const char *fileName, struct Config *config, int run, struct StageTimes *times)
+{
+    struct PaletteOptimiser *optimiser = NULL;
+    struct PaletteOptimisationResults results = {0};
+    struct IndexedTiles *indexed = NULL;
+    struct Output *output = NULL;
+    int nPalettes = 0;
+
+#define STAGE(stage, code)                                                      \
+    do                                                                          \
+    {                                                                           \
+        Benchmark_resetPeakRss();                                               \
+        double start = Synthetic_Seconds();                                     \
+        code;                                                                   \
+        times[stage].seconds[run] = Synthetic_Seconds() - start;                \
+        long peak = Benchmark_peakRssKb();                                      \
+        times[stage].peakRssKb = peak > times[stage].peakRssKb ? peak : times[stage].peakRssKb; \
+        times[stage].ran = true;                                                \
+    } while (0)
+
+    struct Image *img;
+    STAGE(Stage_Open, img = Image_New(fileName, config->tileSize));
+
+    if (img == NULL || Image_Error(img) != NULL)
+    {
+        fprintf(stderr, "Failed to load %s\n", fileName);
+        goto exit;
+    }
+
+    STAGE(Stage_OptimiserForImage, optimiser = Converter_OptimiserForImage(img));
+    if (optimiser == NULL)
+    {
+        goto exit;
+    }
+
+    STAGE(Stage_OptimisePalettes, results = PaletteOptimiser_OptimisePalettes(optimiser, config->transparentColour));
+    bool solverTimedOut;
+    STAGE(Stage_Solve, results = PaletteSolver_Improve(optimiser, results, config->transparentColour, config->solverTimeMs, &solverTimedOut));
+
+    nPalettes = results.nPalettes;
+    if (nPalettes == 0)
+    {
+        goto exit;
+    }
+
+    STAGE(Stage_Emit, {
+        indexed = Converter_IndexTiles4bpp(img, results, config->transparentColour);
+        assert(indexed);
+        output = Converter_BuildOutput(indexed, config);
+        assert(output);
+
+        FILE *devNull = fopen("/dev/null", "wb");
+        assert(devNull);
+        Output_WriteElf(output, devNull);
+        fclose(devNull);
+    });
+
+#undef STAGE
+
+exit:
+    Image_Free(img);
+    PaletteOptimiser_FreeResults(results);
+    PaletteOptimiser_Free(optimiser);
+    Converter_FreeIndexedTiles(indexed);
+    Output_Free(output);
+
+    return nPalettes;
+}
+
+static void Benchmark_printCase(int size, int tileSize, int nBanks, int nPalettes, int runs, struct StageTimes *times, bool first)
+{
+    printf("%s\n    {\"size\": %d, \"tileSize\": %d, \"colours\": %d, \"palettes\": %d, \"stages\": {",
+           first ? "" : ",", size, tileSize, nBanks * SYNTHETIC_BANK_COLOURS, nPalettes);
+
+    bool firstStage = true;
+    for (int stage = 0; stage < Stage_Count; stage++)
+    {
+        if (!times[stage].ran)
+        {
+            continue;
+        }
+
+        qsort(times[stage].seconds, runs, sizeof(double), Benchmark_compareSeconds);
+        double median = runs % 2 ? times[stage].seconds[runs / 2] : (times[stage].seconds[runs / 2 - 1] + times[stage].seconds[runs / 2]) / 2;
+
+        printf("%s\n        \"%s\": {\"minMs\": %.3f, \"medianMs\": %.3f, \"peakRssKb\": %ld}",
+               firstStage ? "" : ",", stageNames[stage], times[stage].seconds[0] * 1000, median * 1000, times[stage].peakRssKb);
+        firstStage = false;
+    }
+
+    printf("}}");
+    fflush(stdout);
+}
+
+static void printUsage(const char *programName)
+{
+    fprintf(stderr, "Usage:\n%s [--runs N] [--max-size N] [--solver-ms N]\n", programName);
+}
+
+int main(int argc, char **argv)
+{
+    int runs = DEFAULT_RUNS;
+    int maxSize = DEFAULT_MAX_SIZE;
+    int solverMs = DEFAULT_SOLVER_MS;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        int *value = strcmp(argv[arg], "--runs") == 0       ? &runs
+                     : strcmp(argv[arg], "--max-size") == 0 ? &maxSize
+                     : strcmp(argv[arg], "--solver-ms") == 0 ? &solverMs
+                                                             : NULL;
+
+        if (value == NULL || arg + 1 >= argc || (*value = atoi(argv[++arg])) < 0 || runs == 0)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    char fileName[] = "/tmp/pngtogba-benchmark-XXXXXX.png";
+    int fd = mkstemps(fileName, 4);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Failed to create a temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    struct Config config = {
+        .bitsPerPixel = 4,
+        .transparentColour = SYNTHETIC_TRANSPARENT_COLOUR,
+        .compression = CompressionType_LZ77,
+        .solverTimeMs = solverMs,
+        .prefix = (char *)"benchmark"};
+
+    static const int tileSizes[] = {8, 16};
+    static const int bankCounts[] = {1, 4, 16};
+
+    bool resettable = Benchmark_resetPeakRss();
+    printf("{\n  \"runs\": %d,\n  \"solverMs\": %d,\n  \"peakRssPerStage\": %s,\n  \"cases\": [",
+           runs, solverMs, resettable ? "true" : "false");
+
+    struct StageTimes times[Stage_Count];
+    for (int stage = 0; stage < Stage_Count; stage++)
+    {
+        times[stage].seconds = calloc(runs, sizeof(double));
+        assert(times[stage].seconds);
+    }
+
+    int statusCode = 0;
+    bool first = true;
+
+    for (int size = MIN_SIZE; size <= maxSize; size *= 2)
+    {
+        for (size_t t = 0; t < sizeof(tileSizes) / sizeof(tileSizes[0]); t++)
+        {
+            for (size_t b = 0; b < sizeof(bankCounts) / sizeof(bankCounts[0]); b++)
+            {
+                config.tileSize = tileSizes[t];
+                config.dedupe = tileSizes[t] == 8 && (size / 8) * (size / 8) <= MAX_DEDUPE_TILES;
+
+                if (Benchmark_generateSheet(fileName, size, tileSizes[t], bankCounts[b]) != 0)
+                {
+                    fprintf(stderr, "Failed to write %s\n", fileName);
+                    statusCode = 1;
+                    goto exit;
+                }
+
+                for (int stage = 0; stage < Stage_Count; stage++)
+                {
+                    times[stage].peakRssKb = 0;
+                    times[stage].ran = false;
+                }
+
+                int nPalettes = 0;
+                for (int run = 0; run < runs; run++)
+                {
+                    nPalettes = Benchmark_run(fileName, &config, run, times);
+                }
+
+                Benchmark_printCase(size, tileSizes[t], bankCounts[b], nPalettes, runs, times, first);
+                first = false;
+            }
+        }
+    }
+
+exit:
+    printf("\n  ]\n}\n");
+
+    remove(fileName);
+    for (int stage = 0; stage < Stage_Count; stage++)
+    {
+        free(times[stage].seconds);
+    }
+
+    return statusCode;
+}
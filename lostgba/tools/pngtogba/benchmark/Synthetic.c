@@ -0,0 +1,56 @@
+#include "Synthetic.h"
+
+#include <assert.h>
+#include <time.h>
+
+uint32_t Synthetic_Random(void)
+{
+    static uint32_t state = 12023908;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+double Synthetic_Seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+struct SyntheticTile Synthetic_NewTile(int nBanks)
+{
+    struct SyntheticTile tile;
+
+    tile.bank = Synthetic_Random() % nBanks;
+    tile.nColours = 2 + Synthetic_Random() % (SYNTHETIC_BANK_COLOURS - 2);
+    tile.first = Synthetic_Random() % SYNTHETIC_BANK_COLOURS;
+
+    return tile;
+}
+
+uint16_t Synthetic_TileColour(struct SyntheticTile tile, int i)
+{
+    // spread the colours out so that no two are the same after conversion and none is the transparent one
+    int colour = tile.bank * SYNTHETIC_BANK_COLOURS + (tile.first + i) % SYNTHETIC_BANK_COLOURS + 1;
+    return (colour * 97) & 0x7fff;
+}
+
+struct Palette16 *Synthetic_NewTilePalette(int nBanks)
+{
+    struct Palette16 *palette = Palette16_New();
+    assert(palette);
+
+    struct SyntheticTile tile = Synthetic_NewTile(nBanks);
+
+    Palette16_AddColour(palette, SYNTHETIC_TRANSPARENT_COLOUR);
+    for (int i = 0; i < tile.nColours; i++)
+    {
+        Palette16_AddColour(palette, Synthetic_TileColour(tile, i));
+    }
+
+    return palette;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../Palette.h"
+
+#include <stdint.h>
+
+// Synthetic tiles shared by the benchmark and the PaletteOptimiser and PaletteSolver harnesses.
+//
+// Every tile takes a run of colours from one of nBanks hidden banks of SYNTHETIC_BANK_COLOURS colours, so there is
+// always a covering with one palette per bank. With only a few banks the runs overlap enough for the greedy
+// optimiser to find one as well.
+
+#define SYNTHETIC_BANK_COLOURS 15
+// Never one of the bank colours
+#define SYNTHETIC_TRANSPARENT_COLOUR 0x7c1f
+
+// xorshift32 from a fixed seed, so the tiles are the same on every run
+uint32_t Synthetic_Random(void);
+// Seconds from a monotonic clock, for timing stages
+double Synthetic_Seconds(void);
+
+struct SyntheticTile
+{
+    int bank;
+    // between 2 and SYNTHETIC_BANK_COLOURS - 1, since pngtogba rejects tiles with 16 colours
+    int nColours;
+    int first;
+};
+
+// Picks the bank and the run of colours of the next tile
+struct SyntheticTile Synthetic_NewTile(int nBanks);
+// Colour i of the tile's run, for 0 <= i < tile.nColours. Converting it back from RGBA8 with rgb15 gives the same value
+uint16_t Synthetic_TileColour(struct SyntheticTile tile, int i);
+// The next tile's colours as a palette, including SYNTHETIC_TRANSPARENT_COLOUR
+struct Palette16 *Synthetic_NewTilePalette(int nBanks);
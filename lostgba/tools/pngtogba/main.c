@@ -1,255 +1,477 @@
 #include "Image.h"
 #include "PaletteOptimiser.h"
 #include "ConfigReader.h"
+#include "Output.h"
+#include "PaletteSolver.h"
+#include "Cache.h"
+#include "Converter.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 
-static void printPalette(FILE *file, struct Palette16 *palette, uint16_t transparent);
-static int transparentPaletteIndex(struct Palette16 *palette, uint16_t colour, uint16_t transparent);
-static void printResults(FILE *file, struct Image *img, struct PaletteOptimisationResults results, const char *prefix, uint16_t transparent, int tilesX, int tilesY, int tileSize);
-static struct PaletteOptimiser *optimiserForImage(struct Image *img, int tileSize, int tilesX, int tilesY);
+static void printUsage(const char *programName)
+{
+    fprintf(stderr, "Usage:\n%s [--elf] [--cache directory] configFile.h\n", programName);
+    fprintf(stderr, "configFile.h sits next to the image, so image.png.h or sprite.aseprite.h\n");
+    fprintf(stderr, "or is a group.palette.h listing images which should share their palette banks\n");
+}
 
-int main(int argc, char **argv)
+static bool isAseprite(const char *fileName)
 {
-    int statusCode = 0;
-    if (argc != 2)
+    const char *extension = strrchr(fileName, '.');
+    return extension != NULL && (strcmp(extension, ".aseprite") == 0 || strcmp(extension, ".ase") == 0);
+}
+
+// Returns NULL after printing why if the image couldn't be loaded
+static struct Image *loadImage(struct Config *config)
+{
+    // aseprite files use alpha for transparency, which has to become a colour to go through the optimiser
+    if (isAseprite(config->imgFileName) && config->transparentColour == INVALID_COLOUR)
     {
-        fprintf(stderr, "Expected exactly 1 argument, usage:\n%s pngfile configFile.h\n", argv[0]);
-        return 1;
+        fprintf(stderr, "Aseprite images need TRANSPARENT=<colour> in their config\n");
+        return NULL;
     }
 
-    bool ok;
-    struct Config config = ConfigReader_ReadConfig(argv[1], &ok);
-    if (!ok)
+    // SpriteTileStream copies each frame's run of tiles straight out of the TileData into VRAM
+    if (isAseprite(config->imgFileName) && (config->compression != CompressionType_None || config->dedupe))
     {
-        fprintf(stderr, "\nFailed to read config\n");
-        return 1;
+        fprintf(stderr, "Aseprite images can't use COMPRESS or DEDUPE, since their frames are streamed from the tile data\n");
+        return NULL;
     }
 
-    struct PaletteOptimiser *optimiser = NULL;
-
-    struct Image *img = Image_New(config.imgFileName);
+    struct Image *img = isAseprite(config->imgFileName)
+                            ? Image_NewAseprite(config->imgFileName, config->tileSize, config->transparentColour)
+                            : Image_New(config->imgFileName, config->tileSize);
 
     char *error = NULL;
     if (img == NULL || (error = Image_Error(img)) != NULL)
     {
-        fprintf(stderr, "Failed to load image\n");
+        fprintf(stderr, "Failed to load image %s\n", config->imgFileName);
         if (error)
         {
             fprintf(stderr, "Error: %s\n", error);
         }
 
-        return 1;
+        if (img != NULL)
+        {
+            Image_Free(img);
+        }
+
+        return NULL;
     }
 
-    int width = Image_Width(img);
-    int height = Image_Height(img);
+    // Sprites in 1D mapping take their 8x8 tiles row by row across the whole frame, but the tiles of a bigger
+    // TILESIZE are written one after the other, so that only matches when each frame is a single column of them
+    if (Image_Aseprite(img) != NULL && config->tileSize != 8 && Image_Width(img) != config->tileSize)
+    {
+        fprintf(stderr, "Aseprite frames wider than TILESIZE need TILESIZE=8 so their tiles are in sprite order\n");
+        Image_Free(img);
+        return NULL;
+    }
 
-    int tileSize = config.tileSize;
+    return img;
+}
 
-    if (width % tileSize != 0 || height % tileSize != 0)
+static struct Output *buildOutput(struct IndexedTiles *indexed, struct Image *img, struct Config *config)
+{
+    if (Image_Aseprite(img) == NULL)
     {
-        fprintf(stderr, "Image width or height not a multiple of the tile size\n");
-        statusCode = 1;
-        goto exit;
+        return Converter_BuildOutput(indexed, config);
     }
 
-    int tilesX = width / tileSize;
-    int tilesY = height / tileSize;
+    int *frameMap = Converter_DedupeFrames(indexed, img);
+    struct Output *output = Converter_BuildOutput(indexed, config);
+    if (output != NULL)
+    {
+        Converter_AddAnimation(output, img, config, frameMap);
+    }
+    free(frameMap);
 
-    uint16_t transparent = config.transparentColour;
+    return output;
+}
 
-    optimiser = optimiserForImage(img, tileSize, tilesX, tilesY);
-    struct PaletteOptimisationResults results = PaletteOptimiser_OptimisePalettes(optimiser, transparent);
+// Returns non-zero after printing why on failure
+static int writeOutput(struct Output *output, const char *outFileName, bool elfOutput)
+{
+    FILE *outFile = fopen(outFileName, elfOutput ? "wb" : "w");
 
-    if (results.nPalettes == 0)
+    if (outFile == NULL)
     {
-        fprintf(stderr, "Failed to find a set of covering palettes\n");
-        statusCode = 1;
-        goto exit;
+        fprintf(stderr, "Failed to open %s for writing\n", outFileName);
+        return 1;
     }
 
-    FILE *output = fopen(config.outFileName, "w");
+    int err = elfOutput ? Output_WriteElf(output, outFile) : Output_WriteC(output, outFile);
+    fclose(outFile);
 
-    if (output == NULL)
+    if (err)
     {
-        fprintf(stderr, "Failed to open %s for writing\n", config.outFileName);
-        statusCode = 1;
-        goto exit;
+        fprintf(stderr, "Failed to write %s\n", outFileName);
+        remove(outFileName);
+        return 1;
     }
 
-    printResults(output, img, results, config.prefix, transparent, tilesX, tilesY, tileSize);
+    return 0;
+}
 
-    fclose(output);
+// The cache extension of the output for image i of a palette group, the group's own output is just extension
+static char *groupImageCacheExtension(int i, const char *extension)
+{
+    char *imageExtension = malloc(16 + strlen(extension));
+    assert(imageExtension);
 
-exit:
-    Image_Free(img);
-    PaletteOptimiser_Free(optimiser);
-    return statusCode;
+    sprintf(imageExtension, ".%d%s", i, extension);
+    return imageExtension;
 }
 
-static struct PaletteOptimiser *optimiserForImage(struct Image *img, int tileSize, int tilesX, int tilesY)
+// Optimises the tiles of every image in the group together, then writes the shared palette to the group's output
+// and each image's tiles to the image's usual output
+static int convertPaletteGroup(const char *groupFileName, bool elfOutput, struct Cache *cache)
 {
-    struct PaletteOptimiser *optimiser = PaletteOptimiser_New(tilesX * tilesY);
-    assert(optimiser);
+    int statusCode = 0;
+
+    bool ok;
+    struct PaletteGroupConfig group = ConfigReader_ReadPaletteGroupConfig(groupFileName, &ok);
+    if (!ok)
+    {
+        fprintf(stderr, "\nFailed to read palette group config\n");
+        ConfigReader_FreePaletteGroupConfig(group);
+        return 1;
+    }
+
+    const char *extension = elfOutput ? ".o" : ".c";
+    int nImages = group.nImages;
+
+    struct Config *configs = calloc(nImages, sizeof(struct Config));
+    struct Image **imgs = calloc(nImages, sizeof(struct Image *));
+    int *bankOffset = calloc(nImages, sizeof(int));
+    int *bankCount = calloc(nImages, sizeof(int));
+    assert(configs && imgs && bankOffset && bankCount);
+
+    struct PaletteOptimiser *optimiser = NULL;
+    struct PaletteOptimisationResults results = {0};
+    bool solverTimedOut = false;
+    struct IndexedTiles *indexed = NULL;
+    struct Output *output = NULL;
 
-    for (int y = 0; y < tilesY; y++)
+    for (int i = 0; i < nImages; i++)
     {
-        for (int x = 0; x < tilesX; x++)
+        configs[i] = ConfigReader_ReadConfig(group.imageConfigFileNames[i], &ok);
+        if (!ok)
+        {
+            fprintf(stderr, "\nFailed to read config %s\n", group.imageConfigFileNames[i]);
+            statusCode = 1;
+            goto exit;
+        }
+
+        if (configs[i].bitsPerPixel != 4)
         {
-            struct Palette16 *palette = Palette16_New();
-            assert(palette);
+            fprintf(stderr, "%s: only 4bpp images can share palette banks\n", group.imageConfigFileNames[i]);
+            statusCode = 1;
+            goto exit;
+        }
 
-            for (int j = 0; j < tileSize; j++)
+        configs[i].sharedPalette = true;
+        if (configs[i].transparentColour == INVALID_COLOUR)
+        {
+            configs[i].transparentColour = group.transparentColour;
+        }
+
+        if (cache != NULL && (Cache_AddFile(cache, group.imageConfigFileNames[i]) != 0 || Cache_AddFile(cache, configs[i].imgFileName) != 0))
+        {
+            Cache_Free(cache);
+            cache = NULL;
+        }
+    }
+
+    if (cache != NULL)
+    {
+        bool cached = Cache_Fetch(cache, extension, elfOutput ? group.objFileName : group.outFileName);
+        for (int i = 0; i < nImages && cached; i++)
+        {
+            char *imageExtension = groupImageCacheExtension(i, extension);
+            cached = Cache_Fetch(cache, imageExtension, elfOutput ? configs[i].objFileName : configs[i].outFileName);
+            free(imageExtension);
+        }
+
+        if (cached)
+        {
+            goto exit;
+        }
+    }
+
+    for (int i = 0; i < nImages; i++)
+    {
+        imgs[i] = loadImage(&configs[i]);
+        if (imgs[i] == NULL)
+        {
+            statusCode = 1;
+            goto exit;
+        }
+
+        // every bank has the group's transparent colour as colour 0
+        if (Image_ReplaceColour(imgs[i], configs[i].transparentColour, group.transparentColour) != 0)
+        {
+            if (Image_Error(imgs[i]) != NULL)
             {
-                for (int i = 0; i < tileSize; i++)
-                {
-                    struct Colour c = Image_Colour(img, x * tileSize + i, y * tileSize + j);
-                    uint16_t colour = rgb15(c);
-
-                    if (Palette16_AddColour(palette, colour) == PALETTE16_NUM_COLOURS)
-                    {
-                        fprintf(stderr, "Tile %d, %d contains more than %d colours!", x, y, PALETTE16_NUM_COLOURS);
-                        exit(1);
-                    }
-                }
+                fprintf(stderr, "Failed to load image %s\nError: %s\n", configs[i].imgFileName, Image_Error(imgs[i]));
             }
-
-            int err = PaletteOptimiser_AddPalette(optimiser, palette);
-            if (err)
+            else
             {
-                fprintf(stderr, "Image contains more than 256 colours!");
-                exit(1);
+                fprintf(stderr, "%s uses the group's transparent colour without it being transparent\n", configs[i].imgFileName);
             }
+
+            statusCode = 1;
+            goto exit;
         }
+
+        configs[i].transparentColour = group.transparentColour;
     }
 
-    return optimiser;
-}
+    optimiser = Converter_OptimiserForImages(imgs, nImages);
+    if (optimiser == NULL)
+    {
+        statusCode = 1;
+        goto exit;
+    }
 
-static void printResults(FILE *file, struct Image *img, struct PaletteOptimisationResults results, const char *prefix, uint16_t transparent, int tilesX, int tilesY, int tileSize)
-{
-    fprintf(file, "#include <stdint.h>\n\n");
-    fprintf(file, "uint16_t %sPaletteData[256] = {\n", prefix);
+    results = PaletteOptimiser_OptimisePalettes(optimiser, group.transparentColour);
+    results = PaletteSolver_Improve(optimiser, results, group.transparentColour, group.solverTimeMs, &solverTimedOut);
 
-    for (int i = 0; i < results.nPalettes; i++)
+    if (results.nPalettes == 0)
     {
-        struct Palette16 *palette = results.palettes[i];
-        printPalette(file, palette, transparent);
+        fprintf(stderr, "Failed to find a set of covering palettes\n");
+        statusCode = 1;
+        goto exit;
     }
 
-    for (int i = results.nPalettes; i < 16; i++)
+    Converter_GroupPalettesByImage(results, imgs, nImages, bankOffset, bankCount);
+
+    int *paletteAssignment = results.paletteAssignment;
+    for (int i = 0; i < nImages && statusCode == 0; i++)
     {
-        fprintf(file, "    ");
-        for (int j = 0; j < 16; j++)
+        // each image's tiles follow on from the previous image's in the results
+        struct PaletteOptimisationResults imageResults = results;
+        imageResults.paletteAssignment = paletteAssignment;
+        paletteAssignment += (Image_Width(imgs[i]) / configs[i].tileSize) * (Image_Height(imgs[i]) / configs[i].tileSize);
+
+        indexed = Converter_IndexTiles4bpp(imgs[i], imageResults, group.transparentColour);
+        if (indexed == NULL)
         {
-            fprintf(file, "0x0000, ");
+            statusCode = 1;
+            break;
         }
-        fprintf(file, "\n");
-    }
 
-    fprintf(file, "};\n\n");
+        // the palette is the same for every image, so the group's output takes it from the first
+        if (i == 0)
+        {
+            output = Output_New(group.prefix);
+            Output_SetSection(output, group.section);
+            Output_AddArray(output, "PaletteData", OutputType_U16, indexed->paletteData, 256, PALETTE16_NUM_COLOURS);
+            Output_AddValue(output, "PaletteBankCount", OutputType_Int, results.nPalettes);
 
-    fprintf(file, "uint32_t %sTileData[] = {\n", prefix);
-    int tileDataLength = 0;
+            statusCode = writeOutput(output, elfOutput ? group.objFileName : group.outFileName, elfOutput);
+            Output_Free(output);
+        }
 
-    for (int y = 0; y < tilesY; y++)
-    {
-        for (int x = 0; x < tilesX; x++)
+        output = buildOutput(indexed, imgs[i], &configs[i]);
+        if (output == NULL)
         {
-            int paletteIndex = results.paletteAssignment[y * tilesX + x];
-            struct Palette16 *palette = results.palettes[paletteIndex];
+            statusCode = 1;
+        }
 
-            fprintf(file, "    /* %d, %d (palette index %d) */\n", x, y, paletteIndex);
+        if (statusCode == 0)
+        {
+            Output_AddValue(output, "PaletteBankOffset", OutputType_Int, bankOffset[i]);
+            Output_AddValue(output, "PaletteBankCount", OutputType_Int, bankCount[i]);
+            statusCode = writeOutput(output, elfOutput ? configs[i].objFileName : configs[i].outFileName, elfOutput);
+        }
 
-            for (int innerY = 0; innerY < tileSize / 8; innerY++)
-            {
-                fprintf(file, "    ");
+        Output_Free(output);
+        output = NULL;
+        Converter_FreeIndexedTiles(indexed);
+        indexed = NULL;
+    }
 
-                for (int innerX = 0; innerX < tileSize / 8; innerX++)
-                {
-                    for (int j = innerY * 8; j < innerY * 8 + 8; j++)
-                    {
-                        fprintf(file, "0x");
+    // a search which ran out of time might find something else on another run, so only keep finished ones
+    if (statusCode == 0 && cache != NULL && !solverTimedOut)
+    {
+        Cache_Store(cache, extension, elfOutput ? group.objFileName : group.outFileName);
+        for (int i = 0; i < nImages; i++)
+        {
+            char *imageExtension = groupImageCacheExtension(i, extension);
+            Cache_Store(cache, imageExtension, elfOutput ? configs[i].objFileName : configs[i].outFileName);
+            free(imageExtension);
+        }
+    }
 
-                        for (int i = innerX * 8 + 7; i >= innerX * 8; i--)
-                        {
-                            struct Colour c = Image_Colour(img, x * tileSize + i, y * tileSize + j);
-                            uint16_t colour = rgb15(c);
+exit:
+    Cache_Free(cache);
+    for (int i = 0; i < nImages; i++)
+    {
+        if (imgs[i] != NULL)
+        {
+            Image_Free(imgs[i]);
+        }
+    }
 
-                            int colourIndex = transparentPaletteIndex(palette, colour, transparent);
-                            fprintf(file, "%x", colourIndex);
-                        }
+    PaletteOptimiser_FreeResults(results);
+    PaletteOptimiser_Free(optimiser);
+    free(configs);
+    free(imgs);
+    free(bankOffset);
+    free(bankCount);
+    ConfigReader_FreePaletteGroupConfig(group);
+    return statusCode;
+}
 
-                        fprintf(file, ", ");
-                        tileDataLength += 4;
-                    }
-                }
+int main(int argc, char **argv)
+{
+    int statusCode = 0;
+    bool elfOutput = false;
+    const char *cacheDirectory = NULL;
 
-                fprintf(file, "\n");
-            }
+    int arg = 1;
+    for (; arg < argc - 1; arg++)
+    {
+        if (strcmp(argv[arg], "--elf") == 0)
+        {
+            elfOutput = true;
+        }
+        else if (strcmp(argv[arg], "--cache") == 0 && arg + 1 < argc - 1)
+        {
+            cacheDirectory = argv[++arg];
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[arg]);
+            printUsage(argv[0]);
+            return 1;
         }
     }
 
-    fprintf(file, "};\n\n");
-    fprintf(file, "int %sTileDataLength = %d;\n\n", prefix, tileDataLength);
+    if (arg != argc - 1)
+    {
+        fprintf(stderr, "Expected a config file\n");
+        printUsage(argv[0]);
+        return 1;
+    }
 
-    fprintf(file, "int %sTilePaletteNumber[] = {", prefix);
-    for (int i = 0; i < tilesX * tilesY; i++)
+    // The key covers the tool itself, the whole header (so every config option) and the image bytes
+    struct Cache *cache = cacheDirectory ? Cache_New(cacheDirectory) : NULL;
+    if (cache != NULL)
     {
-        if (i % 16 == 0)
+        // fall back to just PNGTOGBA_VERSION if the executable can't be found
+        if (Cache_AddFile(cache, "/proc/self/exe") != 0)
+        {
+            Cache_AddFile(cache, argv[0]);
+        }
+
+        if (Cache_AddFile(cache, argv[argc - 1]) != 0)
         {
-            fprintf(file, "\n   ");
+            Cache_Free(cache);
+            cache = NULL;
         }
+    }
 
-        fprintf(file, "%d, ", results.paletteAssignment[i]);
+    if (ConfigReader_IsPaletteGroup(argv[argc - 1]))
+    {
+        return convertPaletteGroup(argv[argc - 1], elfOutput, cache);
     }
-    fprintf(file, "\n};\n");
-}
 
-static int transparentPaletteIndex(struct Palette16 *palette, uint16_t colour, uint16_t transparent)
-{
-    if (colour == transparent)
+    bool ok;
+    struct Config config = ConfigReader_ReadConfig(argv[argc - 1], &ok);
+    if (!ok)
     {
-        return 0;
+        fprintf(stderr, "\nFailed to read config\n");
+        Cache_Free(cache);
+        return 1;
     }
 
-    int index = Palette16_GetIndex(palette, colour);
-    if (colour < transparent)
+    const char *outFileName = elfOutput ? config.objFileName : config.outFileName;
+    const char *extension = elfOutput ? ".o" : ".c";
+
+    if (cache != NULL && Cache_AddFile(cache, config.imgFileName) != 0)
     {
-        return index + 1;
+        Cache_Free(cache);
+        cache = NULL;
     }
 
-    return index;
-}
+    if (cache != NULL && Cache_Fetch(cache, extension, outFileName))
+    {
+        Cache_Free(cache);
+        return 0;
+    }
 
-static void printPalette(FILE *file, struct Palette16 *palette, uint16_t transparent)
-{
-    fprintf(file, "    ");
+    struct PaletteOptimiser *optimiser = NULL;
+    struct PaletteOptimisationResults results = {0};
+    bool solverTimedOut = false;
+    struct IndexedTiles *indexed = NULL;
+    struct Output *output = NULL;
 
-    if (transparent != INVALID_COLOUR)
+    struct Image *img = loadImage(&config);
+    if (img == NULL)
     {
-        fprintf(file, "0x%04x, ", transparent);
+        Cache_Free(cache);
+        return 1;
     }
 
-    for (int j = 0; j < Palette16_GetNumColours(palette); j++)
+    uint16_t transparent = config.transparentColour;
+
+    if (config.bitsPerPixel == 8)
     {
-        uint16_t colour = Palette16_GetColour(palette, j);
-        if (colour == transparent)
+        indexed = Converter_IndexTiles8bpp(img, transparent);
+    }
+    else
+    {
+        optimiser = Converter_OptimiserForImage(img);
+        if (optimiser == NULL)
+        {
+            statusCode = 1;
+            goto exit;
+        }
+
+        results = PaletteOptimiser_OptimisePalettes(optimiser, transparent);
+        results = PaletteSolver_Improve(optimiser, results, transparent, config.solverTimeMs, &solverTimedOut);
+
+        if (results.nPalettes == 0)
         {
-            continue;
+            fprintf(stderr, "Failed to find a set of covering palettes\n");
+            statusCode = 1;
+            goto exit;
         }
 
-        fprintf(file, "0x%04x, ", colour);
+        indexed = Converter_IndexTiles4bpp(img, results, transparent);
     }
 
-    for (int j = Palette16_GetNumColours(palette); j < PALETTE16_NUM_COLOURS; j++)
+    if (indexed == NULL)
     {
-        fprintf(file, "0x0000, ");
+        statusCode = 1;
+        goto exit;
     }
 
-    fprintf(file, "\n");
-}
\ No newline at end of file
+    output = buildOutput(indexed, img, &config);
+    if (output == NULL)
+    {
+        statusCode = 1;
+        goto exit;
+    }
+
+    statusCode = writeOutput(output, outFileName, elfOutput);
+    if (statusCode == 0 && cache != NULL && !solverTimedOut)
+    {
+        Cache_Store(cache, extension, outFileName);
+    }
+
+exit:
+    Cache_Free(cache);
+    Image_Free(img);
+    PaletteOptimiser_FreeResults(results);
+    PaletteOptimiser_Free(optimiser);
+    Converter_FreeIndexedTiles(indexed);
+    Output_Free(output);
+    return statusCode;
+}
@@ -496,8 +496,8 @@ static int read_idat_bytes(spng_ctx *ctx, uint32_t *bytes_read)
     if (ctx->streaming)
     { /* TODO: calculate bytes to read for progressive reads */
         len = SPNG_READ_SIZE;
-        if (len > ctx->current_chunk.length)
-            len = ctx->current_chunk.length;
+        if (len > ctx->cur_chunk_bytes_left)
+            len = ctx->cur_chunk_bytes_left;
     }
     else
         len = ctx->current_chunk.length;
@@ -1984,11 +1984,13 @@ static int get_ancillary2(spng_ctx *ctx)
     return 0;
 }
 
-int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fmt, int flags)
+/* If row_fn is set then out is unused and each row is passed to row_fn as soon as it is decoded */
+static int decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fmt, int flags,
+                        spng_row_fn *row_fn, void *user)
 {
     if (ctx == NULL)
         return 1;
-    if (out == NULL)
+    if (out == NULL && row_fn == NULL)
         return 1;
 
     int ret;
@@ -1997,7 +1999,7 @@ int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fm
     ret = spng_decoded_image_size(ctx, fmt, &out_size_required);
     if (ret)
         return ret;
-    if (out_size < out_size_required)
+    if (row_fn == NULL && out_size < out_size_required)
         return SPNG_EBUFSIZ;
 
     out_width = out_size_required / ctx->ihdr.height;
@@ -2096,7 +2098,7 @@ int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fm
     unsigned char *scanline = spng__malloc(ctx, scanline_width);
     unsigned char *prev_scanline = spng__malloc(ctx, scanline_width);
 
-    if (interlaced)
+    if (interlaced || row_fn != NULL)
         row = spng__malloc(ctx, out_width);
     else
         row = out;
@@ -2540,6 +2542,12 @@ int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fm
                     memcpy((unsigned char *)out + ioffset, row + k * pixel_size, pixel_size);
                 }
             }
+            else if (row_fn != NULL)
+            {
+                ret = row_fn(ctx, user, row, scanline_idx);
+                if (ret)
+                    goto decode_err;
+            }
             else
             { /* avoid creating an invalid reference */
                 if (scanline_idx != (sub[pass].height - 1))
@@ -2557,7 +2565,7 @@ int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fm
 decode_err:
 
     inflateEnd(&stream);
-    if (interlaced)
+    if (interlaced || row_fn != NULL)
         spng__free(ctx, row);
     spng__free(ctx, scanline);
     spng__free(ctx, prev_scanline);
@@ -2578,6 +2586,45 @@ decode_err:
     return ret;
 }
 
+int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fmt, int flags)
+{
+    return decode_image(ctx, out, out_size, fmt, flags, NULL, NULL);
+}
+
+int spng_decode_rows(spng_ctx *ctx, int fmt, int flags, spng_row_fn *row_fn, void *user)
+{
+    if (ctx == NULL || row_fn == NULL)
+        return 1;
+
+    int ret = get_ancillary(ctx);
+    if (ret)
+        return ret;
+
+    if (!ctx->ihdr.interlace_method)
+        return decode_image(ctx, NULL, 0, fmt, flags, row_fn, user);
+
+    /* rows of an interlaced image aren't complete until the last pass */
+    size_t out_size;
+    ret = spng_decoded_image_size(ctx, fmt, &out_size);
+    if (ret)
+        return ret;
+
+    unsigned char *out = spng__malloc(ctx, out_size);
+    if (out == NULL)
+        return SPNG_EMEM;
+
+    ret = decode_image(ctx, out, out_size, fmt, flags, NULL, NULL);
+
+    size_t out_width = out_size / ctx->ihdr.height;
+    uint32_t i;
+    for (i = 0; !ret && i < ctx->ihdr.height; i++)
+        ret = row_fn(ctx, user, out + i * out_width, i);
+
+    spng__free(ctx, out);
+
+    return ret;
+}
+
 spng_ctx *spng_ctx_new(int flags)
 {
     if (flags)
@@ -315,6 +315,8 @@ struct spng_alloc
 typedef struct spng_ctx spng_ctx;
 
 typedef int spng_read_fn(spng_ctx *ctx, void *user, void *dest, size_t length);
+/* Non-zero return values abort decoding and are returned by spng_decode_rows() */
+typedef int spng_row_fn(spng_ctx *ctx, void *user, const unsigned char *row, uint32_t row_index);
 
 SPNG_API spng_ctx *spng_ctx_new(int flags);
 SPNG_API spng_ctx *spng_ctx_new2(struct spng_alloc *alloc, int flags);
@@ -334,6 +336,9 @@ SPNG_API int spng_set_crc_action(spng_ctx *ctx, int critical, int ancillary);
 SPNG_API int spng_decoded_image_size(spng_ctx *ctx, int fmt, size_t *out);
 
 SPNG_API int spng_decode_image(spng_ctx *ctx, unsigned char *out, size_t out_size, int fmt, int flags);
+/* Like spng_decode_image() but hands each row to row_fn in order instead of storing the whole image.
+   Interlaced images are decoded in full first. */
+SPNG_API int spng_decode_rows(spng_ctx *ctx, int fmt, int flags, spng_row_fn *row_fn, void *user);
 
 SPNG_API int spng_get_ihdr(spng_ctx *ctx, struct spng_ihdr *ihdr);
 SPNG_API int spng_get_plte(spng_ctx *ctx, struct spng_plte *plte);
@@ -0,0 +1,699 @@
+#define _GNU_SOURCE // cause stdio.h to include asprintf
+
+#include "Tmx.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zlib.h>
+
+struct TmxProperty
+{
+    char *name;
+    char *value;
+};
+
+// The custom properties set in Tiled on a tile or layer
+struct TmxProperties
+{
+    int nProperties;
+    struct TmxProperty *properties;
+};
+
+struct TmxLayer
+{
+    char *name;
+    uint32_t *cells;
+    struct TmxProperties properties;
+};
+
+struct Tmx
+{
+    int width;
+    int height;
+    int tileWidth;
+    int tileHeight;
+
+    int firstGid;
+    int tileCount;
+    // the properties of each of the tileCount tiles
+    struct TmxProperties *tiles;
+
+    int nLayers;
+    struct TmxLayer *layers;
+
+    char *error;
+};
+
+// Returns the malloc'd, nul terminated contents of the file or NULL
+static char *Tmx_readFile(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    char *contents = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+
+    while (true)
+    {
+        if (capacity - length < 4096)
+        {
+            capacity = capacity * 2 + 4096;
+            char *newContents = realloc(contents, capacity + 1);
+            if (newContents == NULL)
+            {
+                free(contents);
+                fclose(file);
+                return NULL;
+            }
+
+            contents = newContents;
+        }
+
+        size_t bytesRead = fread(contents + length, 1, capacity - length, file);
+        length += bytesRead;
+
+        if (bytesRead == 0)
+        {
+            break;
+        }
+    }
+
+    bool failed = ferror(file);
+    fclose(file);
+
+    if (failed)
+    {
+        free(contents);
+        return NULL;
+    }
+
+    contents[length] = '\0';
+    return contents;
+}
+
+// The value of the attribute in the tag starting at tag, or NULL if the tag doesn't have it. Returns a malloc'd string
+static char *Tmx_attribute(const char *tag, const char *name)
+{
+    const char *tagEnd = strchr(tag, '>');
+    if (tagEnd == NULL)
+    {
+        return NULL;
+    }
+
+    size_t nameLength = strlen(name);
+
+    for (const char *c = tag + 1; c < tagEnd; c++)
+    {
+        // the name has to be a whole word followed by ="
+        if ((c[-1] == ' ' || c[-1] == '\t' || c[-1] == '\n' || c[-1] == '\r') &&
+            strncmp(c, name, nameLength) == 0 && c[nameLength] == '=' && c[nameLength + 1] == '"')
+        {
+            const char *value = c + nameLength + 2;
+            const char *valueEnd = strchr(value, '"');
+            if (valueEnd == NULL)
+            {
+                return NULL;
+            }
+
+            return strndup(value, valueEnd - value);
+        }
+    }
+
+    return NULL;
+}
+
+// Like Tmx_attribute but for numbers. Returns defaultValue if the attribute is missing
+static long Tmx_intAttribute(const char *tag, const char *name, long defaultValue)
+{
+    char *value = Tmx_attribute(tag, name);
+    if (value == NULL)
+    {
+        return defaultValue;
+    }
+
+    long result = strtol(value, NULL, 10);
+    free(value);
+
+    return result;
+}
+
+// Finds the next <tagName followed by whitespace or >, so that <layer doesn't find <layers
+static const char *Tmx_findTag(const char *start, const char *tagName)
+{
+    size_t tagLength = strlen(tagName);
+
+    for (const char *c = strstr(start, tagName); c != NULL; c = strstr(c + 1, tagName))
+    {
+        char next = c[tagLength];
+        if (next == ' ' || next == '\t' || next == '\n' || next == '\r' || next == '>' || next == '/')
+        {
+            return c;
+        }
+    }
+
+    return NULL;
+}
+
+static int Tmx_base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+    {
+        return c - 'A';
+    }
+
+    if (c >= 'a' && c <= 'z')
+    {
+        return c - 'a' + 26;
+    }
+
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0' + 52;
+    }
+
+    if (c == '+')
+    {
+        return 62;
+    }
+
+    if (c == '/')
+    {
+        return 63;
+    }
+
+    return -1;
+}
+
+// Decodes the base64 between start and end, skipping whitespace. Returns a malloc'd buffer or NULL
+static uint8_t *Tmx_decodeBase64(const char *start, const char *end, size_t *length)
+{
+    uint8_t *bytes = malloc((end - start) / 4 * 3 + 3);
+    if (bytes == NULL)
+    {
+        return NULL;
+    }
+
+    uint32_t bits = 0;
+    int nBits = 0;
+    *length = 0;
+
+    for (const char *c = start; c < end && *c != '='; c++)
+    {
+        int value = Tmx_base64Value(*c);
+        if (value == -1)
+        {
+            continue;
+        }
+
+        bits = (bits << 6) | value;
+        nBits += 6;
+
+        if (nBits >= 8)
+        {
+            nBits -= 8;
+            bytes[(*length)++] = bits >> nBits;
+        }
+    }
+
+    return bytes;
+}
+
+// Inflates zlib or gzip data, which Tiled uses for compression="zlib" and compression="gzip", into exactly length bytes
+static int Tmx_inflate(const uint8_t *compressed, size_t compressedLength, uint8_t *target, size_t length)
+{
+    z_stream stream = {0};
+    stream.next_in = (uint8_t *)compressed;
+    stream.avail_in = compressedLength;
+    stream.next_out = target;
+    stream.avail_out = length;
+
+    // 15 window bits + 32 detects the zlib or gzip header
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+        return 1;
+    }
+
+    int status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+
+    return status != Z_STREAM_END || stream.total_out != length;
+}
+
+// Fills cells from the contents of a <data> element, which starts just after the opening tag and ends at end
+static int Tmx_readLayerData(struct Tmx *tmx, const char *dataTag, const char *end, uint32_t *cells, int nCells)
+{
+    char *encoding = Tmx_attribute(dataTag, "encoding");
+    char *compression = Tmx_attribute(dataTag, "compression");
+    const char *contents = strchr(dataTag, '>') + 1;
+    int status = 0;
+
+    if (encoding == NULL)
+    {
+        // one <tile gid="..."/> per cell
+        int cell = 0;
+        for (const char *tile = Tmx_findTag(contents, "<tile"); tile != NULL && tile < end; tile = Tmx_findTag(tile + 1, "<tile"))
+        {
+            if (cell == nCells)
+            {
+                break;
+            }
+
+            char *gid = Tmx_attribute(tile, "gid");
+            cells[cell++] = gid ? strtoul(gid, NULL, 10) : 0;
+            free(gid);
+        }
+
+        if (cell != nCells)
+        {
+            asprintf(&tmx->error, "Layer has %d tiles rather than %d", cell, nCells);
+            status = 1;
+        }
+    }
+    else if (strcmp(encoding, "csv") == 0)
+    {
+        const char *c = contents;
+        for (int cell = 0; cell < nCells; cell++)
+        {
+            char *numberEnd;
+            cells[cell] = strtoul(c, &numberEnd, 10);
+
+            if (numberEnd == c || numberEnd > end)
+            {
+                asprintf(&tmx->error, "Layer has %d tiles rather than %d", cell, nCells);
+                status = 1;
+                break;
+            }
+
+            c = numberEnd;
+            while (c < end && (*c == ',' || *c == ' ' || *c == '\n' || *c == '\r' || *c == '\t'))
+            {
+                c++;
+            }
+        }
+    }
+    else if (strcmp(encoding, "base64") == 0)
+    {
+        size_t length;
+        uint8_t *bytes = Tmx_decodeBase64(contents, end, &length);
+        uint8_t *raw = bytes;
+        size_t expectedLength = (size_t)nCells * 4;
+
+        if (bytes != NULL && compression != NULL)
+        {
+            raw = malloc(expectedLength);
+            if (raw == NULL || (strcmp(compression, "zlib") != 0 && strcmp(compression, "gzip") != 0) ||
+                Tmx_inflate(bytes, length, raw, expectedLength) != 0)
+            {
+                asprintf(&tmx->error, "Failed to decompress %s layer data", compression);
+                status = 1;
+            }
+
+            length = expectedLength;
+        }
+        else if (bytes != NULL && length != expectedLength)
+        {
+            asprintf(&tmx->error, "Layer has %zu bytes of data rather than %zu", length, expectedLength);
+            status = 1;
+        }
+
+        if (bytes == NULL)
+        {
+            asprintf(&tmx->error, "Out of memory decoding layer data");
+            status = 1;
+        }
+
+        for (int cell = 0; cell < nCells && status == 0; cell++)
+        {
+            cells[cell] = raw[cell * 4] | (raw[cell * 4 + 1] << 8) | (raw[cell * 4 + 2] << 16) | ((uint32_t)raw[cell * 4 + 3] << 24);
+        }
+
+        if (raw != bytes)
+        {
+            free(raw);
+        }
+
+        free(bytes);
+    }
+    else
+    {
+        asprintf(&tmx->error, "Unsupported layer encoding %s", encoding);
+        status = 1;
+    }
+
+    free(encoding);
+    free(compression);
+    return status;
+}
+
+// Reads the <property> tags between start and end
+static int Tmx_readProperties(struct Tmx *tmx, const char *start, const char *end, struct TmxProperties *properties)
+{
+    for (const char *propertyTag = Tmx_findTag(start, "<property"); propertyTag != NULL && propertyTag < end; propertyTag = Tmx_findTag(propertyTag + 1, "<property"))
+    {
+        struct TmxProperty *newProperties = realloc(properties->properties, (properties->nProperties + 1) * sizeof(struct TmxProperty));
+        if (newProperties == NULL)
+        {
+            asprintf(&tmx->error, "Out of memory");
+            return 1;
+        }
+
+        properties->properties = newProperties;
+        struct TmxProperty *property = &properties->properties[properties->nProperties++];
+
+        property->name = Tmx_attribute(propertyTag, "name");
+        // multi-line string properties are written as the element's contents, which nothing here needs
+        property->value = Tmx_attribute(propertyTag, "value");
+    }
+
+    return 0;
+}
+
+static const char *Tmx_findProperty(const struct TmxProperties *properties, const char *name)
+{
+    for (int i = 0; i < properties->nProperties; i++)
+    {
+        if (properties->properties[i].name != NULL && strcmp(properties->properties[i].name, name) == 0)
+        {
+            return properties->properties[i].value;
+        }
+    }
+
+    return NULL;
+}
+
+static void Tmx_freeProperties(struct TmxProperties *properties)
+{
+    for (int i = 0; i < properties->nProperties; i++)
+    {
+        free(properties->properties[i].name);
+        free(properties->properties[i].value);
+    }
+
+    free(properties->properties);
+}
+
+// Reads the properties of each <tile> in the tileset element starting at tilesetTag
+static int Tmx_readTileProperties(struct Tmx *tmx, const char *tilesetTag)
+{
+    tmx->tiles = calloc(tmx->tileCount, sizeof(struct TmxProperties));
+    if (tmx->tiles == NULL)
+    {
+        asprintf(&tmx->error, "Out of memory");
+        return 1;
+    }
+
+    // a tileset with no tiles listed is just <tileset ... />
+    const char *tilesetEnd = strstr(tilesetTag, "</tileset>");
+    if (tilesetEnd == NULL)
+    {
+        return 0;
+    }
+
+    for (const char *tileTag = Tmx_findTag(tilesetTag, "<tile"); tileTag != NULL && tileTag < tilesetEnd; tileTag = Tmx_findTag(tileTag + 1, "<tile"))
+    {
+        int id = Tmx_intAttribute(tileTag, "id", -1);
+        if (id < 0 || id >= tmx->tileCount)
+        {
+            asprintf(&tmx->error, "Tileset has properties for tile %d but only %d tiles", id, tmx->tileCount);
+            return 1;
+        }
+
+        const char *tileEnd = strstr(tileTag, "</tile>");
+        const char *tagEnd = strchr(tileTag, '>');
+        if (tagEnd == NULL || tagEnd[-1] == '/' || tileEnd == NULL)
+        {
+            continue;
+        }
+
+        if (Tmx_readProperties(tmx, tagEnd, tileEnd, &tmx->tiles[id]) != 0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Reads the tile size, count and properties from the tileset, either inline in the map or in the .tsx file it refers to
+static int Tmx_readTileset(struct Tmx *tmx, const char *filename, const char *map)
+{
+    const char *tilesetTag = Tmx_findTag(map, "<tileset");
+    if (tilesetTag == NULL)
+    {
+        asprintf(&tmx->error, "Map has no tileset");
+        return 1;
+    }
+
+    if (Tmx_findTag(tilesetTag + 1, "<tileset") != NULL)
+    {
+        asprintf(&tmx->error, "Maps with more than one tileset aren't supported");
+        return 1;
+    }
+
+    tmx->firstGid = Tmx_intAttribute(tilesetTag, "firstgid", 1);
+
+    char *source = Tmx_attribute(tilesetTag, "source");
+    char *tsx = NULL;
+
+    if (source != NULL)
+    {
+        // the source is relative to the map
+        const char *lastSlash = strrchr(filename, '/');
+        int directoryLength = lastSlash == NULL ? 0 : lastSlash - filename + 1;
+
+        char *tsxFilename;
+        asprintf(&tsxFilename, "%.*s%s", directoryLength, filename, source);
+        tsx = Tmx_readFile(tsxFilename);
+
+        if (tsx == NULL)
+        {
+            asprintf(&tmx->error, "Failed to read tileset %s", tsxFilename);
+        }
+        else if ((tilesetTag = Tmx_findTag(tsx, "<tileset")) == NULL)
+        {
+            asprintf(&tmx->error, "%s contains no tileset", tsxFilename);
+        }
+
+        free(tsxFilename);
+        free(source);
+
+        if (tmx->error != NULL)
+        {
+            free(tsx);
+            return 1;
+        }
+    }
+
+    int tileWidth = Tmx_intAttribute(tilesetTag, "tilewidth", 0);
+    int tileHeight = Tmx_intAttribute(tilesetTag, "tileheight", 0);
+    tmx->tileCount = Tmx_intAttribute(tilesetTag, "tilecount", 0);
+
+    int status = Tmx_readTileProperties(tmx, tilesetTag);
+    free(tsx);
+
+    if (status == 0 && (tileWidth != tmx->tileWidth || tileHeight != tmx->tileHeight))
+    {
+        asprintf(&tmx->error, "Tileset tiles are %dx%d but the map's are %dx%d", tileWidth, tileHeight, tmx->tileWidth, tmx->tileHeight);
+        status = 1;
+    }
+
+    return status;
+}
+
+static int Tmx_readLayers(struct Tmx *tmx, const char *map)
+{
+    for (const char *layerTag = Tmx_findTag(map, "<layer"); layerTag != NULL; layerTag = Tmx_findTag(layerTag + 1, "<layer"))
+    {
+        int width = Tmx_intAttribute(layerTag, "width", 0);
+        int height = Tmx_intAttribute(layerTag, "height", 0);
+        if (width != tmx->width || height != tmx->height)
+        {
+            asprintf(&tmx->error, "Layers must be the same size as the map");
+            return 1;
+        }
+
+        const char *dataTag = Tmx_findTag(layerTag, "<data");
+        const char *dataEnd = dataTag ? strstr(dataTag, "</data>") : NULL;
+        if (dataEnd == NULL)
+        {
+            asprintf(&tmx->error, "Layer has no data. Infinite maps aren't supported");
+            return 1;
+        }
+
+        struct TmxLayer *layers = realloc(tmx->layers, (tmx->nLayers + 1) * sizeof(struct TmxLayer));
+        if (layers == NULL)
+        {
+            asprintf(&tmx->error, "Out of memory");
+            return 1;
+        }
+
+        tmx->layers = layers;
+        struct TmxLayer *layer = &tmx->layers[tmx->nLayers++];
+        layer->properties = (struct TmxProperties){0};
+
+        layer->name = Tmx_attribute(layerTag, "name");
+        if (layer->name == NULL)
+        {
+            layer->name = strdup("");
+        }
+
+        layer->cells = calloc((size_t)width * height, sizeof(uint32_t));
+        if (layer->name == NULL || layer->cells == NULL)
+        {
+            asprintf(&tmx->error, "Out of memory");
+            return 1;
+        }
+
+        if (Tmx_readLayerData(tmx, dataTag, dataEnd, layer->cells, width * height) != 0 ||
+            Tmx_readProperties(tmx, layerTag, dataTag, &layer->properties) != 0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+struct Tmx *Tmx_New(const char *filename)
+{
+    struct Tmx *tmx = calloc(1, sizeof(struct Tmx));
+    if (tmx == NULL)
+    {
+        return NULL;
+    }
+
+    char *map = Tmx_readFile(filename);
+    if (map == NULL)
+    {
+        asprintf(&tmx->error, "Failed to read %s", filename);
+        return tmx;
+    }
+
+    const char *mapTag = Tmx_findTag(map, "<map");
+    if (mapTag == NULL)
+    {
+        asprintf(&tmx->error, "%s isn't a Tiled map", filename);
+        free(map);
+        return tmx;
+    }
+
+    tmx->width = Tmx_intAttribute(mapTag, "width", 0);
+    tmx->height = Tmx_intAttribute(mapTag, "height", 0);
+    tmx->tileWidth = Tmx_intAttribute(mapTag, "tilewidth", 0);
+    tmx->tileHeight = Tmx_intAttribute(mapTag, "tileheight", 0);
+
+    char *orientation = Tmx_attribute(mapTag, "orientation");
+    bool orthogonal = orientation != NULL && strcmp(orientation, "orthogonal") == 0;
+    free(orientation);
+
+    if (!orthogonal)
+    {
+        asprintf(&tmx->error, "Only orthogonal maps are supported");
+    }
+    else if (Tmx_intAttribute(mapTag, "infinite", 0) != 0)
+    {
+        asprintf(&tmx->error, "Infinite maps aren't supported");
+    }
+    else if (tmx->width <= 0 || tmx->height <= 0)
+    {
+        asprintf(&tmx->error, "Map has no size");
+    }
+    else if (Tmx_readTileset(tmx, filename, map) == 0)
+    {
+        Tmx_readLayers(tmx, map);
+    }
+
+    free(map);
+    return tmx;
+}
+
+char *Tmx_Error(struct Tmx *tmx)
+{
+    return tmx->error;
+}
+
+void Tmx_Free(struct Tmx *tmx)
+{
+    if (tmx == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < tmx->nLayers; i++)
+    {
+        free(tmx->layers[i].name);
+        free(tmx->layers[i].cells);
+        Tmx_freeProperties(&tmx->layers[i].properties);
+    }
+
+    for (int i = 0; tmx->tiles != NULL && i < tmx->tileCount; i++)
+    {
+        Tmx_freeProperties(&tmx->tiles[i]);
+    }
+
+    free(tmx->tiles);
+    free(tmx->layers);
+    free(tmx->error);
+    free(tmx);
+}
+
+int Tmx_Width(struct Tmx *tmx)
+{
+    return tmx->width;
+}
+
+int Tmx_Height(struct Tmx *tmx)
+{
+    return tmx->height;
+}
+
+int Tmx_TileWidth(struct Tmx *tmx)
+{
+    return tmx->tileWidth;
+}
+
+int Tmx_TileHeight(struct Tmx *tmx)
+{
+    return tmx->tileHeight;
+}
+
+int Tmx_TilesetFirstGid(struct Tmx *tmx)
+{
+    return tmx->firstGid;
+}
+
+int Tmx_TilesetTileCount(struct Tmx *tmx)
+{
+    return tmx->tileCount;
+}
+
+const char *Tmx_TileProperty(struct Tmx *tmx, int tile, const char *name)
+{
+    return Tmx_findProperty(&tmx->tiles[tile], name);
+}
+
+int Tmx_NumLayers(struct Tmx *tmx)
+{
+    return tmx->nLayers;
+}
+
+const char *Tmx_LayerName(struct Tmx *tmx, int layer)
+{
+    return tmx->layers[layer].name;
+}
+
+const char *Tmx_LayerProperty(struct Tmx *tmx, int layer, const char *name)
+{
+    return Tmx_findProperty(&tmx->layers[layer].properties, name);
+}
+
+const uint32_t *Tmx_LayerCells(struct Tmx *tmx, int layer)
+{
+    return tmx->layers[layer].cells;
+}
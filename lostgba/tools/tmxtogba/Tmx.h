@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+// A Tiled .tmx map and the .tsx tileset it uses, see https://doc.mapeditor.org/en/stable/reference/tmx-map-format/
+struct Tmx;
+
+// The top bits of each cell say how the tile is flipped, the rest is the global tile id
+#define TMX_FLIPPED_HORIZONTALLY 0x80000000u
+#define TMX_FLIPPED_VERTICALLY 0x40000000u
+#define TMX_FLIPPED_DIAGONALLY 0x20000000u
+#define TMX_FLIP_MASK (TMX_FLIPPED_HORIZONTALLY | TMX_FLIPPED_VERTICALLY | TMX_FLIPPED_DIAGONALLY)
+
+// Check Tmx_Error on the result, like Aseprite_New
+struct Tmx *Tmx_New(const char *filename);
+char *Tmx_Error(struct Tmx *tmx);
+void Tmx_Free(struct Tmx *tmx);
+
+// In tiles
+int Tmx_Width(struct Tmx *tmx);
+int Tmx_Height(struct Tmx *tmx);
+// In pixels, the same for the map and its tileset
+int Tmx_TileWidth(struct Tmx *tmx);
+int Tmx_TileHeight(struct Tmx *tmx);
+
+// Only a single tileset is supported. Global tile ids from firstGid onwards are its tiles in order
+int Tmx_TilesetFirstGid(struct Tmx *tmx);
+int Tmx_TilesetTileCount(struct Tmx *tmx);
+// The value of a custom property of a tile in the tileset (not a global id), or NULL if the tile doesn't have it
+const char *Tmx_TileProperty(struct Tmx *tmx, int tile, const char *name);
+
+// Tile layers in the order they appear in the file, which is bottom to top
+int Tmx_NumLayers(struct Tmx *tmx);
+const char *Tmx_LayerName(struct Tmx *tmx, int layer);
+// The value of a custom property of the layer, or NULL if it doesn't have it
+const char *Tmx_LayerProperty(struct Tmx *tmx, int layer, const char *name);
+// Width * height cells row by row, each a global tile id with the TMX_FLIPPED_* bits. 0 means empty
+const uint32_t *Tmx_LayerCells(struct Tmx *tmx, int layer);
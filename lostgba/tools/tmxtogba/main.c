@@ -0,0 +1,543 @@
+#include "Tmx.h"
+
+#include "../pngtogba/ConfigReader.h"
+#include "../pngtogba/Output.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+// A regular background is made of 32x32 tile screenblocks of 1024 screen entries each
+#define SCREENBLOCK_SIZE 32
+#define SCREENBLOCK_LENGTH (SCREENBLOCK_SIZE * SCREENBLOCK_SIZE)
+
+// Screen entry bits, see Converter_BuildOutput in pngtogba
+#define SCREEN_ENTRY_HFLIP (1 << 10)
+#define SCREEN_ENTRY_VFLIP (1 << 11)
+
+// A 1024x1024 map already takes 4MB of ROM between a layer's ScreenEntries and Tiles
+#define MAX_MAP_SIZE 1024
+
+// The Tiles value of an empty cell
+#define EMPTY_TILE 0xffff
+
+// Boolean tile properties set in Tiled and the bit each sets in TileAttributes. These must match enum TileAttribute
+// in lostgba's Collision.h
+static const struct
+{
+    const char *property;
+    uint8_t attribute;
+} tileAttributes[] = {
+    {"solid", 1 << 0},
+    {"water", 1 << 1},
+};
+
+#define TILE_ATTRIBUTE_SOLID (1 << 0)
+
+static void printUsage(const char *programName)
+{
+    fprintf(stderr, "Usage:\n%s [--elf] map.tmx.h\n", programName);
+    fprintf(stderr, "map.tmx.h sits next to the map and names the pngtogba config of its tileset\n");
+}
+
+// The BackgroundSize value from lostgba for a map of this size, or -1 if no regular background is that size
+static int backgroundSize(int width, int height)
+{
+    if (width == 32 && height == 32)
+    {
+        return 0;
+    }
+
+    if (width == 64 && height == 32)
+    {
+        return 1;
+    }
+
+    if (width == 32 && height == 64)
+    {
+        return 2;
+    }
+
+    if (width == 64 && height == 64)
+    {
+        return 3;
+    }
+
+    return -1;
+}
+
+// Where (x, y) goes when the map is cut into 32x32 tile chunks stored one after the other, left to right then top to
+// bottom. For maps which fit in a regular background this is the order of its screenblocks
+static int chunkIndex(int width, int x, int y)
+{
+    int chunk = (y / SCREENBLOCK_SIZE) * (width / SCREENBLOCK_SIZE) + x / SCREENBLOCK_SIZE;
+    return chunk * SCREENBLOCK_LENGTH + (y % SCREENBLOCK_SIZE) * SCREENBLOCK_SIZE + x % SCREENBLOCK_SIZE;
+}
+
+static uint32_t metatileHash(const uint16_t *screenEntries, uint32_t attributes)
+{
+    uint32_t hash = 2166136261u ^ attributes;
+    for (int i = 0; i < 4; i++)
+    {
+        hash = (hash ^ screenEntries[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+// Adds <Layer>Metatiles, <Layer>MetatileAttributes and <Layer>MetatileMap. screenEntries and tiles are row by row.
+// Returns non-zero after printing why on failure
+static int addMetatiles(struct Output *output, const char *layerName, const uint16_t *screenEntries, const uint16_t *tiles,
+                        const uint8_t *attributes, int width, int height)
+{
+    int mapWidth = width / 2;
+    int mapHeight = height / 2;
+    int nCells = mapWidth * mapHeight;
+
+    // 4 screen entries per metatile in the order top left, top right, bottom left, bottom right
+    uint16_t *metatiles = malloc((size_t)nCells * 4 * sizeof(uint16_t));
+    // the attributes of those 4 tiles in the same order, a byte each
+    uint32_t *metatileAttributes = malloc((size_t)nCells * sizeof(uint32_t));
+    uint16_t *map = malloc((size_t)nCells * sizeof(uint16_t));
+    assert(metatiles && metatileAttributes && map);
+
+    // open addressed hash table of metatile indices, -1 for an empty slot
+    int tableSize = 1;
+    while (tableSize < nCells * 2)
+    {
+        tableSize *= 2;
+    }
+
+    int *table = malloc(tableSize * sizeof(int));
+    assert(table);
+    memset(table, -1, tableSize * sizeof(int));
+
+    int nMetatiles = 0;
+    int status = 0;
+
+    for (int i = 0; i < nCells; i++)
+    {
+        int x = (i % mapWidth) * 2;
+        int y = (i / mapWidth) * 2;
+
+        uint16_t metatile[4];
+        uint32_t metatileAttribute = 0;
+
+        for (int j = 0; j < 4; j++)
+        {
+            int cell = (y + j / 2) * width + x + j % 2;
+            metatile[j] = screenEntries[cell];
+
+            if (tiles[cell] != EMPTY_TILE)
+            {
+                metatileAttribute |= (uint32_t)attributes[tiles[cell]] << (j * 8);
+            }
+        }
+
+        int slot = metatileHash(metatile, metatileAttribute) & (tableSize - 1);
+        while (table[slot] != -1 &&
+               (metatileAttributes[table[slot]] != metatileAttribute || memcmp(&metatiles[table[slot] * 4], metatile, sizeof(metatile)) != 0))
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] == -1)
+        {
+            if (nMetatiles == 0x10000)
+            {
+                fprintf(stderr, "Layer %s has more than %d different metatiles\n", layerName, 0x10000);
+                status = 1;
+                break;
+            }
+
+            table[slot] = nMetatiles;
+            memcpy(&metatiles[nMetatiles * 4], metatile, sizeof(metatile));
+            metatileAttributes[nMetatiles] = metatileAttribute;
+            nMetatiles++;
+        }
+
+        map[i] = table[slot];
+    }
+
+    if (status == 0)
+    {
+        char *metatilesName = Output_SymbolName(layerName, "Metatiles");
+        char *attributesName = Output_SymbolName(layerName, "MetatileAttributes");
+        char *mapName = Output_SymbolName(layerName, "MetatileMap");
+
+        Output_AddArray(output, metatilesName, OutputType_U16, metatiles, nMetatiles * 4, 16);
+        Output_AddArray(output, attributesName, OutputType_U32, metatileAttributes, nMetatiles, 8);
+        Output_AddArray(output, mapName, OutputType_U16, map, nCells, mapWidth < 32 ? mapWidth : 32);
+
+        free(metatilesName);
+        free(attributesName);
+        free(mapName);
+    }
+
+    free(metatiles);
+    free(metatileAttributes);
+    free(map);
+    free(table);
+    return status;
+}
+
+// Adds <Layer>ChunkStarts and <Layer>Cells, which only store the cells which aren't empty. For each 32x32 chunk in
+// turn, Cells has its position in the chunk in the top halfword and the screen entry in the bottom one, and
+// ChunkStarts is where each chunk's cells start with one extra at the end
+static void addSparseLayer(struct Output *output, const char *layerName, const uint16_t *screenEntries, const uint16_t *tiles,
+                           int width, int height)
+{
+    int chunksAcross = width / SCREENBLOCK_SIZE;
+    int nChunks = chunksAcross * (height / SCREENBLOCK_SIZE);
+
+    uint32_t *chunkStarts = malloc((nChunks + 1) * sizeof(uint32_t));
+    uint32_t *cells = malloc((size_t)width * height * sizeof(uint32_t));
+    assert(chunkStarts && cells);
+
+    int nCells = 0;
+    for (int chunk = 0; chunk < nChunks; chunk++)
+    {
+        chunkStarts[chunk] = nCells;
+
+        for (int i = 0; i < SCREENBLOCK_LENGTH; i++)
+        {
+            int x = (chunk % chunksAcross) * SCREENBLOCK_SIZE + i % SCREENBLOCK_SIZE;
+            int y = (chunk / chunksAcross) * SCREENBLOCK_SIZE + i / SCREENBLOCK_SIZE;
+
+            if (tiles[y * width + x] != EMPTY_TILE)
+            {
+                cells[nCells++] = ((uint32_t)i << 16) | screenEntries[y * width + x];
+            }
+        }
+    }
+
+    chunkStarts[nChunks] = nCells;
+
+    char *chunkStartsName = Output_SymbolName(layerName, "ChunkStarts");
+    char *cellsName = Output_SymbolName(layerName, "Cells");
+
+    Output_AddArray(output, chunkStartsName, OutputType_U32, chunkStarts, nChunks + 1, 8);
+    Output_AddArray(output, cellsName, OutputType_U32, cells, nCells, 8);
+
+    free(chunkStartsName);
+    free(cellsName);
+    free(chunkStarts);
+    free(cells);
+}
+
+// Adds <Layer>ScreenEntries and <Layer>Tiles for each layer, or the metatile tables if useMetatiles is set. Layers
+// with the sparse property set in Tiled are always stored sparsely. Returns non-zero after printing why on failure
+static int addLayers(struct Output *output, struct Tmx *tmx, const uint16_t *tileRemap, int nTilesetTiles, const uint8_t *attributes,
+                     bool useMetatiles)
+{
+    int width = Tmx_Width(tmx);
+    int height = Tmx_Height(tmx);
+    int firstGid = Tmx_TilesetFirstGid(tmx);
+
+    // row by row, then rearranged into chunks for output
+    uint16_t *screenEntries = malloc((size_t)width * height * sizeof(uint16_t));
+    uint16_t *chunkedScreenEntries = malloc((size_t)width * height * sizeof(uint16_t));
+    uint16_t *tiles = malloc((size_t)width * height * sizeof(uint16_t));
+    assert(screenEntries && chunkedScreenEntries && tiles);
+
+    int status = 0;
+
+    for (int layer = 0; layer < Tmx_NumLayers(tmx) && status == 0; layer++)
+    {
+        const uint32_t *cells = Tmx_LayerCells(tmx, layer);
+        const char *layerName = Tmx_LayerName(tmx, layer);
+
+        for (int y = 0; y < height && status == 0; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                uint32_t cell = cells[y * width + x];
+                uint32_t gid = cell & ~TMX_FLIP_MASK;
+
+                if (gid == 0)
+                {
+                    screenEntries[y * width + x] = 0;
+                    tiles[y * width + x] = EMPTY_TILE;
+                    continue;
+                }
+
+                int tile = (int)gid - firstGid;
+                if (tile < 0 || tile >= nTilesetTiles)
+                {
+                    fprintf(stderr, "Layer %s: tile %d at %d, %d isn't in the tileset\n", layerName, tile, x, y);
+                    status = 1;
+                    break;
+                }
+
+                if (cell & TMX_FLIPPED_DIAGONALLY)
+                {
+                    fprintf(stderr, "Layer %s: the tile at %d, %d is rotated, which the GBA can't do\n", layerName, x, y);
+                    status = 1;
+                    break;
+                }
+
+                // the tileset's own deduplication may have flipped the tile already, and flipping twice cancels out
+                uint16_t screenEntry = tileRemap[tile];
+                if (cell & TMX_FLIPPED_HORIZONTALLY)
+                {
+                    screenEntry ^= SCREEN_ENTRY_HFLIP;
+                }
+
+                if (cell & TMX_FLIPPED_VERTICALLY)
+                {
+                    screenEntry ^= SCREEN_ENTRY_VFLIP;
+                }
+
+                screenEntries[y * width + x] = screenEntry;
+                tiles[y * width + x] = tile;
+            }
+        }
+
+        if (status != 0)
+        {
+            break;
+        }
+
+        const char *sparse = Tmx_LayerProperty(tmx, layer, "sparse");
+        if (sparse != NULL && strcmp(sparse, "true") == 0)
+        {
+            addSparseLayer(output, layerName, screenEntries, tiles, width, height);
+            continue;
+        }
+
+        if (useMetatiles)
+        {
+            status = addMetatiles(output, layerName, screenEntries, tiles, attributes, width, height);
+            continue;
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                chunkedScreenEntries[chunkIndex(width, x, y)] = screenEntries[y * width + x];
+            }
+        }
+
+        char *entriesName = Output_SymbolName(layerName, "ScreenEntries");
+        char *tilesName = Output_SymbolName(layerName, "Tiles");
+
+        Output_AddArray(output, entriesName, OutputType_U16, chunkedScreenEntries, width * height, SCREENBLOCK_SIZE);
+        Output_AddArray(output, tilesName, OutputType_U16, tiles, width * height, width);
+
+        free(entriesName);
+        free(tilesName);
+    }
+
+    free(screenEntries);
+    free(chunkedScreenEntries);
+    free(tiles);
+    return status;
+}
+
+// Adds TileAttributes, a byte per tileset tile, and returns it. The caller frees it
+static uint8_t *addTileAttributes(struct Output *output, struct Tmx *tmx)
+{
+    int nTiles = Tmx_TilesetTileCount(tmx);
+    uint8_t *attributes = calloc(nTiles, 1);
+    assert(attributes);
+
+    for (int tile = 0; tile < nTiles; tile++)
+    {
+        for (size_t i = 0; i < sizeof(tileAttributes) / sizeof(tileAttributes[0]); i++)
+        {
+            const char *value = Tmx_TileProperty(tmx, tile, tileAttributes[i].property);
+            if (value != NULL && strcmp(value, "true") == 0)
+            {
+                attributes[tile] |= tileAttributes[i].attribute;
+            }
+        }
+    }
+
+    Output_AddArray(output, "TileAttributes", OutputType_U8, attributes, nTiles, 16);
+    return attributes;
+}
+
+// Adds Collision, a bit per cell which is set if the cell has a solid tile on any layer. Each row is width / 32 words
+// with the leftmost cell in the lowest bit
+static void addCollision(struct Output *output, struct Tmx *tmx, const uint8_t *attributes)
+{
+    int width = Tmx_Width(tmx);
+    int height = Tmx_Height(tmx);
+    int firstGid = Tmx_TilesetFirstGid(tmx);
+    int wordsPerRow = width / 32;
+
+    uint32_t *collision = calloc((size_t)wordsPerRow * height, sizeof(uint32_t));
+    assert(collision);
+
+    for (int layer = 0; layer < Tmx_NumLayers(tmx); layer++)
+    {
+        const uint32_t *cells = Tmx_LayerCells(tmx, layer);
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                // addLayers has already checked every tile is in the tileset
+                uint32_t gid = cells[y * width + x] & ~TMX_FLIP_MASK;
+                if (gid != 0 && (attributes[gid - firstGid] & TILE_ATTRIBUTE_SOLID))
+                {
+                    collision[y * wordsPerRow + x / 32] |= 1u << (x % 32);
+                }
+            }
+        }
+    }
+
+    Output_AddArray(output, "Collision", OutputType_U32, collision, wordsPerRow * height, wordsPerRow);
+    free(collision);
+}
+
+int main(int argc, char **argv)
+{
+    bool elfOutput = false;
+
+    int arg = 1;
+    for (; arg < argc - 1; arg++)
+    {
+        if (strcmp(argv[arg], "--elf") == 0)
+        {
+            elfOutput = true;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[arg]);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (arg != argc - 1)
+    {
+        fprintf(stderr, "Expected a config file\n");
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    bool ok;
+    struct MapConfig config = ConfigReader_ReadMapConfig(argv[argc - 1], &ok);
+    if (!ok)
+    {
+        fprintf(stderr, "\nFailed to read config\n");
+        return 1;
+    }
+
+    struct Config tilesetConfig = ConfigReader_ReadConfig(config.tilesetConfigFileName, &ok);
+    if (!ok)
+    {
+        fprintf(stderr, "\nFailed to read tileset config %s\n", config.tilesetConfigFileName);
+        return 1;
+    }
+
+    if (tilesetConfig.tileSize != 8)
+    {
+        fprintf(stderr, "The tileset must have TILESIZE=8 to be used for backgrounds\n");
+        return 1;
+    }
+
+    int statusCode = 0;
+    struct Output *output = NULL;
+    struct Tmx *tmx = NULL;
+    uint8_t *attributes = NULL;
+
+    int tileRemapLength;
+    char *tileRemapName = malloc(strlen(tilesetConfig.prefix) + strlen("TileRemap") + 1);
+    assert(tileRemapName);
+    strcpy(tileRemapName, tilesetConfig.prefix);
+    strcat(tileRemapName, "TileRemap");
+
+    uint16_t *tileRemap = (uint16_t *)Output_ReadElfSymbol(tilesetConfig.objFileName, tileRemapName, &tileRemapLength);
+    free(tileRemapName);
+
+    if (tileRemap == NULL)
+    {
+        fprintf(stderr, "Couldn't read %sTileRemap from %s. Is it built, with DEDUPE=1?\n", tilesetConfig.prefix, tilesetConfig.objFileName);
+        statusCode = 1;
+        goto exit;
+    }
+
+    tmx = Tmx_New(config.mapFileName);
+    if (tmx == NULL || Tmx_Error(tmx) != NULL)
+    {
+        fprintf(stderr, "Failed to load map %s\n", config.mapFileName);
+        if (tmx != NULL)
+        {
+            fprintf(stderr, "Error: %s\n", Tmx_Error(tmx));
+        }
+
+        statusCode = 1;
+        goto exit;
+    }
+
+    int width = Tmx_Width(tmx);
+    int height = Tmx_Height(tmx);
+    if (Tmx_TileWidth(tmx) != 8 || Tmx_TileHeight(tmx) != 8 || width % SCREENBLOCK_SIZE != 0 || height % SCREENBLOCK_SIZE != 0 ||
+        width > MAX_MAP_SIZE || height > MAX_MAP_SIZE)
+    {
+        fprintf(stderr, "The map must have 8x8 tiles and be a multiple of 32 tiles up to %d in each direction\n", MAX_MAP_SIZE);
+        statusCode = 1;
+        goto exit;
+    }
+
+    output = Output_New(config.prefix);
+    Output_SetSection(output, config.section);
+
+    Output_AddValue(output, "Width", OutputType_Int, width);
+    Output_AddValue(output, "Height", OutputType_Int, height);
+
+    // bigger maps have to be streamed into a background with lostgba's MapStream
+    int size = backgroundSize(width, height);
+    if (size != -1)
+    {
+        Output_AddValue(output, "BackgroundSize", OutputType_Int, size);
+    }
+
+    int nTilesetTiles = tileRemapLength / sizeof(uint16_t);
+    if (Tmx_TilesetTileCount(tmx) < nTilesetTiles)
+    {
+        nTilesetTiles = Tmx_TilesetTileCount(tmx);
+    }
+
+    attributes = addTileAttributes(output, tmx);
+
+    if (addLayers(output, tmx, tileRemap, nTilesetTiles, attributes, config.metatiles) != 0)
+    {
+        statusCode = 1;
+        goto exit;
+    }
+
+    addCollision(output, tmx, attributes);
+
+    const char *outFileName = elfOutput ? config.objFileName : config.outFileName;
+    FILE *outFile = fopen(outFileName, elfOutput ? "wb" : "w");
+
+    if (outFile == NULL)
+    {
+        fprintf(stderr, "Failed to open %s for writing\n", outFileName);
+        statusCode = 1;
+        goto exit;
+    }
+
+    int err = elfOutput ? Output_WriteElf(output, outFile) : Output_WriteC(output, outFile);
+    fclose(outFile);
+
+    if (err)
+    {
+        fprintf(stderr, "Failed to write %s\n", outFileName);
+        remove(outFileName);
+        statusCode = 1;
+    }
+
+exit:
+    Output_Free(output);
+    Tmx_Free(tmx);
+    free(tileRemap);
+    free(attributes);
+    return statusCode;
+}
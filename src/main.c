@@ -5,16 +5,24 @@
 #include <lostgba/Background.h>
 #include <lostgba/Input.h>
 #include <lostgba/ObjectAttribute.h>
-
+#include <lostgba/SpriteTiles.h>
+#include <lostgba/Collision.h>
+#include <lostgba/MapStream.h>
+#include <lostgba/Metatiles.h>
+#include <lostgba/SparseLayer.h>
+#include <lostgba/Frame.h>
+#include <lostgba/LostGbaUtil.h>
+
+#include "images/shared.palette.h"
 #include "images/tileset.png.h"
-#include "images/character.png.h"
-#include "tilemaps/world.h"
+#include "images/character.aseprite.h"
+#include "tilemaps/world.tmx.h"
 
-bool collisionTile(int tile)
-{
-    return tile == 21 || tile == 22 || // bush
-           tile == 56 || tile == 57;   // tree
-}
+#include <stddef.h>
+
+struct CollisionMap worldCollisionMap;
+struct MetatileMap worldGround;
+struct SparseLayer worldOverlay;
 
 int positiveModulo(int i, int n)
 {
@@ -33,22 +41,18 @@ int divRoundDown(int i, int n)
 
 bool willBeCollision(int targetX, int targetY)
 {
-    int newTileX = divRoundDown(targetX, 8) % 64;
-    int newTileY = divRoundDown(targetY, 8) % 64;
+    int tileX = positiveModulo(divRoundDown(targetX, 8), worldWidth);
+    int tileY = divRoundDown(targetY, 8);
 
-    bool xExactlyOnBoundary = targetX % 8 == 0;
-    bool yExactlyOnBoundary = targetY % 8 == 0;
+    // the bottom half of the character covers 2 or 3 tiles across and 1 or 2 down, depending on how it lines up
+    int width = targetX % 8 == 0 ? 2 : 3;
+    int height = targetY % 8 == 0 ? 1 : 2;
 
-    for (int yOffset = 1; yOffset <= (yExactlyOnBoundary ? 1 : 2); yOffset++)
+    for (int yOffset = 1; yOffset <= height; yOffset++)
     {
-        for (int xOffset = 0; xOffset <= (xExactlyOnBoundary ? 1 : 2); xOffset++)
+        if (CollisionMap_IsAnySolid(&worldCollisionMap, tileX, positiveModulo(tileY + yOffset, worldHeight), width))
         {
-            int tileX = positiveModulo(newTileX + xOffset, 64);
-            int tileY = positiveModulo(newTileY + yOffset, 64);
-            if (collisionTile(worldTilemap[tileY * 64 + tileX]))
-            {
-                return true;
-            }
+            return true;
         }
     }
 
@@ -66,6 +70,18 @@ u32 randomNumber(void)
     return state;
 }
 
+// These run from the VBlank interrupt when the frame is applied, so the new tiles go in with the scroll they match
+static void commitSpriteTiles(void *unused)
+{
+    (void)unused;
+    SpriteTiles_CommitQueued();
+}
+
+static void commitMapStream(void *stream)
+{
+    MapStream_CommitQueued(stream);
+}
+
 int main(void)
 {
     Interrupt_Init();
@@ -80,10 +96,9 @@ int main(void)
 
     Graphics_SetMode(settings);
 
-    TileMap_CopyToBackgroundTiles(0, tilesetTileData, tilesetTileDataLength);
-    TileMap_CopyToBackgroundPalette(tilesetPaletteData);
-    TileMap_CopyToSpritePalette(characterPaletteData);
-    TileMap_CopyToSpriteTiles(0, characterTileData, characterTileDataLength);
+    TileMap_DecompressToBackgroundTiles(0, tilesetTileData);
+    TileMap_CopyToBackgroundPalette(sharedPaletteData);
+    TileMap_CopyToSpritePalette(sharedPaletteData);
 
     Background_SetColourMode(BackgroundNumber_0, BackgroundColourMode_4PP);
     Background_SetSize(BackgroundNumber_0, BackgroundSize_64x64);
@@ -98,33 +113,40 @@ int main(void)
     Background_SetPriority(BackgroundNumber_1, 0);
 
     Graphics_SetBlendingMode(GraphicsBlendingMode_Alpha);
+    Graphics_CommitRegisters();
 
-    for (int y = 0; y < 64; y++)
-    {
-        for (int x = 0; x < 64; x++)
-        {
-            int tile = worldTilemap[x + y * 64];
-            int paletteNumber = tilesetTilePaletteNumber[tile];
-            Background_SetTile(20, BackgroundSize_64x64, x, y, tile, false, false, paletteNumber);
+    worldCollisionMap = (struct CollisionMap){
+        .bitmap = worldCollision,
+        .width = worldWidth,
+        .height = worldHeight};
 
-            switch (tile)
-            {
-            case 5:
-            case 6:
-            case 8:
-            case 9:
-            case 24:
-            case 25:
-            case 40:
-            case 41:
-                Background_SetTile(24, BackgroundSize_64x64, x, y, tile, false, false, paletteNumber);
-                break;
-            default:
-                Background_SetTile(24, BackgroundSize_64x64, x, y, 0, false, false, paletteNumber);
-                break;
-            }
-        }
-    }
+    int x = Graphics_ScreenWidth / 2;
+    int y = Graphics_ScreenHeight / 2;
+
+    worldGround = (struct MetatileMap){
+        .map = worldGroundMetatileMap,
+        .metatiles = worldGroundMetatiles,
+        .attributes = worldGroundMetatileAttributes,
+        .width = worldWidth,
+        .height = worldHeight};
+
+    // BG0 is a window onto the world which is filled in as the camera moves
+    struct MapStream groundStream;
+    MapStream_InitMetatiles(&groundStream, 20, &worldGround);
+    MapStream_SetCamera(&groundStream, x - Graphics_ScreenWidth / 2, y - Graphics_ScreenHeight / 2);
+    MapStream_CommitQueued(&groundStream);
+
+    worldOverlay = (struct SparseLayer){
+        .chunkStarts = worldOverlayChunkStarts,
+        .cells = worldOverlayCells,
+        .width = worldWidth,
+        .height = worldHeight};
+
+    // the tops of the trees and bushes are drawn again over the character from the Overlay layer
+    struct MapStream overlayStream;
+    MapStream_InitSparse(&overlayStream, 24, &worldOverlay);
+    MapStream_SetCamera(&overlayStream, x - Graphics_ScreenWidth / 2, y - Graphics_ScreenHeight / 2);
+    MapStream_CommitQueued(&overlayStream);
 
     for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
     {
@@ -135,7 +157,7 @@ int main(void)
 
     ObjectAttribute_SetGraphicsMode(character, ObjectAttributeGraphicsMode_Normal);
     ObjectAttribute_SetDisplayMode(character, ObjectAttributeDisplayMode_Normal);
-    ObjectAttribute_SetPaletteBank(character, 0);
+    ObjectAttribute_SetPaletteBank(character, characterPaletteBankOffset);
     ObjectAttribute_SetColourMode(character, ObjectAttributeColourMode_4PP);
     ObjectAttribute_SetSize(character, ObjectAttributeSize_16);
     ObjectAttribute_SetShape(character, ObjectAttributeShape_Square);
@@ -143,31 +165,27 @@ int main(void)
 
     ObjectAttribute_SetPos(character, Graphics_ScreenWidth / 2, Graphics_ScreenHeight / 2);
 
-    int x = Graphics_ScreenWidth / 2;
-    int y = Graphics_ScreenHeight / 2;
+    // only the character's current frame is in VRAM, streamed in as it changes
+    struct SpriteTileStream characterTiles;
+    if (!SpriteTileStream_Init(&characterTiles, characterTileData, characterFrameLength))
+    {
+        LostGBA_Panic("Not enough sprite tile memory for the character");
+    }
+    ObjectAttribute_SetTile(character, characterTiles.slot);
 
     int frame = 0;
     int frameSkip = 0;
-#define LOOPS_PER_FRAME 3
 
 #define SPEED 1
 
-#define DOWN_START 3
-#define DOWN_END 10
-#define RIGHT_START 11
-#define RIGHT_END 21
-#define LEFT_START 22
-#define LEFT_END 32
-#define UP_START 34
-#define UP_END 41
-
-#define DOWN_IDLE 1
-#define DOWN_BLINK 2
-#define RIGHT_IDLE 11
-#define LEFT_IDLE 22
-#define UP_IDLE 33
-
-    int currentFrame = DOWN_IDLE;
+    // Down and up have their own idle tags, and left and right idle on the first frame of their walk cycles
+    int downIdle = characterIdleDownStart;
+    int downBlink = characterIdleDownStart + 1;
+    int rightIdle = characterWalkRightStart;
+    int leftIdle = characterWalkLeftStart;
+    int upIdle = characterIdleUpStart;
+
+    int currentFrame = downIdle;
     enum Direction
     {
         Direction_Up,
@@ -187,11 +205,11 @@ int main(void)
         if (Input_IsKeyDown(InputKey_Up))
         {
             ySpeed = -SPEED;
-            if (frame >= UP_END - UP_START)
+            if (frame >= characterWalkUpEnd - characterWalkUpStart)
             {
                 frame = 0;
             }
-            currentFrame = UP_START + frame - 1;
+            currentFrame = characterWalkUpStart + frame;
 
             direction = Direction_Up;
         }
@@ -199,11 +217,11 @@ int main(void)
         if (Input_IsKeyDown(InputKey_Down))
         {
             ySpeed = SPEED;
-            if (frame >= DOWN_END - DOWN_START)
+            if (frame >= characterWalkDownEnd - characterWalkDownStart)
             {
                 frame = 0;
             }
-            currentFrame = DOWN_START + frame - 1;
+            currentFrame = characterWalkDownStart + frame;
 
             direction = Direction_Down;
         }
@@ -211,11 +229,11 @@ int main(void)
         if (Input_IsKeyDown(InputKey_Left))
         {
             xSpeed = -SPEED;
-            if (frame >= LEFT_END - LEFT_START)
+            if (frame >= characterWalkLeftEnd - characterWalkLeftStart)
             {
                 frame = 0;
             }
-            currentFrame = LEFT_START + frame - 1;
+            currentFrame = characterWalkLeftStart + frame;
 
             direction = Direction_Left;
         }
@@ -223,11 +241,11 @@ int main(void)
         if (Input_IsKeyDown(InputKey_Right))
         {
             xSpeed = SPEED;
-            if (frame >= RIGHT_END - RIGHT_START)
+            if (frame >= characterWalkRightEnd - characterWalkRightStart)
             {
                 frame = 0;
             }
-            currentFrame = RIGHT_START + frame - 1;
+            currentFrame = characterWalkRightStart + frame;
 
             direction = Direction_Right;
         }
@@ -247,24 +265,24 @@ int main(void)
             switch (direction)
             {
             case Direction_Up:
-                currentFrame = UP_IDLE - 1;
+                currentFrame = upIdle;
                 break;
             case Direction_Down:
-                if ((currentFrame == DOWN_BLINK - 1 && frameSkip == 0) || currentFrame != DOWN_BLINK - 1)
+                if ((currentFrame == downBlink && frameSkip == 0) || currentFrame != downBlink)
                 {
-                    currentFrame = DOWN_IDLE - 1;
+                    currentFrame = downIdle;
                 }
 
                 if (frameSkip == 0 && randomNumber() % 128 == 0)
                 {
-                    currentFrame = DOWN_BLINK - 1;
+                    currentFrame = downBlink;
                 }
                 break;
             case Direction_Left:
-                currentFrame = LEFT_IDLE - 1;
+                currentFrame = leftIdle;
                 break;
             case Direction_Right:
-                currentFrame = RIGHT_IDLE - 1;
+                currentFrame = rightIdle;
                 break;
             }
         }
@@ -274,19 +292,30 @@ int main(void)
 
         frameSkip++;
 
-        if (frameSkip == LOOPS_PER_FRAME)
+        if (frameSkip >= characterFrameDuration[currentFrame])
         {
             frame++;
             frameSkip = 0;
         }
 
-        ObjectAttribute_SetTile(character, currentFrame * 4);
+        SpriteTileStream_SetFrame(&characterTiles, characterFrameTile[currentFrame]);
+
+        MapStream_SetCamera(&groundStream, x - Graphics_ScreenWidth / 2, y - Graphics_ScreenHeight / 2);
+        MapStream_SetCamera(&overlayStream, x - Graphics_ScreenWidth / 2, y - Graphics_ScreenHeight / 2);
+
+        // most of the map has no overlay, so BG1 only needs to be drawn when some of it is on screen
+        int cameraTileX = (x - Graphics_ScreenWidth / 2) >> 3;
+        int cameraTileY = (y - Graphics_ScreenHeight / 2) >> 3;
+        bool overlayVisible = !SparseLayer_IsAreaEmpty(&worldOverlay, cameraTileX, cameraTileY, MapStream_WindowWidth, MapStream_WindowHeight);
+        Background_SetEnabled(BackgroundNumber_1, overlayVisible);
 
-        Background_SetHorizontalOffset(BackgroundNumber_0, x - Graphics_ScreenWidth / 2);
-        Background_SetVerticalOffset(BackgroundNumber_0, y - Graphics_ScreenHeight / 2);
-        Background_SetHorizontalOffset(BackgroundNumber_1, x - Graphics_ScreenWidth / 2);
-        Background_SetVerticalOffset(BackgroundNumber_1, y - Graphics_ScreenHeight / 2);
+        Frame_SetScroll(BackgroundNumber_0, x - Graphics_ScreenWidth / 2, y - Graphics_ScreenHeight / 2);
+        Frame_SetScroll(BackgroundNumber_1, x - Graphics_ScreenWidth / 2, y - Graphics_ScreenHeight / 2);
+        Frame_QueueObjectAttributes();
+        Frame_QueueCall(commitSpriteTiles, NULL);
+        Frame_QueueCall(commitMapStream, &groundStream);
+        Frame_QueueCall(commitMapStream, &overlayStream);
 
-        ObjectAttributeBuffer_CopyBufferToMemory();
+        Frame_Submit();
     }
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include <stdint.h>
+
+const int worldWidth = 64;
+
+const int worldHeight = 64;
+
+const int worldBackgroundSize = 3;
+
+__attribute__((aligned(4))) const uint8_t worldTileAttributes[256] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+};
+
+__attribute__((aligned(4))) const uint16_t worldGroundMetatiles[296] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1007, 0x0000, 0x0000, 0x0000, 0x0000, 0x100b, 0x0000, 0x0000, 0x0000, 0x1014, 0x140b, 
+    0x0008, 0x0009, 0x0012, 0x0013, 0x0000, 0x0000, 0x0000, 0x100e, 0x0000, 0x0000, 0x100f, 0x0000, 0x0000, 0x0000, 0x0008, 0x0009, 
+    0x0000, 0x100b, 0x0000, 0x0000, 0x1014, 0x0000, 0x0000, 0x0000, 0x0000, 0x100d, 0x0000, 0x0000, 0x0015, 0x0016, 0x0017, 0x0018, 
+    0x1007, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1005, 0x1006, 0x0012, 0x0013, 0x0015, 0x0016, 0x0000, 0x0000, 0x0000, 0x100f, 
+    0x0000, 0x1002, 0x0000, 0x0000, 0x1004, 0x0000, 0x0000, 0x0000, 0x1010, 0x1011, 0x0000, 0x0000, 0x0017, 0x0018, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x100d, 0x0000, 0x0000, 0x100e, 0x0000, 0x0000, 0x0000, 0x1014, 0x0000, 0x100d, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x1001, 0x0000, 0x0000, 0x100f, 0x0000, 0x0000, 0x0000, 0x0000, 0x1003, 0x0000, 0x0000, 0x0000, 0x1004, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x1014, 0x0000, 0x0000, 0x0000, 0x100b, 0x0000, 0x0000, 0x100c, 0x0000, 0x0000, 0x0008, 0x0000, 0x0012, 
+    0x0009, 0x0000, 0x0013, 0x0000, 0x140f, 0x0000, 0x0000, 0x100f, 0x0000, 0x1401, 0x0000, 0x0000, 0x0000, 0x140d, 0x0000, 0x0000, 
+    0x0000, 0x0015, 0x0000, 0x0017, 0x0016, 0x0000, 0x0018, 0x0000, 0x1001, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1404, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x1007, 0x0000, 0x0000, 0x0000, 0x1005, 0x0000, 0x0000, 0x1006, 0x0000, 0x0000, 0x1014, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x1004, 0x100c, 0x0000, 0x0000, 0x0000, 0x0000, 0x140b, 0x0000, 0x0000, 0x0000, 0x1010, 0x0000, 0x0000, 
+    0x1011, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1404, 0x1005, 0x1006, 0x1010, 0x1011, 0x1002, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x1007, 0x0000, 0x0000, 0x0000, 0x1401, 0x0000, 0x0000, 0x0000, 0x0000, 0x1002, 0x0000, 0x0000, 0x0000, 0x1001, 
+    0x0000, 0x0000, 0x100d, 0x0000, 0x0000, 0x100c, 0x0000, 0x0000, 0x0000, 0x1005, 0x0000, 0x1010, 0x1006, 0x0000, 0x1011, 0x0000, 
+    0x100b, 0x0000, 0x0000, 0x0000, 0x100e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1401, 0x0000, 0x0000, 0x0000, 0x1003, 
+    0x0000, 0x0000, 0x0000, 0x0008, 0x0000, 0x0000, 0x0009, 0x0000, 0x0000, 0x0000, 0x140c, 0x0000, 0x1003, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0012, 0x0000, 0x0015, 0x0013, 0x0000, 0x0016, 0x0000, 0x0000, 0x0017, 0x0000, 0x0000, 0x0018, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x1001, 0x0000, 0x0000, 0x0000, 0x0000, 0x1002, 0x0000, 
+};
+
+__attribute__((aligned(4))) const uint32_t worldGroundMetatileAttributes[74] = {
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x00000000, 0x01010000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x00000101, 0x00000101, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x01000000, 0x00010000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100, 
+    0x00000001, 0x00000000, 0x01010000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x01000000, 0x00010000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100, 0x00000001, 
+    0x00000000, 0x00000000, 
+};
+
+__attribute__((aligned(4))) const uint16_t worldGroundMetatileMap[1024] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0002, 0x0000, 0x0003, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0004, 0x0005, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0006, 0x0000, 0x0000, 0x0000, 0x0007, 0x0000, 0x0000, 0x0008, 0x0000, 0x0000, 0x0009, 0x0000, 0x0000, 0x0000, 0x000a, 0x000b, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x000c, 0x0000, 0x0000, 0x0000, 0x0000, 0x000d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000e, 0x0000, 0x000f, 0x0000, 0x0000, 0x0000, 0x0000, 0x000d, 0x0001, 0x0000, 0x0000, 0x0010, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0011, 0x0008, 0x0000, 0x0012, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000f, 0x0000, 0x0013, 0x0000, 0x0000, 0x0000, 0x0014, 0x0000, 0x0000, 0x0012, 0x0015, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0016, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0017, 0x0008, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0018, 0x0000, 0x0019, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0011, 0x001a, 0x001b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001c, 0x001d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001e, 0x0000, 0x001a, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0016, 0x0000, 0x0000, 0x0000, 0x001f, 0x0020, 0x0000, 0x0021, 0x0022, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0023, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0024, 0x0025, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001c, 0x0000, 0x0000, 0x0000, 0x0000, 0x000d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0026, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0007, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0012, 0x0027, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0028, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0029, 0x002a, 0x0000, 0x0000, 0x002b, 0x0000, 0x002c, 0x0000, 0x000e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x002d, 0x0000, 0x0000, 0x0000, 0x0000, 0x002e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x002f, 0x0030, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0013, 0x0000, 0x0000, 0x0000, 0x0031, 0x0000, 0x0000, 0x0000, 0x0000, 0x0028, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0032, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0033, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0034, 0x0000, 0x0000, 0x0000, 0x0035, 0x0000, 0x0000, 0x0036, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x002b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0037, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0038, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x001c, 0x0000, 0x0000, 0x0039, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0005, 0x002b, 0x0000, 0x001e, 0x0000, 0x001e, 0x0000, 0x0000, 0x0009, 0x0000, 0x0000, 0x0000, 0x0000, 0x0032, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0016, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x001f, 0x0020, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x003a, 0x003b, 0x0000, 0x0000, 0x0000, 0x0026, 0x0000, 0x003c, 0x0000, 0x003d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0018, 0x0000, 0x0000, 0x0024, 0x0025, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0034, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x003e, 0x0000, 0x003f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0004, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0040, 0x0041, 0x0000, 0x0042, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0016, 0x0000, 0x0000, 0x000b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0043, 0x000f, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x001c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0044, 0x0045, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x003f, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0046, 0x0047, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001b, 0x0029, 0x002a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0039, 0x0026, 0x0000, 0x0000, 0x0000, 0x0000, 0x000d, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0048, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0049, 0x0000, 0x0000, 0x0000, 0x0000, 0x002f, 0x0030, 0x0000, 0x001a, 0x0000, 0x0000, 0x003f, 0x0000, 0x0037, 0x0006, 0x0000, 0x0000, 0x0012, 0x0000, 0x0048, 0x0000, 
+    0x003f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0040, 0x0041, 0x000a, 0x0000, 0x0000, 0x0043, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0010, 0x0000, 0x003a, 0x003b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0026, 0x0000, 0x0000, 0x0000, 0x0000, 0x001b, 0x0000, 0x0000, 0x0000, 0x0044, 0x0045, 0x003f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0037, 0x0000, 0x0000, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0046, 0x0047, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0004, 0x0000, 
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0033, 0x0000, 0x0004, 0x0000, 0x000a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000b, 0x0000, 
+    0x0040, 0x0041, 0x0017, 0x0000, 0x0015, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0048, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0005, 0x0000, 0x0000, 0x0000, 
+    0x0044, 0x0045, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0014, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0008, 0x000d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+    0x0046, 0x0047, 0x0010, 0x0000, 0x0000, 0x0000, 0x0039, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0012, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
+};
+
+__attribute__((aligned(4))) const uint32_t worldOverlayChunkStarts[5] = {
+    0x00000000, 0x00000010, 0x00000024, 0x00000040, 0x00000058, 
+};
+
+__attribute__((aligned(4))) const uint32_t worldOverlayCells[88] = {
+    0x00f01005, 0x00f11006, 0x01cb0008, 0x01cc0009, 0x01eb0012, 0x01ec0013, 0x020b0015, 0x020c0016, 
+    0x02760008, 0x02770009, 0x02960012, 0x02970013, 0x02a71005, 0x02a81006, 0x02b60015, 0x02b70016, 
+    0x00580008, 0x00590009, 0x00780012, 0x00790013, 0x00980015, 0x00990016, 0x00a20008, 0x00a30009, 
+    0x00c20012, 0x00c30013, 0x00e20015, 0x00e30016, 0x00f01005, 0x00f11006, 0x02261005, 0x02271006, 
+    0x02d81005, 0x02d91006, 0x03dc1005, 0x03dd1006, 0x00490008, 0x004a0009, 0x005b1005, 0x005c1006, 
+    0x00690012, 0x006a0013, 0x00890015, 0x008a0016, 0x012f0008, 0x01300009, 0x014f0012, 0x01500013, 
+    0x016f0015, 0x01700016, 0x028b1005, 0x028c1006, 0x03180008, 0x03190009, 0x03380012, 0x03390013, 
+    0x03580015, 0x03590016, 0x03610008, 0x03620009, 0x03810012, 0x03820013, 0x03a10015, 0x03a20016, 
+    0x00cc0008, 0x00cd0009, 0x00ec0012, 0x00ed0013, 0x010c0015, 0x010d0016, 0x01e11005, 0x01e21006, 
+    0x01f81005, 0x01f91006, 0x02690008, 0x026a0009, 0x02890012, 0x028a0013, 0x02a90015, 0x02aa0016, 
+    0x02dc0008, 0x02dd0009, 0x02fc0012, 0x02fd0013, 0x031c0015, 0x031d0016, 0x03b21005, 0x03b31006, 
+};
+
+__attribute__((aligned(4))) const uint32_t worldCollision[128] = {
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x03000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00030000, 0x0003000c, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00001800, 0x00000000, 
+    0x00000000, 0x000000c0, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00c00180, 0x00000000, 
+    0x00000000, 0x03000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x30000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x18000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000600, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00003000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00018000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x03000006, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00001800, 0x00000000, 
+    0x00000000, 0x00000600, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x30000000, 
+    0x00000000, 0x00000000, 
+    0x03000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000000, 0x00000000, 
+    0x00000006, 0x000c0000, 
+    0x00000000, 0x00000000, 
+};
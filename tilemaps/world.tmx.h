@@ -0,0 +1,26 @@
+/* PREFIX=world */
+/* TILESET=../images/tileset.png.h */
+/* METATILES=1 */
+#pragma once
+
+#include <stdint.h>
+
+// 64x64 tiles, so BackgroundSize is 3 (BackgroundSize_64x64)
+extern const int worldWidth;
+extern const int worldHeight;
+extern const int worldBackgroundSize;
+
+// A byte of TileAttribute bits from lostgba/Collision.h per tileset tile, from the tile properties in tileset.tsx
+extern const uint8_t worldTileAttributes[];
+
+// The ground as 2x2 tile metatiles, see struct MetatileMap
+extern const uint16_t worldGroundMetatiles[];
+extern const uint32_t worldGroundMetatileAttributes[];
+extern const uint16_t worldGroundMetatileMap[];
+
+// The tops of trees and bushes drawn in front of the character, see struct SparseLayer
+extern const uint32_t worldOverlayChunkStarts[];
+extern const uint32_t worldOverlayCells[];
+
+// A bit per cell, set where there is a solid tile. See struct CollisionMap
+extern const uint32_t worldCollision[];